@@ -1,40 +1,53 @@
 #include "pico/stdlib.h"
 #include "inc/JoystickPi.h"
+#include "inc/JoystickPi_calibration.h"
 #include "inc/ButtonPi.h"
 #include "inc/BuzzerPi.h"
-#include "inc/melody.h"
+#include "inc/songs.h"
+#include "inc/board.h"
+#include "inc/genius_config.h"
+#include "inc/xip_profiler.h"
+#include "inc/bus_profiler.h"
+#include "inc/mem_layout.h"
+#include "inc/stack_monitor.h"
+#include "inc/heap_tracker.h"
+#include "inc/boot_profiler.h"
+#include "inc/irq_priority.h"
+#include "inc/irq_latency.h"
+#include "inc/gpio_latency.h"
+#include "inc/bounce_profiler.h"
+#include "inc/tone_selftest.h"
+#include "inc/control_latency.h"
+#include "inc/input_trace.h"
+#include "inc/simon.h"
+#include "inc/rhythm.h"
+#include "inc/looper.h"
+#include "inc/theremin.h"
+#include "inc/tuner.h"
+#include "inc/gpio_irq_manager.h"
+#include "inc/timer_wheel.h"
+#include "inc/scheduler.h"
+#include "hardware/sync.h"
 #include <stdio.h>
 #include <math.h>
 
-// Definições de Hardware
-#define BUTTON_A_PIN 5
-#define BUTTON_B_PIN 6
-#define BUZZER_PIN 21
+// Temporização (pinos em inc/board.h)
 #define UPDATE_MS 100
+#define COMMANDS_MS 10
 
 // Estruturas de Dados
 typedef struct {
     int current_note;
     bool is_playing;
-    absolute_time_t next_note_time;
+    timer_wheel_timer_t note_timer; // Fim do som e fim do silêncio de cada nota
+    volatile bool note_due;         // Próxima nota pode começar
+    volatile bool tone_on;          // Buzzer ligado pela nota atual
+    int note_gap_ms;                // Silêncio após a nota atual
     float freq_mult;
     int current_freq;
 } PlayerState;
 
-typedef struct {
-    int *melody;
-    int *durations;
-    int length;
-    const char *name;
-} Melody;
-
 // Variáveis Globais
-const Melody melodies[] = {
-    {AsaBrancaMelody, AsaBrancaDurations, sizeof(AsaBrancaMelody)/sizeof(int), "Asa Branca"},
-    {ForEliseMelody, ForEliseDurations, sizeof(ForEliseMelody)/sizeof(int), "Für Elise"},
-    {CanoninDMelody, CanoninDurations, sizeof(CanoninDMelody)/sizeof(int), "Canon in D"}
-};
-
 volatile struct {
     int index;
     bool a_pressed;
@@ -43,36 +56,171 @@ volatile struct {
 
 PlayerState player = {0};
 
+// Tarefas do escalonador
+static scheduler_task_t sound_task, input_task, status_task, commands_task, stdio_task;
+
 // Protótipos
 void init_hardware();
+void init_tasks();
 void handle_input();
 void update_sound();
 void show_status();
+void handle_commands();
+void run_tone_selftest();
+void reset_player();
 
 // Callbacks estáticos para os botões
-static void btn_a_callback() { buttons.a_pressed = true; }
-static void btn_b_callback() { buttons.b_pressed = true; }
+// No modo Genius os toques vão para o jogo com o instante da borda
+static void GENIUS_HOT_FUNC(btn_a_callback)() {
+    if(theremin_active()) return; // O buzzer pertence ao teremim
+    if(simon_active()) {
+        simon_press(SIMON_A, gpio_irq_manager_edge_time_us());
+        return;
+    }
+    if(rhythm_active()) {
+        rhythm_press(gpio_irq_manager_edge_time_us());
+        return;
+    }
+    buttons.a_pressed = true;
+    scheduler_signal(&input_task);
+}
+static void GENIUS_HOT_FUNC(btn_b_callback)() {
+    if(theremin_active()) return;
+    if(simon_active()) {
+        simon_press(SIMON_B, gpio_irq_manager_edge_time_us());
+        return;
+    }
+    buttons.b_pressed = true;
+    scheduler_signal(&input_task);
+}
+
+// Callbacks da roda de temporizadores (contexto de IRQ)
+static void GENIUS_HOT_FUNC(note_timer_callback)(timer_wheel_timer_t *timer) {
+    if(player.tone_on) {
+        // Fim do som: desliga o buzzer e aguarda o silêncio entre notas
+        stop_tone(BUZZER_PIN);
+        player.tone_on = false;
+        timer_wheel_start(timer, player.note_gap_ms);
+    } else {
+        player.note_due = true;
+        scheduler_signal(&sound_task);
+    }
+}
+
+// Corpos das tarefas (perfil XIP por seção)
+static void run_input() {
+    XIP_PROFILE_BEGIN(XIP_PROF_INPUT);
+    handle_input();
+    XIP_PROFILE_END(XIP_PROF_INPUT);
+}
+
+static void run_sound() {
+    XIP_PROFILE_BEGIN(XIP_PROF_SOUND);
+    update_sound();
+    XIP_PROFILE_END(XIP_PROF_SOUND);
+}
+
+static void run_status() {
+    XIP_PROFILE_BEGIN(XIP_PROF_STATUS);
+    show_status();
+    XIP_PROFILE_END(XIP_PROF_STATUS);
+}
+
+// USB e mensagem inicial: fora do caminho crítico, depois que o escalonador já despacha notas
+static void run_stdio() {
+    static bool done;
+
+    if(done) {
+        return;
+    }
+    done = true;
 
-int main() {
     stdio_init_all();
-    init_hardware();
+    irq_set_priority(USBCTRL_IRQ, IRQ_PRIORITY_BACKGROUND); // A USB nunca atrasa notas ou botões
+    boot_profiler_mark(BOOT_PHASE_STDIO);
 
     printf("=== Instrumento Musical ===\n");
     printf("Controles:\n");
     printf("A: Proxima musica | B: Play/Pause\n");
+    fflush(stdout);
 
-    while(true) {
-        handle_input();
-        update_sound();
-        show_status();
-        sleep_ms(10);
-    }
+    // Fim da inicialização: a partir daqui nenhum caminho deve alocar memória
+    heap_tracker_lock();
+}
+
+static void run_commands() {
+#if GENIUS_BUS_PROFILE
+    bus_profiler_poll();
+#endif
+#if GENIUS_INPUT_TRACE
+    input_trace_poll();
+#endif
+    handle_commands();
+}
+
+int main() {
+    stack_monitor_init();
+    boot_profiler_mark(BOOT_PHASE_RUNTIME);
+
+    // Hardware de som e entrada primeiro: o instrumento fica tocável antes da enumeração USB
+    init_hardware();
+    init_tasks();
+
+    // A USB vira a primeira ativação da tarefa de menor prioridade
+    scheduler_signal(&stdio_task);
+    boot_profiler_mark(BOOT_PHASE_READY); // Daqui em diante o escalonador despacha notas
+
+    scheduler_run(); // Só executa tarefas prontas; dorme entre elas
     return 0;
 }
 
+// Tarefas: som > entrada > status > comandos e USB (0 = maior prioridade)
+void init_tasks() {
+    scheduler_task_init(&sound_task, "sound", run_sound, 0, 0);          // Fim de nota e play/pause
+    scheduler_task_init(&input_task, "input", run_input, 1, 0);          // Botões
+    scheduler_task_init(&status_task, "status", run_status, 2, UPDATE_MS);
+    scheduler_task_init(&commands_task, "commands", run_commands, 3, COMMANDS_MS);
+    scheduler_task_init(&stdio_task, "stdio", run_stdio, 3, 0);          // Uma vez, na partida
+
+    scheduler_add(&sound_task);
+    scheduler_add(&input_task);
+    scheduler_add(&status_task);
+    scheduler_add(&commands_task);
+    scheduler_add(&stdio_task);
+
+    simon_init(); // Tarefa do modo Genius, na prioridade da entrada
+    rhythm_init(); // Tarefa do acompanhamento, na prioridade do status
+    looper_init(); // Tarefa do looper, na prioridade do som
+    theremin_init(); // Tarefa do teremim, na prioridade do som
+    tuner_init(); // Tarefa do afinador, na prioridade do status
+    joystickPi_calibration_init(); // Calibração gravada e tarefa da calibração, na prioridade dos comandos
+}
+
 void init_hardware() {
+#if GENIUS_XIP_PROFILE
+    xip_profiler_init();
+#endif
+#if GENIUS_BUS_PROFILE
+    bus_profiler_start(BUS_PROF_PRESET_SRAM_STRIPED, BUS_PROF_DEFAULT_WINDOW_MS);
+#endif
+#if GENIUS_BUS_PRIORITY_DMA
+    bus_profiler_set_dma_priority(true);
+#endif
+
+    // Plano de prioridades (ver irq_priority.h); o banco GPIO é configurado pelo gpio_irq_manager
+    irq_set_priority(PWM_IRQ_WRAP, IRQ_PRIORITY_AUDIO);
+    irq_set_priority(DMA_IRQ_0, IRQ_PRIORITY_AUDIO);
+    irq_set_priority(IRQ_TIMER_DEFAULT_POOL, IRQ_PRIORITY_TIMING);
+
+    // Roda de temporizadores antes dos botões: o debounce depende dela
+    timer_wheel_init();
+    timer_wheel_timer_init(&player.note_timer, note_timer_callback, NULL);
+
     joystickPi_init();
+    boot_profiler_mark(BOOT_PHASE_ADC);
+
     initialize_pwm(BUZZER_PIN);
+    boot_profiler_mark(BOOT_PHASE_PWM);
     
     ButtonPi btn_a, btn_b;
     ButtonPi_init(&btn_a, BUTTON_A_PIN);
@@ -80,39 +228,52 @@ void init_hardware() {
     
     ButtonPi_attach_callback(&btn_a, btn_a_callback);
     ButtonPi_attach_callback(&btn_b, btn_b_callback);
+    boot_profiler_mark(BOOT_PHASE_GPIO_IRQ);
 }
 
-void handle_input() {
+void GENIUS_HOT_FUNC(handle_input)() {
     // Botão A: Troca de música
     if(buttons.a_pressed) {
-        buttons.index = (buttons.index + 1) % (sizeof(melodies)/sizeof(Melody));
+        buttons.index = (buttons.index + 1) % SONG_COUNT;
         printf("\nMusica selecionada: %s\n", melodies[buttons.index].name);
         buttons.a_pressed = false;
         player.is_playing = false;
+        scheduler_signal(&sound_task); // Para a música atual
     }
     
     // Botão B: Play/Pause
     if(buttons.b_pressed) {
         player.is_playing = !player.is_playing;
         player.current_note = 0;
+        player.note_due = player.is_playing; // Primeira nota imediatamente
         buttons.b_pressed = false;
+        scheduler_signal(&sound_task);
     }
 }
 
-void update_sound() {
+void GENIUS_HOT_FUNC(update_sound)() {
     if(!player.is_playing) {
-        pwm_set_gpio_level(BUZZER_PIN, 0);
+        timer_wheel_cancel(&player.note_timer);
+        stop_tone(BUZZER_PIN);
+        if(player.tone_on) looper_note_off(); // A nota cortada libera a voz para o loop
+        player.tone_on = false;
+        if(rhythm_active()) rhythm_song_end(); // Pausa encerra a rodada
         return;
     }
 
     // Atualiza frequência pelo joystick
     joystick_state_t js = joystickPi_read();
+    CONTROL_LATENCY_ADC(js.x);
     player.freq_mult = 0.5f + (js.x / 4095.0f);
+    CONTROL_LATENCY_FILTER();
+
+    // Toca próxima nota: som por `duration` e silêncio por mais `duration`, sem bloquear
+    if(player.note_due) {
+        player.note_due = false;
 
-    // Toca próxima nota
-    if(time_reached(player.next_note_time)) {
         if(player.current_note >= melodies[buttons.index].length) {
             player.is_playing = false;
+            if(rhythm_active()) rhythm_song_end();
             return;
         }
 
@@ -121,24 +282,252 @@ void update_sound() {
 
         if(original > 0) {
             player.current_freq = original * player.freq_mult;
-            play_tone(BUZZER_PIN, player.current_freq, duration);
+            CONTROL_LATENCY_APPLY();
+            player.note_gap_ms = duration;
+            player.tone_on = true;
+            uint32_t irq_state = save_and_disable_interrupts(); // Voz do buzzer passa ao vivo de uma vez
+            uint32_t onset_us = start_tone_timed(BUZZER_PIN, player.current_freq);
+            looper_note(onset_us, player.current_freq, duration);
+            restore_interrupts(irq_state);
+            CONTROL_LATENCY_COMMIT();
+            if(rhythm_active()) rhythm_onset(onset_us);
+            timer_wheel_start(&player.note_timer, duration);
         } else {
             player.current_freq = 0;
-            sleep_ms(duration);
+            timer_wheel_start(&player.note_timer, 2 * duration);
         }
 
         player.current_note++;
-        player.next_note_time = make_timeout_time_ms(duration);
     }
 }
 
 void show_status() {
-    static absolute_time_t last = 0;
-    if(time_reached(last)) {
-        joystick_state_t js = joystickPi_read();
-        printf("\rX: %-4d | Y: %-4d | Freq: %-4d Hz   ", 
-              js.x, js.y, player.current_freq);
+    joystick_state_t js = joystickPi_read();
+    CONTROL_LATENCY_SEEN(js.x);
+    if(tuner_active()) {
+        pitch_result_t r = tuner_result();
+        if(r.voiced) {
+            int cents;
+            int midi = pitch_nearest_note(r.freq_q4, &cents);
+            printf("\rAfinador: %-2s%d %+3d cents | %4lu.%02lu Hz   ", pitch_note_name(midi), midi / 12 - 1, cents,
+                   (unsigned long)(r.freq_q4 >> 4), (unsigned long)((r.freq_q4 & 0xf) * 100 / 16));
+        } else {
+            printf("\rAfinador: --                          ");
+        }
         fflush(stdout);
-        last = make_timeout_time_ms(UPDATE_MS);
+        return;
     }
-}
\ No newline at end of file
+    printf("\rX: %-4d | Y: %-4d | Freq: %-4d Hz   ", 
+          js.x, js.y, theremin_active() ? (int)theremin_freq_hz() : player.current_freq);
+#if GENIUS_BUS_PROFILE
+    // Contenção da última janela do BUSCTRL (relatório completo pelo comando 'b')
+    printf("| Bus %-7s %6lu disp/ms   ", bus_profiler_preset_name(bus_profiler_result()->preset),
+           (unsigned long)bus_profiler_contested_per_ms());
+#endif
+    fflush(stdout);
+}
+
+// Comandos recebidos pela serial USB (um caractere por comando)
+void handle_commands() {
+    int c = getchar_timeout_us(0);
+    if(c == PICO_ERROR_TIMEOUT) {
+        return;
+    }
+
+    switch(c) {
+#if GENIUS_XIP_PROFILE
+        case 'p': // Relatório do cache XIP
+            xip_profiler_report();
+            break;
+        case 'f': // Esvazia o cache XIP para medir o pior caso
+            xip_profiler_flush_cache();
+            break;
+#endif
+#if GENIUS_CONTROL_LATENCY
+        case 'j': // Latência joystick -> altura da nota
+            control_latency_report();
+            break;
+#endif
+#if GENIUS_INPUT_TRACE
+        case 'r': // Inicia ou encerra a gravação das entradas
+            if(input_trace_mode() == INPUT_TRACE_RECORDING) {
+                input_trace_record_stop();
+            } else if(input_trace_mode() == INPUT_TRACE_IDLE) {
+                reset_player();
+                input_trace_record_start();
+            }
+            break;
+        case 'o': // Registro de entradas como roteiro do GENIUS_sim
+            input_trace_dump();
+            break;
+        case 'x': // Reproduz o registro no tempo original (ou interrompe)
+        case 'X': // Reproduz acelerado, como gerador de carga
+            if(input_trace_mode() == INPUT_TRACE_REPLAYING) {
+                input_trace_replay_stop();
+            } else {
+                reset_player();
+                input_trace_replay_start(c == 'X' ? INPUT_TRACE_BENCH_SPEED : 1);
+            }
+            break;
+#endif
+#if GENIUS_BUS_PROFILE
+        case 'b': // Contenção no barramento (última janela)
+            bus_profiler_report();
+            break;
+        case 'n': // Próximo conjunto de eventos do BUSCTRL
+            bus_profiler_next_preset();
+            break;
+        case 'm': // Benchmark de contenção nos bancos de SRAM
+            mem_layout_benchmark();
+            break;
+#endif
+        case 'l': // Mapa de memória
+            mem_layout_report();
+            break;
+        case 'k': // Marca d'água das pilhas
+            stack_monitor_report();
+            break;
+        case 'h': // Alocações dinâmicas por subsistema
+            heap_tracker_report();
+            break;
+        case 'i': // Linha do tempo da inicialização
+            boot_profiler_report();
+            break;
+        case 'q': // Latência de entrada das IRQs sob carga
+            irq_latency_benchmark();
+            break;
+        case 'g': // Latência borda-callback GPIO por caminho de despacho
+            tuner_stop(); // Libera o ADC (carga do benchmark)
+            gpio_latency_benchmark();
+            break;
+        case 'd': // Repique dos botões e debounce sugerido
+            bounce_profiler_run(false);
+            break;
+        case 'D': // Idem, aplicando o debounce sugerido
+            bounce_profiler_run(true);
+            break;
+        case 'c': // Ruído do ADC e calibração do joystick
+            tuner_stop(); // Libera o ADC
+            joystickPi_calibrate();
+            break;
+        case 'v': // Frequência real de cada nota (fio do buzzer ao contador)
+            run_tone_selftest();
+            break;
+        case 'w': // Roda de temporizadores
+            timer_wheel_report();
+            break;
+        case 't': // Tarefas: execuções, tempos e WCRT
+            scheduler_report();
+            break;
+        case 's': // Entra ou sai do modo Genius
+            if(simon_active()) {
+                simon_stop();
+            } else if(!rhythm_active()) {
+                theremin_stop();
+                looper_stop();
+                reset_player();
+                simon_start();
+            }
+            break;
+        case 'a': // Acompanhamento da música selecionada (toques em A)
+            if(!simon_active() && !rhythm_active()) {
+                theremin_stop();
+                looper_stop();
+                player.is_playing = false;
+                update_sound(); // Libera o buzzer
+                rhythm_start();
+                player.is_playing = true;
+                player.current_note = 0;
+                player.note_due = true;
+                scheduler_signal(&sound_task);
+            }
+            break;
+        case 'A': // Calibração das latências de entrada e saída do acompanhamento
+            if(!simon_active() && !rhythm_active()) {
+                theremin_stop();
+                looper_stop(); // Os temporizadores do looper silenciam o buzzer pela ISR
+                player.is_playing = false;
+                update_sound(); // Libera o buzzer
+                rhythm_calibrate();
+            }
+            break;
+        case 'e': // Looper: gravar -> tocar -> sobrepor -> tocar
+            if(!simon_active() && !rhythm_active() && !theremin_active()) {
+                looper_advance();
+            }
+            break;
+        case 'u': // Looper: descarta a camada mais recente
+            looper_undo();
+            break;
+        case 'z': // Looper: para (se já parado, apaga)
+            if(looper_state() == LOOPER_STOPPED) {
+                looper_clear();
+            } else {
+                looper_stop();
+            }
+            break;
+        case 'E': // Looper: exporta no formato das músicas
+            looper_print_export();
+            break;
+        case 'T': // Entra ou sai do modo teremim (sair imprime a latência)
+            if(theremin_active()) {
+                theremin_stop();
+            } else if(!simon_active() && !rhythm_active()) {
+                looper_stop();
+                reset_player();
+                theremin_start();
+            }
+            break;
+        case 'M': // Liga ou desliga o afinador (desligar imprime os ciclos por bloco)
+            if(tuner_active()) {
+                tuner_stop();
+            } else {
+                tuner_start();
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+// Estado inicial do instrumento (primeira música, parado): ponto de partida da gravação e da reprodução
+void reset_player() {
+    buttons.index = 0;
+    buttons.a_pressed = false;
+    buttons.b_pressed = false;
+    player.is_playing = false;
+    update_sound(); // Libera o buzzer
+}
+
+// Autoteste de frequência com as notas distintas de todas as músicas, em ordem crescente
+void run_tone_selftest() {
+    static uint32_t notes[TONE_SELFTEST_MAX_NOTES];
+    uint count = 0;
+
+    theremin_stop();
+    simon_stop(); // Os temporizadores do jogo também tocam e silenciam o buzzer pela ISR
+    looper_stop(); // Os temporizadores do looper silenciam o buzzer pela ISR
+    player.is_playing = false;
+    update_sound(); // Libera o buzzer
+
+    for(uint m = 0; m < SONG_COUNT; m++) {
+        for(int n = 0; n < melodies[m].length; n++) {
+            uint32_t freq = melodies[m].melody[n];
+            uint pos = 0;
+
+            while(pos < count && notes[pos] < freq) {
+                pos++;
+            }
+            if(freq == 0 || (pos < count && notes[pos] == freq) || count == TONE_SELFTEST_MAX_NOTES) {
+                continue;
+            }
+            for(uint i = count; i > pos; i--) {
+                notes[i] = notes[i - 1];
+            }
+            notes[pos] = freq;
+            count++;
+        }
+    }
+
+    tone_selftest_run(notes, count);
+}
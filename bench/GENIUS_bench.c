@@ -0,0 +1,357 @@
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/systick.h"
+#include "hardware/sync.h"
+#include "inc/genius_config.h"
+#include "inc/board.h"
+#include "inc/BuzzerPi.h"
+#include "inc/JoystickPi.h"
+#include "inc/gpio_irq_manager.h"
+#include "inc/heap_tracker.h"
+#include "inc/pitch_detect.h"
+#include "inc/timer_wheel.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file GENIUS_bench.c
+ * @brief Microbenchmarks dos caminhos críticos do GENIUS no hardware real
+ *
+ * Firmware separado (alvo `GENIUS_bench`) que mede, em ciclos do processador, o custo das funções
+ * usadas pelo instrumento, compiladas com as mesmas opções do `GENIUS` (`genius_config.h`):
+ * 1. `calculate_wrap`.
+ * 2. Preparação de um tom (`start_tone` + `stop_tone`, o trabalho de `play_tone` fora do sleep).
+ * 3. `joystickPi_read` (duas conversões do ADC e a leitura do botão).
+ * 4. `joystickPi_map_value`.
+ * 5. Despacho do `gpio_irq_handler`: pino sem callback, borda descartada pelo debounce e borda
+ *    aceita (callback e rearme do debounce).
+ * 6. Formatação da linha de `show_status()` (sem o envio pela USB).
+ * 7. `pitch_detect` sobre um quadro sintético (triângulo de 440 Hz): o custo de um bloco do
+ *    afinador, a comparar com o orçamento de `TUNER_HOP` amostras (`tuner.h`).
+ *
+ * Com `GENIUS_HEAP_TRACK` habilitado, uma linha extra confere no hardware o endereço de chamada
+ * registrado pelo rastreador de alocações (lido da pilha, ver `heap_tracker.c`): `malloc`,
+ * `calloc` e `realloc` chamados de funções conhecidas precisam ser atribuídos a elas.
+ *
+ * Cada amostra é uma chamada isolada, com as interrupções desabilitadas, cronometrada pelo
+ * SysTick (contador de 24 bits no clock do processador). O custo da própria medição é calibrado
+ * com uma função vazia chamada da mesma forma e descontado de todas as amostras.
+ *
+ * Os resultados são enviados pela USB como uma linha JSON por benchmark, para comparar versões do
+ * firmware diretamente (`versao` e `rev` identificam o build). O conjunto é repetido a cada
+ * caractere recebido pela serial.
+ *
+ * O buzzer não toca: o pino não é ligado ao PWM, apenas os registradores do slice são escritos.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define SYSTICK_MAX 0xFFFFFFu
+
+/**
+ * @brief Amostras por benchmark (a primeira chamada, com o cache XIP frio, é descartada).
+ */
+#define BENCH_SAMPLES 1000
+
+/**
+ * @brief Tempo máximo de espera pela conexão USB antes de começar.
+ */
+#define BENCH_USB_WAIT_MS 5000
+
+/**
+ * @brief Tamanho máximo das funções que alocam na conferência do rastreador.
+ */
+#define SITE_BYTES 32
+
+#ifndef PICO_PROGRAM_VERSION_STRING
+#define PICO_PROGRAM_VERSION_STRING "?"
+#endif
+
+#ifndef GENIUS_GIT_REV
+#define GENIUS_GIT_REV "?"
+#endif
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Um benchmark: função medida e ganchos opcionais executados antes de cada amostra, fora
+ * da medição.
+ */
+typedef struct {
+    const char *name;
+    void (*run)(void);
+    void (*wait)(void);     // Com interrupções habilitadas (ex.: esperar um temporizador)
+    void (*prepare)(void);  // Com interrupções desabilitadas, imediatamente antes da medição
+} bench_t;
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static uint32_t samples[BENCH_SAMPLES];
+static uint32_t overhead; // Custo da medição (ciclos), descontado das amostras
+
+// Entradas voláteis: impedem que o compilador calcule os resultados em tempo de compilação
+static volatile uint32_t input_freq = 440;
+static volatile uint16_t input_adc = 3000;
+static volatile uint16_t sink_u16;
+static volatile int sink_int;
+static char status_line[64];
+static uint16_t pitch_frame[PITCH_FRAME];
+static pitch_result_t pitch_sink;
+#if GENIUS_HEAP_TRACK
+static void *volatile site_ptr;
+#endif
+
+/******************************
+ * Corpos dos Benchmarks
+ ******************************/
+
+static void __noinline bench_empty() {
+    __compiler_memory_barrier();
+}
+
+static void bench_calculate_wrap() {
+    sink_u16 = calculate_wrap(input_freq, CLK_DIV_DEFAULT);
+}
+
+static void bench_tone_setup() {
+    start_tone(BUZZER_PIN, input_freq);
+    stop_tone(BUZZER_PIN);
+}
+
+static void bench_joystick_read() {
+    joystick_state_t js = joystickPi_read();
+    sink_u16 = js.x;
+}
+
+static void bench_map_value() {
+    sink_int = joystickPi_map_value(input_adc, 0, 4095, -100, 100);
+}
+
+static void bench_callback() {
+}
+
+static void bench_irq_no_callback() {
+    gpio_irq_handler(BUTTON_A_PIN, GPIO_IRQ_EDGE_FALL); // Pino sem callback no benchmark
+}
+
+static void bench_irq_dispatch() {
+    gpio_irq_handler(IRQ_BENCH_LOAD_PIN, GPIO_IRQ_EDGE_FALL); // Aceita ou descarta conforme o debounce
+}
+
+static void prepare_debounced() {
+    gpio_irq_handler(IRQ_BENCH_LOAD_PIN, GPIO_IRQ_EDGE_FALL); // Arma o bloqueio
+}
+
+static void wait_accepted() {
+    sleep_ms(DEBOUNCE_DELAY_MS + 1); // Espera o fim do bloqueio da amostra anterior
+}
+
+static void bench_status_format() {
+    // Mesmo formato de show_status() em GENIUS.c
+    sink_int = snprintf(status_line, sizeof(status_line), "\rX: %-4d | Y: %-4d | Freq: %-4d Hz   ",
+                        input_adc, input_adc, (int)input_freq);
+}
+
+static void bench_pitch_detect() {
+    pitch_detect(pitch_frame, &pitch_sink);
+}
+
+static const bench_t benches[] = {
+    {"calculate_wrap", bench_calculate_wrap, NULL, NULL},
+    {"tone_setup", bench_tone_setup, NULL, NULL},
+    {"joystickPi_read", bench_joystick_read, NULL, NULL},
+    {"joystickPi_map_value", bench_map_value, NULL, NULL},
+    {"gpio_irq_sem_callback", bench_irq_no_callback, NULL, NULL},
+    {"gpio_irq_debounce", bench_irq_dispatch, NULL, prepare_debounced},
+    {"gpio_irq_aceito", bench_irq_dispatch, wait_accepted, NULL},
+    {"show_status_formato", bench_status_format, NULL, NULL},
+    {"pitch_detect_bloco", bench_pitch_detect, NULL, NULL},
+};
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Preenche o quadro de `bench_pitch_detect`: triângulo de 440 Hz com 1000 LSB de pico.
+ */
+static void fill_pitch_frame() {
+    uint32_t phase = 0; // Q16 de período
+    const uint32_t step = (uint32_t)((440ull << 16) / PITCH_SAMPLE_RATE_HZ);
+
+    for (uint i = 0; i < PITCH_FRAME; i++) {
+        int32_t p = (int32_t)(phase >> 4); // 0 a 4095
+        int32_t tri = p < 2048 ? p - 1024 : 3071 - p;
+        pitch_frame[i] = (uint16_t)(2048 + tri * 1000 / 1024);
+        phase = (phase + step) & 0xffffu;
+    }
+}
+
+/**
+ * @brief Mede uma chamada de `run`, em ciclos, sem descontar o custo da medição.
+ */
+static uint32_t __not_in_flash_func(sample)(const bench_t *bench) {
+    if (bench->wait) {
+        bench->wait();
+    }
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    if (bench->prepare) {
+        bench->prepare();
+    }
+    uint32_t start = systick_hw->cvr;
+    bench->run();
+    uint32_t end = systick_hw->cvr;
+    restore_interrupts(irq_state);
+
+    return (start - end) & SYSTICK_MAX; // Contador decrescente
+}
+
+/**
+ * @brief Coleta `BENCH_SAMPLES` amostras de um benchmark em `samples`, já ordenadas.
+ */
+static void collect(const bench_t *bench) {
+    sample(bench); // Aquece o cache XIP
+
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        samples[i] = sample(bench);
+    }
+    qsort(samples, BENCH_SAMPLES, sizeof(samples[0]), compare_u32);
+}
+
+/**
+ * @brief Calibra o custo da medição com a função vazia (mínimo das amostras).
+ */
+static void calibrate() {
+    static const bench_t empty = {"vazio", bench_empty, NULL, NULL};
+
+    collect(&empty);
+    overhead = samples[0];
+}
+
+/**
+ * @brief Executa um benchmark e imprime sua linha JSON.
+ */
+static void run_bench(const bench_t *bench) {
+    uint64_t sum = 0;
+
+    collect(bench);
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        samples[i] = samples[i] > overhead ? samples[i] - overhead : 0;
+        sum += samples[i];
+    }
+
+    uint32_t mhz = clock_get_hz(clk_sys) / 1000000;
+    uint32_t median = samples[BENCH_SAMPLES / 2];
+    printf("{\"bench\":\"%s\",\"amostras\":%d,\"min\":%lu,\"mediana\":%lu,\"media\":%lu,"
+           "\"p99\":%lu,\"max\":%lu,\"mediana_ns\":%lu,\"unidade\":\"ciclos\"}\n",
+           bench->name, BENCH_SAMPLES, (unsigned long)samples[0], (unsigned long)median,
+           (unsigned long)(sum / BENCH_SAMPLES), (unsigned long)samples[BENCH_SAMPLES * 99 / 100],
+           (unsigned long)samples[BENCH_SAMPLES - 1], (unsigned long)(median * 1000 / mhz));
+}
+
+#if GENIUS_HEAP_TRACK
+static void __noinline site_malloc() {
+    site_ptr = malloc(8);
+}
+
+static void __noinline site_calloc() {
+    site_ptr = calloc(1, 8);
+}
+
+static void __noinline site_realloc() {
+    site_ptr = realloc(NULL, 8);
+}
+
+/**
+ * @brief Chama `fn` e confere se o rastreador atribuiu a alocação a ela.
+ */
+static bool site_matches(void (*fn)(void)) {
+    fn();
+    uintptr_t start = (uintptr_t)fn & ~1u;
+    uintptr_t site = (uintptr_t)heap_tracker_last_site();
+    free(site_ptr);
+    return site > start && site < start + SITE_BYTES;
+}
+
+/**
+ * @brief Confere o endereço de chamada do rastreador de alocações e imprime sua linha JSON.
+ */
+static void check_heap_site() {
+    bool m = site_matches(site_malloc);
+    bool c = site_matches(site_calloc);
+    bool r = site_matches(site_realloc);
+    printf("{\"verifica\":\"heap_chamador\",\"malloc\":%s,\"calloc\":%s,\"realloc\":%s}\n",
+           m ? "true" : "false", c ? "true" : "false", r ? "true" : "false");
+}
+#endif
+
+/**
+ * @brief Executa todos os benchmarks, precedidos por uma linha que identifica o build.
+ */
+static void run_all() {
+    calibrate();
+    printf("{\"inicio\":\"GENIUS_bench\",\"versao\":\"%s\",\"rev\":\"%s\",\"clk_sys_hz\":%lu,"
+           "\"hot_in_ram\":%d,\"calibracao\":%lu}\n",
+           PICO_PROGRAM_VERSION_STRING, GENIUS_GIT_REV, (unsigned long)clock_get_hz(clk_sys),
+           GENIUS_HOT_IN_RAM, (unsigned long)overhead);
+
+    for (int i = 0; i < (int)count_of(benches); i++) {
+        run_bench(&benches[i]);
+    }
+#if GENIUS_HEAP_TRACK
+    check_heap_site();
+#endif
+    printf("{\"fim\":\"GENIUS_bench\"}\n");
+    fflush(stdout);
+}
+
+/******************************
+ * Função Principal
+ ******************************/
+
+int main() {
+    stdio_init_all();
+
+    // Mesma ordem do GENIUS: a roda de temporizadores antes do gerenciador de GPIO
+    timer_wheel_init();
+    joystickPi_init();
+    gpio_irq_manager_init();
+    register_gpio_callback(IRQ_BENCH_LOAD_PIN, bench_callback, 0); // Só o despacho; sem bordas reais
+
+    fill_pitch_frame();
+
+    // SysTick livre no clock do processador
+    systick_hw->csr = 0;
+    systick_hw->rvr = SYSTICK_MAX;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5; // ENABLE | CLKSOURCE (clock do processador)
+
+    absolute_time_t deadline = make_timeout_time_ms(BENCH_USB_WAIT_MS);
+    while (!stdio_usb_connected() && !time_reached(deadline)) {
+        sleep_ms(10);
+    }
+
+    while (true) {
+        run_all();
+        while (getchar_timeout_us(0) == PICO_ERROR_TIMEOUT) {
+            sleep_ms(10); // Repete a cada caractere recebido
+        }
+    }
+}
@@ -34,9 +34,9 @@
 #define CLK_DIV_DEFAULT 125.0f
 
 /**
- * @brief Pino GPIO padrão para o buzzer.
+ * @brief Valor do registrador DIV (inteiro.fração de 4 bits) para `CLK_DIV_DEFAULT`.
  */
-#define BUZZER_PIN 21
+#define CLK_DIV_DEFAULT_REG ((uint32_t)(CLK_DIV_DEFAULT * 16))
 
 /******************************
  * Funções
@@ -71,6 +71,82 @@ uint16_t calculate_wrap(uint32_t target_frequency, float clkdiv);
  */
 void play_tone(uint pin, uint32_t freq, uint duration_ms);
 
+/**
+ * @brief Programa um tom no canal `chan` de um slice do PWM e o habilita.
+ * 
+ * Base de `start_tone()` e `start_tone_timed_slice()`: só escreve registradores, sem converter o
+ * pino.
+ * 
+ * @param slice Registradores do slice.
+ * @param chan Canal do pino no slice (0 = A, 1 = B).
+ * @param freq Frequência do tom em Hz.
+ */
+static inline void start_tone_slice(pwm_slice_hw_t *slice, uint chan, uint32_t freq) {
+    uint16_t wrap_value = calculate_wrap(freq, CLK_DIV_DEFAULT); // Calcula o valor de wrap
+    uint shift = chan ? PWM_CH0_CC_B_LSB : 0;
+
+    slice->div = CLK_DIV_DEFAULT_REG; // Divisor de clock
+    slice->top = wrap_value; // Valor de wrap
+    hw_write_masked(&slice->cc, (uint32_t)(wrap_value / 2) << shift,
+                    chan ? PWM_CH0_CC_B_BITS : PWM_CH0_CC_A_BITS); // Nível de 50% (duty cycle)
+    hw_set_bits(&slice->csr, PWM_CH0_CSR_EN_BITS); // Habilita o PWM
+}
+
+/**
+ * @brief Liga um tom contínuo no buzzer, sem bloquear.
+ * 
+ * Usa o divisor de clock padrão definido em `CLK_DIV_DEFAULT`. O tom permanece ativo até
+ * `stop_tone()`; o fim da nota pode ser agendado com um temporizador de `timer_wheel.h`.
+ * 
+ * Escreve diretamente nos registradores do slice: com um pino constante (ex.: `BUZZER_PIN`) o
+ * slice e o canal (`pwm_gpio_to_slice_num()` e `pwm_gpio_to_channel()`, inline no SDK) são
+ * resolvidos em tempo de compilação.
+ * 
+ * @param pin Pino GPIO onde o buzzer está conectado.
+ * @param freq Frequência do tom em Hz.
+ */
+static inline void start_tone(uint pin, uint32_t freq) {
+    start_tone_slice(&pwm_hw->slice[pwm_gpio_to_slice_num(pin)], pwm_gpio_to_channel(pin), freq);
+}
+
+/**
+ * @brief Igual a `start_tone()`, devolvendo o instante em que o tom chega ao pino.
+ * 
+ * TOP e CC são registradores duplos: o que é escrito só vale no próximo wrap do contador, então o
+ * tom começa no fim do período em andamento da nota anterior (até 1/f da nota anterior depois da
+ * escrita, ou imediatamente se o slice ainda não foi habilitado). O instante é calculado pelo
+ * contador lido junto com a escrita; é o início do primeiro pulso no pino, sem a resposta
+ * mecânica do buzzer.
+ * 
+ * @param slice_num Slice do PWM do pino.
+ * @param chan Canal do pino no slice (0 = A, 1 = B).
+ * @param freq Frequência do tom em Hz.
+ * @return Instante do início do tom, na base de `time_us_32()`.
+ */
+uint32_t start_tone_timed_slice(uint slice_num, uint chan, uint32_t freq);
+
+/**
+ * @brief `start_tone_timed_slice()` para um pino: com um pino constante o slice e o canal são
+ * resolvidos em tempo de compilação, fora do trecho cronometrado.
+ * 
+ * @param pin Pino GPIO onde o buzzer está conectado.
+ * @param freq Frequência do tom em Hz.
+ * @return Instante do início do tom, na base de `time_us_32()`.
+ */
+static inline uint32_t start_tone_timed(uint pin, uint32_t freq) {
+    return start_tone_timed_slice(pwm_gpio_to_slice_num(pin), pwm_gpio_to_channel(pin), freq);
+}
+
+/**
+ * @brief Desliga o tom iniciado por `start_tone()`.
+ * 
+ * @param pin Pino GPIO onde o buzzer está conectado.
+ */
+static inline void stop_tone(uint pin) {
+    hw_write_masked(&pwm_hw->slice[pwm_gpio_to_slice_num(pin)].cc, 0,
+                    pwm_gpio_to_channel(pin) ? PWM_CH0_CC_B_BITS : PWM_CH0_CC_A_BITS); // Nível 0
+}
+
 /**
  * @brief Toca um tom no buzzer com a frequência, duração e divisor de clock especificados.
  * 
@@ -5,6 +5,7 @@
 #include <stdbool.h>
 #include "pico/stdlib.h"
 #include "hardware/adc.h"
+#include "inc/board.h"
 
 /******************************
  * Documentação do Arquivo
@@ -23,6 +24,17 @@
  * 2. Leitura dos valores dos eixos X e Y (valores brutos do ADC).
  * 3. Leitura do estado do botão (pressionado ou não pressionado).
  * 4. Mapeamento dos valores do ADC para uma faixa personalizada (útil para normalização).
+ * 5. Calibração dos eixos (centro, zona morta e filtro), aplicada a todas as leituras dos eixos.
+ * 
+ * A calibração padrão não altera as leituras; `JoystickPi_calibration.h` mede o ruído do ADC com
+ * o joystick em repouso e calcula uma calibração para a placa.
+ *
+ * Módulos que mudam a FIFO, o divisor ou a alternância do ADC (calibração, carga do benchmark de
+ * GPIO, afinador) o reservam antes com `joystickPi_adc_claim()`; só um de cada vez. Enquanto o ADC
+ * está reservado as leituras dos eixos não convertem: usam as conversões que o dono fornece por
+ * `joystickPi_stream_push()` (ex.: `tuner.h`) ou, sem elas, a última leitura antes da reserva.
+ * 
+ * Os pinos e canais do ADC vêm de `board.h`.
  */
 
 /******************************
@@ -30,19 +42,19 @@
  ******************************/
 
 /**
- * @brief Pino ADC para leitura do eixo X do joystick.
+ * @brief Maior valor lido de um eixo (ADC de 12 bits).
  */
-#define JOYSTICK_X_PIN 26 // Pino ADC0 (GP26)
+#define JOYSTICK_ADC_MAX 4095
 
 /**
- * @brief Pino ADC para leitura do eixo Y do joystick.
+ * @brief Valor entregue para um eixo em repouso (dentro da zona morta).
  */
-#define JOYSTICK_Y_PIN 27 // Pino ADC1 (GP27)
+#define JOYSTICK_CENTER 2048
 
 /**
- * @brief Pino GPIO para leitura do botão do joystick.
+ * @brief Maior filtro aceito: média de 2^4 = 16 conversões por leitura de eixo.
  */
-#define JOYSTICK_BUTTON_PIN 22 // Pino GPIO para o botão
+#define JOYSTICK_MAX_OVERSAMPLE_LOG2 4
 
 /******************************
  * Estruturas
@@ -59,6 +71,27 @@ typedef struct {
     bool button;     // Estado do botão (true = pressionado, false = não pressionado)
 } joystick_state_t;
 
+/**
+ * @brief Calibração de um eixo.
+ * 
+ * A leitura filtrada (média de `1 << oversample_log2` conversões seguidas) é levada a
+ * `JOYSTICK_CENTER` se estiver a até `deadzone` de `center`; fora disso, cada lado é reescalado
+ * linearmente para que o curso continue indo de 0 a `JOYSTICK_ADC_MAX`.
+ */
+typedef struct {
+    uint16_t center;           // Leitura filtrada do eixo em repouso (0-4095)
+    uint16_t deadzone;         // Desvio máximo em torno do centro tratado como repouso
+    uint8_t oversample_log2;   // Filtro: média de 2^n conversões (0 a JOYSTICK_MAX_OVERSAMPLE_LOG2)
+} joystick_axis_cal_t;
+
+/**
+ * @brief Calibração dos dois eixos.
+ */
+typedef struct {
+    joystick_axis_cal_t x;
+    joystick_axis_cal_t y;
+} joystick_calibration_t;
+
 /******************************
  * Funções
  ******************************/
@@ -73,19 +106,21 @@ void joystickPi_init();
 /**
  * @brief Lê os valores atuais do joystick.
  * 
+ * Os eixos passam pela calibração atual (filtro, centro e zona morta).
+ * 
  * @return Estrutura `joystick_state_t` contendo os valores dos eixos X e Y e o estado do botão.
  */
 joystick_state_t joystickPi_read();
 
 /**
- * @brief Lê o valor do eixo X do joystick.
+ * @brief Lê o valor do eixo X do joystick, com a calibração atual.
  * 
  * @return Valor do eixo X (0-4095).
  */
 uint16_t joystickPi_read_x();
 
 /**
- * @brief Lê o valor do eixo Y do joystick.
+ * @brief Lê o valor do eixo Y do joystick, com a calibração atual.
  * 
  * @return Valor do eixo Y (0-4095).
  */
@@ -112,4 +147,63 @@ bool joystickPi_read_button();
  */
 int16_t joystickPi_map_value(uint16_t value, uint16_t min_input, uint16_t max_input, int16_t min_output, int16_t max_output);
 
+/**
+ * @brief Substitui a calibração usada pelas leituras dos eixos.
+ * 
+ * Valores fora da faixa são limitados (filtro até `JOYSTICK_MAX_OVERSAMPLE_LOG2`, zona morta
+ * deixando ao menos uma leitura de curso em cada lado).
+ * 
+ * @param cal Nova calibração.
+ */
+void joystickPi_set_calibration(const joystick_calibration_t *cal);
+
+/**
+ * @brief Obtém a calibração atual.
+ * 
+ * @return Calibração usada pelas leituras dos eixos.
+ */
+joystick_calibration_t joystickPi_get_calibration();
+
+/**
+ * @brief Passa a ler os eixos das conversões fornecidas por `joystickPi_stream_push()`.
+ * 
+ * Centro e zona morta continuam valendo; o filtro por média fica a cargo de quem fornece. Até o
+ * primeiro `joystickPi_stream_push()` vale a última leitura avulsa.
+ */
+void joystickPi_stream_begin();
+
+/**
+ * @brief Fornece as conversões mais recentes dos eixos.
+ * 
+ * @param x Conversão do eixo X (0-4095).
+ * @param y Conversão do eixo Y (0-4095).
+ */
+void joystickPi_stream_push(uint16_t x, uint16_t y);
+
+/**
+ * @brief Volta às leituras avulsas do ADC.
+ */
+void joystickPi_stream_end();
+
+/**
+ * @brief Reserva o ADC para um módulo que muda a FIFO, o divisor ou a alternância.
+ * 
+ * O teste e a reserva são atômicos (interrupções desabilitadas), então a função pode ser chamada
+ * de tarefas e de ISRs.
+ *
+ * @param owner Nome do módulo (impresso por quem encontrar o ADC ocupado).
+ * @return false se o ADC já estiver reservado; nada é alterado.
+ */
+bool joystickPi_adc_claim(const char *owner);
+
+/**
+ * @brief Devolve o ADC às leituras avulsas do joystick.
+ */
+void joystickPi_adc_release();
+
+/**
+ * @brief Módulo que reservou o ADC, ou NULL se estiver livre.
+ */
+const char *joystickPi_adc_owner();
+
 #endif // JOYSTICK_PI_H
@@ -0,0 +1,106 @@
+#ifndef JOYSTICK_PI_CALIBRATION_H
+#define JOYSTICK_PI_CALIBRATION_H
+
+#include "pico/stdlib.h"
+#include "inc/JoystickPi.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file JoystickPi_calibration.h
+ * @brief Caracterização do ruído do ADC e calibração automática do joystick
+ *
+ * Com o joystick solto, os dois eixos são amostrados pela DMA com o ADC em conversão contínua e
+ * alternância automática entre os canais (500 mil conversões por segundo, metade para cada eixo).
+ * São capturados `JOYSTICK_CAL_BLOCKS` blocos de `JOYSTICK_CAL_SAMPLES` conversões por eixo,
+ * espaçados de `JOYSTICK_CAL_BLOCK_GAP_MS`, para incluir variações lentas (rede elétrica, fonte).
+ *
+ * Para cada eixo são calculados:
+ * 1. Média, desvio padrão, mínimo e máximo das conversões.
+ * 2. Histograma em classes de `JOYSTICK_CAL_HIST_WIDTH` LSB em torno da média do primeiro bloco.
+ * 3. Espectro (FFT de cada bloco com janela de Hann, potências somadas entre os blocos) e seus
+ *    `JOYSTICK_CAL_PEAKS` maiores picos, com frequência e amplitude em LSB.
+ * 4. O desvio da média de 2^n conversões seguidas, para n de 0 a `JOYSTICK_MAX_OVERSAMPLE_LOG2`,
+ *    obtido diretamente das amostras (vale também para ruído que não é branco).
+ *
+ * A calibração derivada é:
+ * - Filtro: o menor n cujo desvio fica abaixo de `JOYSTICK_CAL_TARGET_STD_CENTI`.
+ * - Centro: média arredondada.
+ * - Zona morta: maior afastamento do centro entre as médias de 2^n conversões de todos os blocos,
+ *   mais `JOYSTICK_CAL_DEADZONE_MARGIN`.
+ *
+ * A medição roda na tarefa `joycal` do escalonador: a espera inicial e o intervalo entre blocos
+ * são temporizadores, então o resto do firmware continua rodando. Enquanto ela dura (cerca de
+ * 1,5 s) o ADC fica reservado e as leituras dos eixos repetem o último valor.
+ *
+ * A calibração derivada é gravada no último setor da flash (com versão e CRC) e reaplicada na
+ * partida por `joystickPi_calibration_init()`; esse setor não pode ser ocupado pelo programa.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Conversões por eixo em cada bloco (potência de 2: tamanho da FFT).
+ */
+#define JOYSTICK_CAL_SAMPLES 512
+
+/**
+ * @brief Número de blocos capturados.
+ */
+#define JOYSTICK_CAL_BLOCKS 16
+
+/**
+ * @brief Intervalo entre o início de blocos consecutivos.
+ */
+#define JOYSTICK_CAL_BLOCK_GAP_MS 25
+
+/**
+ * @brief Espera, após o aviso, para o joystick ser solto e parar de oscilar.
+ */
+#define JOYSTICK_CAL_SETTLE_MS 1000
+
+/**
+ * @brief Desvio padrão máximo desejado depois do filtro, em centésimos de LSB.
+ */
+#define JOYSTICK_CAL_TARGET_STD_CENTI 100
+
+/**
+ * @brief Folga somada à zona morta medida, em LSB.
+ */
+#define JOYSTICK_CAL_DEADZONE_MARGIN 4
+
+/**
+ * @brief Classes do histograma e largura de cada uma, em LSB.
+ */
+#define JOYSTICK_CAL_HIST_BINS 32
+#define JOYSTICK_CAL_HIST_WIDTH 2
+
+/**
+ * @brief Número de picos do espectro informados por eixo.
+ */
+#define JOYSTICK_CAL_PEAKS 3
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Aplica a calibração gravada na flash, se houver, e registra a tarefa da calibração.
+ */
+void joystickPi_calibration_init();
+
+/**
+ * @brief Inicia a medição do ruído dos eixos em repouso.
+ *
+ * Ao fim, a tarefa imprime o relatório, aplica a calibração derivada com
+ * `joystickPi_set_calibration()` e a grava na flash.
+ *
+ * @return false se uma calibração já estiver em andamento ou o ADC estiver ocupado.
+ */
+bool joystickPi_calibrate();
+
+#endif // JOYSTICK_PI_CALIBRATION_H
@@ -0,0 +1,93 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include "pico/stdlib.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file board.h
+ * @brief Descritor da placa: único lugar onde os pinos são definidos
+ *
+ * Todos os módulos obtêm os pinos daqui. A partir de cada pino são resolvidos em tempo de
+ * compilação o slice e o canal PWM, o canal do ADC e a máscara de bits usada em interrupções e
+ * leituras agrupadas (`gpio_get_all()`), de modo que as chamadas no caminho crítico se reduzem a
+ * escritas diretas em registradores com endereços constantes.
+ *
+ * As asserções estáticas ao final rejeitam pinos fora do banco 0, pinos analógicos fora do ADC,
+ * pinos usados por duas funções e PWMs diferentes no mesmo slice.
+ *
+ * | Função             | Pino | Recurso                                           |
+ * |--------------------|------|---------------------------------------------------|
+ * | Botão A            | 5    | IO_IRQ_BANK0                                      |
+ * | Botão B            | 6    | IO_IRQ_BANK0                                      |
+ * | Buzzer             | 21   | PWM slice 2, canal B                              |
+ * | Joystick X         | 26   | ADC0                                              |
+ * | Joystick Y         | 27   | ADC1                                              |
+ * | Botão do joystick  | 22   | GPIO                                              |
+ * | Microfone          | 28   | ADC2                                              |
+ * | Carga do benchmark | 18   | PWM slice 1, canal A                              |
+ * | Contador de tom    | 17   | PWM slice 0, canal B (entrada; fio até o pino 21) |
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define BUTTON_A_PIN 5
+#define BUTTON_B_PIN 6
+#define BUZZER_PIN 21
+#define JOYSTICK_X_PIN 26
+#define JOYSTICK_Y_PIN 27
+#define JOYSTICK_BUTTON_PIN 22
+#define MIC_PIN 28
+#define IRQ_BENCH_LOAD_PIN 18 // Saída dos benchmarks de latência (irq_latency.h, gpio_latency.h): deixar desconectado
+#define FREQ_COUNT_PIN 17 // Entrada do autoteste de frequência (tone_selftest.h): fio até BUZZER_PIN
+
+/**
+ * @brief Recursos derivados de um pino (RP2040).
+ */
+#define BOARD_PIN_MASK(pin) (1u << (pin))
+#define BOARD_PWM_SLICE(pin) (((pin) >> 1u) & 7u)
+#define BOARD_PWM_CHAN(pin) ((pin) & 1u)                      // 0 = canal A, 1 = canal B
+#define BOARD_PWM_CC_SHIFT(pin) (BOARD_PWM_CHAN(pin) * 16u)   // Posição do nível no registrador CC
+#define BOARD_PWM_CC_MASK(pin) (0xFFFFu << BOARD_PWM_CC_SHIFT(pin))
+#define BOARD_ADC_CHANNEL(pin) ((pin) - 26u)
+
+#define BUZZER_PWM_SLICE BOARD_PWM_SLICE(BUZZER_PIN)
+#define JOYSTICK_X_ADC BOARD_ADC_CHANNEL(JOYSTICK_X_PIN)
+#define JOYSTICK_Y_ADC BOARD_ADC_CHANNEL(JOYSTICK_Y_PIN)
+#define MIC_ADC BOARD_ADC_CHANNEL(MIC_PIN)
+
+/**
+ * @brief Máscaras de pinos por grupo.
+ */
+#define BOARD_BUTTONS_MASK (BOARD_PIN_MASK(BUTTON_A_PIN) | BOARD_PIN_MASK(BUTTON_B_PIN) | \
+                            BOARD_PIN_MASK(JOYSTICK_BUTTON_PIN))
+#define BOARD_ADC_MASK (BOARD_PIN_MASK(JOYSTICK_X_PIN) | BOARD_PIN_MASK(JOYSTICK_Y_PIN) | \
+                        BOARD_PIN_MASK(MIC_PIN))
+#define BOARD_PWM_MASK (BOARD_PIN_MASK(BUZZER_PIN) | BOARD_PIN_MASK(IRQ_BENCH_LOAD_PIN) | \
+                        BOARD_PIN_MASK(FREQ_COUNT_PIN))
+#define BOARD_USED_MASK (BOARD_BUTTONS_MASK | BOARD_ADC_MASK | BOARD_PWM_MASK)
+#define BOARD_USED_COUNT 9 // Pinos listados acima
+
+/******************************
+ * Verificações em Tempo de Compilação
+ ******************************/
+
+static_assert(BUTTON_A_PIN < 30 && BUTTON_B_PIN < 30 && JOYSTICK_BUTTON_PIN < 30 &&
+              BUZZER_PIN < 30 && IRQ_BENCH_LOAD_PIN < 30 && FREQ_COUNT_PIN < 30, "pino fora do banco 0");
+static_assert(JOYSTICK_X_PIN >= 26 && JOYSTICK_X_PIN <= 29 && JOYSTICK_Y_PIN >= 26 && JOYSTICK_Y_PIN <= 29,
+              "eixo do joystick fora dos pinos do ADC (26-29)");
+static_assert(MIC_PIN >= 26 && MIC_PIN <= 29, "microfone fora dos pinos do ADC (26-29)");
+static_assert(__builtin_popcount(BOARD_USED_MASK) == BOARD_USED_COUNT, "pino usado por mais de uma funcao");
+static_assert(BOARD_PWM_SLICE(BUZZER_PIN) != BOARD_PWM_SLICE(IRQ_BENCH_LOAD_PIN),
+              "buzzer e carga do benchmark no mesmo slice PWM");
+static_assert(BOARD_PWM_CHAN(FREQ_COUNT_PIN) == 1, "contador de tom precisa de um canal B (entrada do PWM)");
+static_assert(BOARD_PWM_SLICE(FREQ_COUNT_PIN) != BOARD_PWM_SLICE(BUZZER_PIN) &&
+              BOARD_PWM_SLICE(FREQ_COUNT_PIN) != BOARD_PWM_SLICE(IRQ_BENCH_LOAD_PIN),
+              "contador de tom num slice PWM ja usado");
+
+#endif // BOARD_H
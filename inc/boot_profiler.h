@@ -0,0 +1,77 @@
+#ifndef BOOT_PROFILER_H
+#define BOOT_PROFILER_H
+
+#include "pico/stdlib.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file boot_profiler.h
+ * @brief Linha do tempo da inicialização do firmware
+ *
+ * Cada fase da inicialização registra o instante em que terminou, em microssegundos desde a
+ * partida do temporizador do sistema. O temporizador só é liberado do reset pela `runtime_init`
+ * do SDK, logo depois de configurar os clocks (XOSC e PLLs): o bootrom, o boot2, o crt0 e a
+ * própria espera pelas PLLs acontecem antes da base de tempo e não entram na contagem.
+ * - `BOOT_PHASE_CLOCKS` é marcada por uma função de inicialização do SDK registrada logo depois
+ *   dos resets pós-clock: é o início da contagem com os clocks prontos.
+ * - `BOOT_PHASE_RUNTIME`, na entrada de `main()`, cobre o restante da `runtime_init` (spin
+ *   locks, IRQs, construtores).
+ * - As demais medem cada fase do firmware; `BOOT_PHASE_READY` é a entrada no escalonador, a
+ *   partir da qual as notas são despachadas, e a USB (`BOOT_PHASE_STDIO`) vem depois, na primeira
+ *   ativação de uma tarefa de baixa prioridade.
+ *
+ * Funcionalidades:
+ * 1. Marcação do fim de cada fase de inicialização.
+ * 2. Consulta do instante de cada fase.
+ * 3. Relatório da linha do tempo com a duração de cada fase.
+ */
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Fases da inicialização, na ordem em que ocorrem.
+ */
+typedef enum {
+    BOOT_PHASE_CLOCKS = 0,   // Clocks e resets pós-clock da runtime_init (início da contagem)
+    BOOT_PHASE_RUNTIME,      // Entrada de main(): restante da runtime_init do SDK
+    BOOT_PHASE_ADC,          // Joystick (ADC e botão)
+    BOOT_PHASE_PWM,          // Buzzer (PWM)
+    BOOT_PHASE_GPIO_IRQ,     // Botões e gerenciador de interrupções GPIO
+    BOOT_PHASE_READY,        // Tarefas registradas, entrada no escalonador: primeira nota possível
+    BOOT_PHASE_STDIO,        // USB/stdio inicializado (fora do caminho crítico)
+    BOOT_PHASE_COUNT
+} boot_phase_t;
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Registra o fim de uma fase de inicialização.
+ *
+ * @param phase Fase concluída.
+ */
+void boot_profiler_mark(boot_phase_t phase);
+
+/**
+ * @brief Obtém o instante em que uma fase terminou.
+ *
+ * @param phase Fase desejada.
+ * @return Microssegundos desde a partida do temporizador (0 se a fase não foi marcada).
+ */
+uint32_t boot_profiler_time_us(boot_phase_t phase);
+
+/**
+ * @brief Imprime a linha do tempo da inicialização.
+ *
+ * Além das fases, imprime o instante da primeira nota possível e quanto ele seria com a USB
+ * inicializada antes do escalonador (a ordem anterior do `main()`).
+ */
+void boot_profiler_report();
+
+#endif // BOOT_PROFILER_H
@@ -0,0 +1,88 @@
+#ifndef BOUNCE_PROFILER_H
+#define BOUNCE_PROFILER_H
+
+#include "pico/stdlib.h"
+#include "inc/board.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file bounce_profiler.h
+ * @brief Caracterização do repique das chaves e ajuste do debounce por pino
+ *
+ * `DEBOUNCE_DELAY_MS` é um valor único para todos os botões, o intervalo que separa rajadas
+ * (`BOUNCE_PROF_GAP_US`) mais um tick. Este modo mede o que cada chave realmente precisa:
+ * 1. Captura: com a interrupção do banco GPIO desligada (os toques não acionam o instrumento), os
+ *    pinos dos botões A, B e do joystick são amostrados continuamente pelo SIO e cada mudança é
+ *    gravada com o instante em microssegundos. A captura termina após `BOUNCE_PROF_IDLE_MS` sem
+ *    bordas, quando todos os botões somam `BOUNCE_PROF_PRESSES` toques, ou em
+ *    `BOUNCE_PROF_TIMEOUT_MS`.
+ * 2. Análise: as bordas de cada pino são agrupadas em rajadas separadas por mais de
+ *    `BOUNCE_PROF_GAP_US` de silêncio. Cada rajada é um aperto (termina em nível baixo) ou uma
+ *    soltura (termina em nível alto); sua duração, da primeira à última borda, é o repique.
+ * 3. Sugestão: o maior repique observado no pino, com `BOUNCE_PROF_MARGIN_PCT` de margem,
+ *    arredondado para cima em milissegundos e somado a um tick da roda de temporizadores (que
+ *    pode expirar até 1 ms antes do prazo). Pinos com menos de `BOUNCE_PROF_MIN_PRESSES` toques
+ *    não recebem sugestão.
+ *
+ * A sugestão pode ser aplicada com `gpio_irq_manager_set_debounce()`, que rearma o bloqueio a
+ * cada borda: cobrir a rajada mais longa basta para o aperto e para a soltura. O ajuste vale até a
+ * próxima reinicialização.
+ *
+ * A amostragem corre com as demais interrupções habilitadas; bordas mais curtas que uma
+ * interrupção da USB ou do temporizador (alguns microssegundos) podem não ser vistas.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Toques por botão que encerram a captura (se todos os botões os atingirem).
+ */
+#define BOUNCE_PROF_PRESSES 20
+
+/**
+ * @brief Toques mínimos em um pino para sugerir um debounce.
+ */
+#define BOUNCE_PROF_MIN_PRESSES 5
+
+/**
+ * @brief Capacidade do registro de bordas (todos os pinos).
+ */
+#define BOUNCE_PROF_MAX_EDGES 2048
+
+/**
+ * @brief Silêncio que separa duas rajadas do mesmo pino.
+ */
+#define BOUNCE_PROF_GAP_US 20000
+
+/**
+ * @brief Silêncio, depois do primeiro toque, que encerra a captura.
+ */
+#define BOUNCE_PROF_IDLE_MS 5000
+
+/**
+ * @brief Duração máxima da captura.
+ */
+#define BOUNCE_PROF_TIMEOUT_MS 60000
+
+/**
+ * @brief Margem sobre o maior repique observado, em porcento.
+ */
+#define BOUNCE_PROF_MARGIN_PCT 50
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Captura as bordas dos botões, imprime a distribuição do repique e sugere o debounce.
+ *
+ * @param apply true para aplicar a sugestão de cada pino ao `gpio_irq_manager`.
+ */
+void bounce_profiler_run(bool apply);
+
+#endif // BOUNCE_PROFILER_H
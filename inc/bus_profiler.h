@@ -0,0 +1,144 @@
+#ifndef BUS_PROFILER_H
+#define BUS_PROFILER_H
+
+#include "pico/stdlib.h"
+#include "inc/genius_config.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file bus_profiler.h
+ * @brief Medição de contenção no barramento com os contadores de desempenho do BUSCTRL
+ *
+ * Quando a DMA, o PWM ou o segundo núcleo disputam o mesmo escravo do barramento, o árbitro
+ * insere ciclos de espera que não aparecem em nenhuma outra medição. O bloco BUSCTRL do RP2040
+ * possui quatro contadores que podem contar acessos (e acessos disputados) a cada escravo:
+ * bancos de SRAM, APB, periféricos rápidos, XIP e ROM.
+ *
+ * Funcionalidades:
+ * 1. Conjuntos predefinidos de quatro eventos (bancos de SRAM, SRAM de rascunho, periféricos).
+ * 2. Janelas de medição com duração configurável, reiniciadas continuamente.
+ * 3. Resultado da última janela completa no relatório e, resumido em acessos disputados por
+ *    milissegundo, na linha de status (`show_status()`).
+ * 4. Prioridade alta no barramento para o mestre DMA (usado pelo áudio), aplicada na partida com
+ *    `GENIUS_BUS_PRIORITY_DMA` e indicada no relatório.
+ *
+ * Os contadores de hardware têm 24 bits e saturam; janelas longas demais são sinalizadas no
+ * relatório.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Número de contadores de desempenho do BUSCTRL.
+ */
+#define BUS_PROF_COUNTERS 4
+
+/**
+ * @brief Duração padrão da janela de medição em milissegundos.
+ */
+#define BUS_PROF_DEFAULT_WINDOW_MS 1000
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Conjuntos de eventos programados nos quatro contadores.
+ */
+typedef enum {
+    BUS_PROF_PRESET_SRAM_STRIPED = 0, // Acessos disputados nos bancos SRAM0-3 (memória principal)
+    BUS_PROF_PRESET_SRAM_SCRATCH,     // Acessos e disputas em SRAM4 (SCRATCH_X) e SRAM5 (SCRATCH_Y)
+    BUS_PROF_PRESET_PERIPH,           // Acessos e disputas no APB e no XIP
+    BUS_PROF_PRESET_COUNT
+} bus_prof_preset_t;
+
+/**
+ * @brief Resultado de uma janela de medição.
+ */
+typedef struct {
+    bus_prof_preset_t preset;                // Conjunto de eventos medido
+    uint32_t window_us;                      // Duração real da janela
+    uint32_t counts[BUS_PROF_COUNTERS];      // Valor de cada contador ao fim da janela
+    bool saturated;                          // Algum contador atingiu o valor máximo
+    uint32_t windows;                        // Número de janelas completas desde o início
+} bus_prof_result_t;
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Programa os contadores com um conjunto de eventos e inicia uma janela de medição.
+ *
+ * @param preset Conjunto de eventos a medir.
+ * @param window_ms Duração de cada janela em milissegundos.
+ */
+void bus_profiler_start(bus_prof_preset_t preset, uint32_t window_ms);
+
+/**
+ * @brief Verifica se a janela atual terminou e, nesse caso, guarda o resultado e inicia outra.
+ *
+ * Deve ser chamada periodicamente pelo laço principal.
+ */
+void bus_profiler_poll();
+
+/**
+ * @brief Avança para o próximo conjunto de eventos, mantendo a duração da janela.
+ */
+void bus_profiler_next_preset();
+
+/**
+ * @brief Obtém o resultado da última janela completa.
+ *
+ * @return Ponteiro para o resultado (somente leitura).
+ */
+const bus_prof_result_t *bus_profiler_result();
+
+/**
+ * @brief Mede um trecho de código com um conjunto de eventos, fora das janelas periódicas.
+ *
+ * Programa os contadores, executa `work` e devolve os valores finais. A janela periódica em
+ * andamento (se houver) é reiniciada com o seu conjunto de eventos original ao final.
+ *
+ * @param preset Conjunto de eventos a medir.
+ * @param work Função a ser medida.
+ * @param counts Vetor que recebe o valor final de cada contador.
+ */
+void bus_profiler_sample(bus_prof_preset_t preset, void (*work)(void), uint32_t counts[BUS_PROF_COUNTERS]);
+
+/**
+ * @brief Obtém o nome curto de um conjunto de eventos.
+ *
+ * @param preset Conjunto de eventos.
+ * @return Nome usado no relatório e no status.
+ */
+const char *bus_profiler_preset_name(bus_prof_preset_t preset);
+
+/**
+ * @brief Soma dos contadores de acessos disputados da última janela, por milissegundo.
+ *
+ * @return Acessos disputados por milissegundo, ou 0 antes da primeira janela completa.
+ */
+uint32_t bus_profiler_contested_per_ms();
+
+/**
+ * @brief Imprime o resultado da última janela completa.
+ */
+void bus_profiler_report();
+
+/**
+ * @brief Dá prioridade alta no barramento às leituras e escritas da DMA.
+ *
+ * Com prioridade alta o árbitro atende a DMA antes dos núcleos quando há disputa,
+ * garantindo a vazão do áudio às custas de algumas esperas nos núcleos.
+ *
+ * @param high true para prioridade alta, false para a prioridade padrão.
+ */
+void bus_profiler_set_dma_priority(bool high);
+
+#endif // BUS_PROFILER_H
@@ -0,0 +1,103 @@
+#ifndef CONTROL_LATENCY_H
+#define CONTROL_LATENCY_H
+
+#include "pico/stdlib.h"
+#include "inc/genius_config.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file control_latency.h
+ * @brief Latência de controle do joystick até a altura da nota no buzzer
+ *
+ * Um movimento do joystick só altera o som depois de passar por quatro estágios, cada um com seu
+ * instante registrado:
+ * 1. ADC: leitura do eixo X feita pelo sequenciador (`update_sound`).
+ * 2. Filtro: cálculo do multiplicador de frequência (`freq_mult`) a partir da leitura.
+ * 3. Sequenciador: início da próxima nota, quando o multiplicador é aplicado à frequência.
+ * 4. PWM: escrita dos registradores do buzzer (`start_tone`).
+ *
+ * Um evento de controle começa na primeira leitura do eixo X, de qualquer tarefa, que difere da
+ * leitura por trás da última altura aplicada em mais de `CONTROL_LATENCY_THRESHOLD`, e termina na
+ * escrita do PWM seguinte. A latência total inclui a espera pelo fim da nota atual, que domina a
+ * sensação de resposta ao tocar. O instante da primeira leitura tem a resolução da tarefa que lê
+ * o joystick com mais frequência (o status, a cada 100 ms).
+ *
+ * O relatório mostra a distribuição da latência total em classes de potência de 2 (ms) e o
+ * tempo médio e máximo de cada estágio. As macros não geram código quando
+ * `GENIUS_CONTROL_LATENCY` é 0.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Diferença mínima no eixo X (de 0 a 4095) considerada um movimento.
+ */
+#define CONTROL_LATENCY_THRESHOLD 64
+
+/**
+ * @brief Classes do histograma: [0, 1) ms, [1, 2) ms, [2, 4) ms, ... e a última sem limite.
+ */
+#define CONTROL_LATENCY_BINS 13
+
+/******************************
+ * Macros de Instrumentação
+ ******************************/
+
+#if GENIUS_CONTROL_LATENCY
+#define CONTROL_LATENCY_SEEN(x) control_latency_seen(x)
+#define CONTROL_LATENCY_ADC(x) control_latency_adc(x)
+#define CONTROL_LATENCY_FILTER() control_latency_filter()
+#define CONTROL_LATENCY_APPLY() control_latency_apply()
+#define CONTROL_LATENCY_COMMIT() control_latency_commit()
+#else
+#define CONTROL_LATENCY_SEEN(x) ((void)0)
+#define CONTROL_LATENCY_ADC(x) ((void)0)
+#define CONTROL_LATENCY_FILTER() ((void)0)
+#define CONTROL_LATENCY_APPLY() ((void)0)
+#define CONTROL_LATENCY_COMMIT() ((void)0)
+#endif
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Registra uma leitura do eixo X feita fora do sequenciador (ex.: status).
+ *
+ * @param x Valor lido (0-4095).
+ */
+void control_latency_seen(uint16_t x);
+
+/**
+ * @brief Estágio 1: leitura do eixo X feita pelo sequenciador.
+ *
+ * @param x Valor lido (0-4095).
+ */
+void control_latency_adc(uint16_t x);
+
+/**
+ * @brief Estágio 2: multiplicador calculado a partir da última leitura do sequenciador.
+ */
+void control_latency_filter();
+
+/**
+ * @brief Estágio 3: multiplicador aplicado à frequência da nota que vai começar.
+ */
+void control_latency_apply();
+
+/**
+ * @brief Estágio 4: registradores do PWM escritos; fecha o evento de controle pendente.
+ */
+void control_latency_commit();
+
+/**
+ * @brief Imprime a distribuição da latência e os tempos por estágio, e reinicia as estatísticas.
+ */
+void control_latency_report();
+
+#endif // CONTROL_LATENCY_H
@@ -0,0 +1,121 @@
+#ifndef GENIUS_CONFIG_H
+#define GENIUS_CONFIG_H
+
+#include "pico/stdlib.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file genius_config.h
+ * @brief Opções de compilação do firmware GENIUS
+ *
+ * Este arquivo centraliza as chaves de compilação que habilitam os modos de instrumentação e
+ * as otimizações de posicionamento de código. Todas as opções podem ser sobrescritas pelo
+ * CMake (`target_compile_definitions`) e assumem aqui o valor padrão caso não sejam definidas.
+ *
+ * Funcionalidades:
+ * 1. Valores padrão das opções de instrumentação.
+ * 2. Macro para posicionar funções críticas na SRAM em vez da flash (XIP).
+ */
+
+/******************************
+ * Opções de Compilação
+ ******************************/
+
+/**
+ * @brief Habilita a medição da taxa de acerto do cache XIP por subsistema.
+ *
+ * Quando 0, as macros de instrumentação não geram código algum.
+ */
+#ifndef GENIUS_XIP_PROFILE
+#define GENIUS_XIP_PROFILE 0
+#endif
+
+/**
+ * @brief Habilita a medição de contenção no barramento com os contadores do BUSCTRL.
+ */
+#ifndef GENIUS_BUS_PROFILE
+#define GENIUS_BUS_PROFILE 0
+#endif
+
+/**
+ * @brief Dá prioridade alta no barramento ao mestre DMA usado pelo áudio.
+ */
+#ifndef GENIUS_BUS_PRIORITY_DMA
+#define GENIUS_BUS_PRIORITY_DMA 0
+#endif
+
+/**
+ * @brief Posiciona buffers de áudio e filas de eventos nos bancos SCRATCH_X/SCRATCH_Y.
+ *
+ * Compilar com 0 mantém os dados na memória principal (ver `mem_layout.h`).
+ */
+#ifndef GENIUS_MEM_LAYOUT
+#define GENIUS_MEM_LAYOUT 1
+#endif
+
+/**
+ * @brief Intercepta as alocações da newlib e registra contagem, bytes e endereço de chamada.
+ */
+#ifndef GENIUS_HEAP_TRACK
+#define GENIUS_HEAP_TRACK 0
+#endif
+
+/**
+ * @brief Causa `panic()` em qualquer alocação feita após o fim da inicialização.
+ *
+ * Só tem efeito junto com `GENIUS_HEAP_TRACK`.
+ */
+#ifndef GENIUS_HEAP_STRICT
+#define GENIUS_HEAP_STRICT 0
+#endif
+
+/**
+ * @brief Executa a ISR, o sequenciador e o motor de áudio a partir da SRAM.
+ *
+ * Compilar com 0 mantém tudo na flash, permitindo comparar a latência antes/depois.
+ */
+#ifndef GENIUS_HOT_IN_RAM
+#define GENIUS_HOT_IN_RAM 1
+#endif
+
+/**
+ * @brief Registra os instantes de cada estágio entre o joystick e a altura da nota.
+ *
+ * Quando 0, as macros de `control_latency.h` não geram código algum.
+ */
+#ifndef GENIUS_CONTROL_LATENCY
+#define GENIUS_CONTROL_LATENCY 0
+#endif
+
+/**
+ * @brief Gravação e reprodução das entradas (bordas dos botões e leituras do joystick).
+ *
+ * Quando 0, as macros de `input_trace.h` não geram código algum e os comandos 'r', 'o' e 'x'
+ * ficam indisponíveis.
+ */
+#ifndef GENIUS_INPUT_TRACE
+#define GENIUS_INPUT_TRACE 1
+#endif
+
+/******************************
+ * Posicionamento de Código
+ ******************************/
+
+/**
+ * @brief Declara uma função do caminho crítico.
+ *
+ * Com `GENIUS_HOT_IN_RAM` habilitado a função é copiada para a SRAM na inicialização
+ * (`__not_in_flash_func`), eliminando as faltas no cache XIP durante sua execução.
+ *
+ * Uso: `void GENIUS_HOT_FUNC(minha_funcao)(int arg) { ... }`
+ */
+#if GENIUS_HOT_IN_RAM
+#define GENIUS_HOT_FUNC(func_name) __not_in_flash_func(func_name)
+#else
+#define GENIUS_HOT_FUNC(func_name) func_name
+#endif
+
+#endif // GENIUS_CONFIG_H
@@ -80,6 +80,35 @@ void register_gpio_callback(uint gpio, void (*callback)(void), uint32_t event_ma
  */
 void remove_gpio_callback(uint gpio, uint32_t event_mask);
 
+/**
+ * @brief Altera o tempo de debounce de um pino com callback registrado.
+ * 
+ * O padrão é `DEBOUNCE_DELAY_MS` (21 ms), restaurado a cada `register_gpio_callback()`. O
+ * bloqueio recomeça a cada borda do pino, então basta cobrir o repique mais longo da chave
+ * (medido por `bounce_profiler.h`).
+ * 
+ * @param gpio Pino GPIO.
+ * @param ms Intervalo mínimo entre interrupções aceitas, em milissegundos (0 desabilita o debounce).
+ */
+void gpio_irq_manager_set_debounce(uint gpio, uint16_t ms);
+
+/**
+ * @brief Obtém o tempo de debounce de um pino.
+ * 
+ * @param gpio Pino GPIO.
+ * @return Intervalo de bloqueio em milissegundos (0 = sem debounce ou pino inválido).
+ */
+uint16_t gpio_irq_manager_get_debounce(uint gpio);
+
+/**
+ * @brief Instante em que a borda atual chegou ao `gpio_irq_handler`.
+ * 
+ * Só é válido dentro de um callback: é a marca de tempo da borda, sem a latência do despacho.
+ * 
+ * @return Valor de `time_us_32()` na entrada da interrupção.
+ */
+uint32_t gpio_irq_manager_edge_time_us();
+
 /**
  * @brief Inicializa o gerenciador de interrupções GPIO.
  * 
@@ -0,0 +1,79 @@
+#ifndef GPIO_LATENCY_H
+#define GPIO_LATENCY_H
+
+#include "pico/stdlib.h"
+#include "inc/board.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file gpio_latency.h
+ * @brief Latência borda-callback das interrupções GPIO, com o pino estimulando a si mesmo
+ *
+ * O pino `GPIO_BENCH_PIN` é configurado como saída e com interrupção nas duas bordas: no RP2040
+ * a entrada de um pino continua ativa com a saída habilitada, então cada inversão feita pelo SIO
+ * gera uma interrupção no próprio pino, sem fio externo. O SysTick é lido imediatamente antes da
+ * inversão e na entrada do código de tratamento; a diferença é a latência em ciclos.
+ *
+ * Três caminhos de despacho são medidos:
+ * 1. Compartilhado: `gpio_irq_manager` (`gpio_irq_handler` e o callback registrado), sem debounce.
+ * 2. Bruto: handler registrado com `gpio_add_raw_irq_handler()`, que reconhece a borda sozinho.
+ * 3. Adiado: o handler bruto reconhece a borda e pende uma interrupção de usuário na prioridade
+ *    de fundo (`irq_priority.h`), que executa o callback fora da ISR do banco GPIO.
+ *
+ * Cada caminho é medido sem carga e com carga sintética:
+ * 1. USB: texto enviado continuamente pela stdio USB (interrupções USBCTRL).
+ * 2. ADC: conversão contínua com interrupção da FIFO (`GPIO_BENCH_ADC_HZ` amostras por segundo).
+ *
+ * As amostras são acumuladas num histograma de `GPIO_BENCH_BIN_CYCLES` ciclos por classe;
+ * mínimo e máximo são exatos, mediana e p99 têm a resolução da classe.
+ *
+ * O pino é configurado como saída: não conecte nada a ele durante o benchmark.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Pino estimulado (o mesmo pino livre usado como carga por `irq_latency.h`).
+ */
+#define GPIO_BENCH_PIN IRQ_BENCH_LOAD_PIN
+
+/**
+ * @brief Número de bordas por combinação de caminho e carga.
+ */
+#define GPIO_BENCH_SAMPLES 4000
+
+/**
+ * @brief Largura de cada classe do histograma, em ciclos.
+ */
+#define GPIO_BENCH_BIN_CYCLES 8
+
+/**
+ * @brief Número de classes do histograma (a última acumula as amostras acima da faixa).
+ */
+#define GPIO_BENCH_BINS 256
+
+/**
+ * @brief Taxa de conversão do ADC durante a carga sintética.
+ */
+#define GPIO_BENCH_ADC_HZ 50000
+
+/**
+ * @brief Tempo máximo de espera por uma interrupção antes de contar a borda como perdida.
+ */
+#define GPIO_BENCH_TIMEOUT_US 1000
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Executa o benchmark e imprime mínimo, mediana, p99 e máximo (ciclos) de cada caminho.
+ */
+void gpio_latency_benchmark();
+
+#endif // GPIO_LATENCY_H
@@ -0,0 +1,95 @@
+#ifndef HEAP_TRACKER_H
+#define HEAP_TRACKER_H
+
+#include "pico/stdlib.h"
+#include "inc/genius_config.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file heap_tracker.h
+ * @brief Rastreamento de alocações dinâmicas e modo de execução sem alocações
+ *
+ * Os caminhos de reprodução e de entrada não devem usar `malloc`. A newlib, porém, pode alocar
+ * sem que o código peça (o primeiro `printf` aloca o buffer de `stdout`). Este módulo intercepta
+ * as funções reentrantes da newlib (`_malloc_r`, `_calloc_r`, `_realloc_r`, `_free_r`) com a
+ * opção `--wrap` do ligador; assim são capturadas tanto as chamadas a `malloc` quanto as
+ * alocações internas da biblioteca.
+ *
+ * Funcionalidades:
+ * 1. Contagem de alocações e bytes por subsistema (contexto) e por endereço de chamada.
+ * 2. Contexto atual definido pelo escalonador com o nome da tarefa (`HEAP_CONTEXT`).
+ * 3. Modo estrito: após `heap_tracker_lock()` qualquer alocação causa `panic()`.
+ * 4. Relatório pela saída padrão.
+ *
+ * O endereço de chamada é quem chamou `malloc`, `calloc` ou `realloc` ou, nas alocações internas
+ * da newlib, a função que chamou a reentrante (por exemplo, `__smakebuf_r`); use
+ * `arm-none-eabi-addr2line -e GENIUS.elf` para resolvê-lo. O chamador de uma função pública é lido
+ * da pilha numa posição calibrada na partida (heurística descrita em `heap_tracker.c`, com os
+ * modos de falha); se a calibração for recusada o relatório avisa e o endereço fica dentro da
+ * newlib. O GENIUS_bench confere o chamador no hardware. Uma
+ * alocação feita dentro de outra (`calloc` e `realloc` usam `_malloc_r`) conta uma vez, e um
+ * `realloc` que cresce no lugar não conta.
+ * Com `GENIUS_HEAP_TRACK` desabilitado nenhuma função é interceptada e as macros não geram código.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Número máximo de pares (contexto, endereço) distintos registrados.
+ */
+#define HEAP_TRACK_MAX_SITES 16
+
+/******************************
+ * Macros
+ ******************************/
+
+#if GENIUS_HEAP_TRACK
+#define HEAP_CONTEXT(name) heap_tracker_set_context(name)
+#else
+#define HEAP_CONTEXT(name) ((void)0)
+#endif
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Define o subsistema ao qual as próximas alocações serão atribuídas.
+ *
+ * @param name Nome do subsistema (string estática).
+ */
+void heap_tracker_set_context(const char *name);
+
+/**
+ * @brief Encerra a fase de inicialização.
+ *
+ * No modo estrito (`GENIUS_HEAP_STRICT`) qualquer alocação posterior causa `panic()`; caso
+ * contrário as alocações continuam sendo apenas registradas.
+ */
+void heap_tracker_lock();
+
+/**
+ * @brief Endereço de chamada registrado na alocação mais recente.
+ *
+ * @return Endereço, ou NULL sem alocações ou sem `GENIUS_HEAP_TRACK`.
+ */
+void *heap_tracker_last_site();
+
+/**
+ * @brief Obtém o número de alocações feitas após `heap_tracker_lock()`.
+ *
+ * @return Quantidade de alocações em regime permanente (deve ser 0).
+ */
+uint32_t heap_tracker_runtime_allocs();
+
+/**
+ * @brief Imprime as alocações agrupadas por subsistema e endereço de chamada.
+ */
+void heap_tracker_report();
+
+#endif // HEAP_TRACKER_H
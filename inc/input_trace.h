@@ -0,0 +1,153 @@
+#ifndef INPUT_TRACE_H
+#define INPUT_TRACE_H
+
+#include "pico/stdlib.h"
+#include "inc/genius_config.h"
+#include "inc/JoystickPi.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file input_trace.h
+ * @brief Gravação e reprodução das entradas para reproduzir problemas de tempo
+ *
+ * Gravação: a partir do estado inicial do instrumento (primeira música, parado), cada entrada é
+ * guardada com o instante em microssegundos desde o início da gravação:
+ * 1. Bordas dos botões, como chegam ao `gpio_irq_handler` (pino e máscara de eventos), inclusive
+ *    as que caem no bloqueio de debounce.
+ * 2. Leituras do joystick por `joystickPi_read()` (eixos já calibrados e botão), só quando mudam.
+ *
+ * Cada evento ocupa 8 bytes em um vetor estático de `INPUT_TRACE_CAPACITY` posições; a gravação
+ * para quando ele enche ou após `INPUT_TRACE_MAX_US`.
+ *
+ * O registro é impresso pela serial como um roteiro do `GENIUS_sim` (`sim/sim_script.h`), deslocado
+ * de `INPUT_TRACE_SIM_OFFSET_MS` para a inicialização da simulação: basta salvar a saída e executar
+ * `GENIUS_sim trace.txt --onsets notas.csv` para ver o mesmo problema no host. O botão do joystick
+ * sai como `press joy` / `release joy` quando muda. Os comandos da serial não fazem parte do
+ * registro: um modo ligado antes da gravação (ex.: teremim) precisa da sua linha `key` no início
+ * do roteiro.
+ *
+ * Reprodução na placa: a interrupção do banco GPIO é desligada (os botões reais são ignorados) e
+ * um alarme de hardware entrega cada borda gravada ao `gpio_irq_handler` no mesmo instante
+ * relativo; `joystickPi_read()` passa a devolver a última leitura gravada até o instante atual. A
+ * velocidade pode ser multiplicada para usar o registro como gerador de carga: o relatório mostra
+ * o atraso de entrega de cada borda, e os relatórios do escalonador ('t') e da roda de
+ * temporizadores ('w') mostram o efeito nas tarefas.
+ *
+ * A fase das tarefas periódicas em relação às entradas não faz parte do registro; diferenças de
+ * até um período de tarefa são esperadas entre a gravação e a reprodução.
+ *
+ * As macros não geram código quando `GENIUS_INPUT_TRACE` é 0.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Número máximo de eventos gravados.
+ */
+#define INPUT_TRACE_CAPACITY 2048
+
+/**
+ * @brief Duração máxima de uma gravação (instantes relativos em 32 bits).
+ */
+#define INPUT_TRACE_MAX_US 3600000000u
+
+/**
+ * @brief Deslocamento dos eventos no roteiro da simulação.
+ */
+#define INPUT_TRACE_SIM_OFFSET_MS 100
+
+/**
+ * @brief Velocidade da reprodução usada como gerador de carga.
+ */
+#define INPUT_TRACE_BENCH_SPEED 8
+
+#if GENIUS_INPUT_TRACE
+#define INPUT_TRACE_EDGE(gpio, events) input_trace_edge(gpio, events)
+#define INPUT_TRACE_JOYSTICK(state) input_trace_joystick(state)
+#else
+#define INPUT_TRACE_EDGE(gpio, events) ((void)0)
+#define INPUT_TRACE_JOYSTICK(state) ((void)0)
+#endif
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Estado do registro.
+ */
+typedef enum {
+    INPUT_TRACE_IDLE = 0,
+    INPUT_TRACE_RECORDING,
+    INPUT_TRACE_REPLAYING,
+} input_trace_mode_t;
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Descarta o registro anterior e começa a gravar.
+ *
+ * O chamador deve levar o instrumento ao estado inicial antes.
+ */
+void input_trace_record_start();
+
+/**
+ * @brief Para a gravação e imprime o tamanho do registro.
+ */
+void input_trace_record_stop();
+
+/**
+ * @brief Grava uma borda recebida pelo `gpio_irq_handler` (contexto de IRQ).
+ *
+ * @param gpio Pino.
+ * @param events Máscara de eventos `GPIO_IRQ_*`.
+ */
+void input_trace_edge(uint gpio, uint32_t events);
+
+/**
+ * @brief Grava uma leitura do joystick ou, durante a reprodução, a substitui pela gravada.
+ *
+ * @param state Leitura feita por `joystickPi_read()`.
+ */
+void input_trace_joystick(joystick_state_t *state);
+
+/**
+ * @brief Começa a reproduzir o registro.
+ *
+ * O chamador deve levar o instrumento ao estado inicial antes.
+ *
+ * @param speed Multiplicador da velocidade (1 = tempo original).
+ * @return false se o registro estiver vazio ou não houver alarme de hardware livre.
+ */
+bool input_trace_replay_start(uint speed);
+
+/**
+ * @brief Interrompe a reprodução e devolve os botões ao hardware.
+ */
+void input_trace_replay_stop();
+
+/**
+ * @brief Estado atual do registro.
+ */
+input_trace_mode_t input_trace_mode();
+
+/**
+ * @brief Imprime o resumo de uma reprodução que terminou desde a última chamada.
+ *
+ * Chamada periodicamente por uma tarefa (a reprodução termina no contexto de IRQ).
+ */
+void input_trace_poll();
+
+/**
+ * @brief Imprime o registro como um roteiro do `GENIUS_sim`.
+ */
+void input_trace_dump();
+
+#endif // INPUT_TRACE_H
@@ -0,0 +1,63 @@
+#ifndef IRQ_LATENCY_H
+#define IRQ_LATENCY_H
+
+#include "pico/stdlib.h"
+#include "inc/board.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file irq_latency.h
+ * @brief Benchmark da latência de entrada das interrupções sob carga
+ *
+ * Para cada nível do plano de prioridades (`irq_priority.h`) uma interrupção de usuário livre
+ * (IRQ 26-31) é configurada com a mesma prioridade e disparada por software. O tempo entre o
+ * disparo e a primeira instrução da ISR é medido em ciclos com o SysTick. Uma interrupção
+ * pendente só espera por ISRs de prioridade igual ou maior, portanto o valor medido é a
+ * espera de preempção que uma IRQ daquele nível sofreria.
+ *
+ * As medições são repetidas sem carga e com carga sintética:
+ * 1. USB: texto enviado pela stdio USB antes de cada disparo (interrupções USBCTRL).
+ * 2. GPIO: um PWM gera bordas no pino `IRQ_BENCH_LOAD_PIN` (`board.h`), com interrupção nas duas
+ *    bordas.
+ *
+ * Limites da prova: ela não inclui o custo de despacho de cada tratador real (cadeia de
+ * tratadores compartilhados do SDK, `gpio_irq_handler`, ISR da DMA), e a carga USB é gerada no
+ * mesmo núcleo antes do disparo, então as interrupções USBCTRL só coincidem com parte das
+ * medições: os números são a entrada no NVIC sob carga, não o pior caso dos tratadores de PWM,
+ * DMA, alarme e USB.
+ *
+ * O caminho GPIO é medido também no tratador real: durante as cargas GPIO o callback do pino de
+ * carga, chamado pelo `gpio_irq_handler`, lê o contador do PWM (divisor 1, um tique por ciclo) e
+ * obtém o atraso desde a borda, válido até meio período de `IRQ_BENCH_LOAD_HZ` (bordas com atraso
+ * maior são contadas à parte).
+ *
+ * O pino de carga é configurado como saída: não conecte nada a ele durante o benchmark.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Frequência das bordas geradas no pino de carga (duas interrupções por período).
+ */
+#define IRQ_BENCH_LOAD_HZ 20000
+
+/**
+ * @brief Número de amostras por combinação de nível e carga.
+ */
+#define IRQ_BENCH_SAMPLES 2000
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Executa o benchmark e imprime mínimo, média e máximo (ciclos e ns) de cada nível.
+ */
+void irq_latency_benchmark();
+
+#endif // IRQ_LATENCY_H
@@ -0,0 +1,43 @@
+#ifndef IRQ_PRIORITY_H
+#define IRQ_PRIORITY_H
+
+#include "pico/stdlib.h"
+#include "hardware/irq.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file irq_priority.h
+ * @brief Plano central de prioridades de interrupção
+ *
+ * O NVIC do Cortex-M0+ implementa apenas os dois bits mais significativos da prioridade, ou seja,
+ * quatro níveis (0x00 é o mais alto). Por padrão o SDK coloca todas as interrupções em
+ * `PICO_DEFAULT_IRQ_PRIORITY` (0x80), e uma ISR lenta da USB pode atrasar a temporização das notas
+ * ou o debounce dos botões. O plano abaixo é aplicado por `gpio_irq_manager_init()` (banco GPIO)
+ * e pela inicialização do player (temporizador, áudio e USB):
+ *
+ * | Nível      | Prioridade | Interrupções                                 |
+ * |------------|------------|----------------------------------------------|
+ * | Áudio      | 0x00       | PWM_IRQ_WRAP, DMA_IRQ_0 (motor de áudio)       |
+ * | Tempo      | 0x40       | Alarme do temporizador (fim de nota, timeouts) |
+ * | Entrada    | 0x80       | IO_IRQ_BANK0 (botões)                          |
+ * | Fundo      | 0xC0       | USBCTRL_IRQ (stdio USB)                        |
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define IRQ_PRIORITY_AUDIO      0x00 // Caminho de áudio: nunca deve esperar
+#define IRQ_PRIORITY_TIMING     0x40 // Alarmes que marcam o tempo das notas
+#define IRQ_PRIORITY_INPUT      0x80 // Botões: o debounce tolera dezenas de microssegundos
+#define IRQ_PRIORITY_BACKGROUND 0xC0 // USB e demais tarefas sem requisito de tempo
+
+/**
+ * @brief Interrupção do alarme usado pelo pool padrão do SDK (`sleep_ms`, `add_alarm_in_ms`).
+ */
+#define IRQ_TIMER_DEFAULT_POOL (TIMER_IRQ_0 + PICO_TIME_DEFAULT_ALARM_POOL_HARDWARE_ALARM_NUM)
+
+#endif // IRQ_PRIORITY_H
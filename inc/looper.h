@@ -0,0 +1,157 @@
+#ifndef LOOPER_H
+#define LOOPER_H
+
+#include "pico/stdlib.h"
+#include "inc/songs.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file looper.h
+ * @brief Looper: grava as notas tocadas, repete em loop e sobrepõe camadas
+ *
+ * As notas vêm do reprodutor, com a altura já modificada pelo joystick (`player.current_freq`):
+ * instante de início, frequência e duração programada de cada nota tocada ao vivo.
+ *
+ * Uso pela serial (comando 'e', em ciclo):
+ * 1. Vazio -> gravando: o loop começa no comando.
+ * 2. Gravando -> tocando: o comando fecha o loop; o intervalo desde o início é o comprimento.
+ * 3. Tocando -> sobrepondo: as notas tocadas ao vivo viram uma nova camada a cada volta do loop.
+ * 4. Sobrepondo -> tocando: a camada em gravação é fechada.
+ *
+ * 'u' descarta a camada mais recente, 'z' para o loop (e, se já parado, apaga tudo) e 'E' exporta
+ * o loop no formato das músicas (`songs.h`). Os modos de jogo param o loop antes de usar o buzzer.
+ *
+ * Memória: as notas ficam num anel estático de `LOOPER_CAPACITY` posições de 8 bytes, em ordem de
+ * gravação; cada camada é um trecho contíguo do anel, em ordem de tempo. Quando o anel ou a tabela
+ * de `LOOPER_MAX_LAYERS` camadas enche, a camada mais antiga é descartada; uma camada sozinha maior
+ * que o anel é truncada. Nada usa o heap, nem a exportação (vetores estáticos).
+ *
+ * Reprodução: uma intercalação das camadas (o próximo início entre os cursores de cada uma) agenda
+ * os inícios na roda de temporizadores; como no reprodutor, o fim de cada nota desliga o buzzer na
+ * IRQ e os inícios são tocados pela tarefa do looper. O tempo de cada volta é calculado a partir do
+ * início do loop em 64 bits, sem acumular erro. Uma camada não toca na volta em que é gravada (as
+ * notas acabaram de soar ao vivo).
+ *
+ * Vozes: o buzzer tem um único canal PWM, então só `LOOPER_VOICES` nota soa por vez. Notas
+ * sobrepostas de camadas diferentes roubam a voz (a mais recente vence) e notas ao vivo têm
+ * prioridade sobre as do loop, que ficam mudas enquanto uma nota ao vivo soa. A exportação aplica
+ * a mesma regra e gera uma música monofônica com os mesmos inícios.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Notas no anel (8 bytes cada).
+ */
+#define LOOPER_CAPACITY 256
+
+/**
+ * @brief Camadas simultâneas (a primeira gravação conta como camada).
+ */
+#define LOOPER_MAX_LAYERS 4
+
+/**
+ * @brief Notas que soam ao mesmo tempo: um canal PWM no buzzer.
+ */
+#define LOOPER_VOICES 1
+
+/**
+ * @brief Comprimento mínimo e máximo do loop.
+ */
+#define LOOPER_MIN_LOOP_MS 100
+#define LOOPER_MAX_LOOP_MS 600000
+
+/**
+ * @brief Entradas máximas da música exportada: cada nota pode precisar de uma pausa antes dela.
+ */
+#define LOOPER_EXPORT_MAX (2 * LOOPER_CAPACITY + 1)
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Estado do looper.
+ */
+typedef enum {
+    LOOPER_EMPTY = 0,
+    LOOPER_RECORDING,
+    LOOPER_PLAYING,
+    LOOPER_OVERDUBBING,
+    LOOPER_STOPPED,
+} looper_state_t;
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Prepara os temporizadores e registra a tarefa do looper. Requer `timer_wheel_init()`.
+ */
+void looper_init();
+
+/**
+ * @brief Avança o ciclo gravar -> tocar -> sobrepor -> tocar (comando 'e').
+ */
+void looper_advance();
+
+/**
+ * @brief Descarta a camada mais recente (comando 'u').
+ */
+void looper_undo();
+
+/**
+ * @brief Para o loop e libera o buzzer, mantendo as camadas. Uma gravação em andamento é descartada.
+ */
+void looper_stop();
+
+/**
+ * @brief Para o loop e apaga todas as camadas.
+ */
+void looper_clear();
+
+/**
+ * @brief Estado atual.
+ */
+looper_state_t looper_state();
+
+/**
+ * @brief Registra uma nota tocada ao vivo pelo reprodutor.
+ *
+ * Grava a nota se houver gravação ou sobreposição e reserva a voz para ela durante `duration_ms`.
+ * Deve ser chamada com as interrupções desligadas junto com o início do tom, para que o fim de uma
+ * nota do loop não desligue a nota ao vivo entre os dois.
+ *
+ * @param onset_us Instante de início (`start_tone_timed()`).
+ * @param freq Frequência tocada, em Hz.
+ * @param duration_ms Duração programada do som.
+ */
+void looper_note(uint32_t onset_us, uint32_t freq, uint32_t duration_ms);
+
+/**
+ * @brief Indica que a nota ao vivo foi cortada antes da duração programada (pausa do reprodutor).
+ *
+ * Devolve a voz ao loop imediatamente e, se a nota foi gravada, grava a duração que ela soou.
+ */
+void looper_note_off();
+
+/**
+ * @brief Converte o loop em uma música no formato de `songs.h`.
+ *
+ * Os vetores são estáticos e reescritos a cada chamada.
+ *
+ * @return Música com os vetores do looper, ou NULL se o loop estiver vazio.
+ */
+const Melody *looper_export();
+
+/**
+ * @brief Exporta e imprime o loop como declarações de `melody.h`.
+ */
+void looper_print_export();
+
+#endif // LOOPER_H
@@ -0,0 +1,96 @@
+#ifndef MEM_LAYOUT_H
+#define MEM_LAYOUT_H
+
+#include "pico/stdlib.h"
+#include "inc/genius_config.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file mem_layout.h
+ * @brief Posicionamento de dados nos bancos de SRAM do RP2040
+ *
+ * O RP2040 possui quatro bancos de 64 KB intercalados palavra a palavra (SRAM0-3, memória
+ * principal) e dois bancos de 4 KB (SRAM4 = SCRATCH_X e SRAM5 = SCRATCH_Y), cada um com sua
+ * própria porta no barramento. Acessos simultâneos de mestres diferentes ao mesmo banco são
+ * serializados pelo árbitro. Este arquivo define o mapa de uso dos bancos:
+ *
+ * | Banco          | Conteúdo                                                          |
+ * |----------------|-------------------------------------------------------------------|
+ * | SCRATCH_X      | Pilha do núcleo 1 (SDK, `.stack1`) e quadros do afinador           |
+ * |                | (`tuner.c` e `pitch_detect.c`, ~1,4 KB)                            |
+ * | SCRATCH_Y      | Pilha do núcleo 0 (SDK, `.stack`) e filas de toques (`simon.c`,    |
+ * |                | `rhythm.c`, ~0,3 KB)                                               |
+ * | SRAM0-3        | Buffers de DMA (blocos do afinador, calibração do joystick) e      |
+ * |                | demais dados, inclusive os maiores que cabem mal nos bancos de     |
+ * |                | rascunho (notas do looper, rastreamento de entrada)                |
+ *
+ * O quadro do detector de altura é o operando do laço mais pesado do firmware, e as filas de
+ * toques são escritas pelas ISRs: fora da memória principal, nenhum dos dois disputa banco com a
+ * DMA do afinador. O mapa padrão do SDK intercala SRAM0-3, portanto um único banco da memória
+ * principal não pode ser reservado sem substituir o script de ligação.
+ *
+ * Cada banco de rascunho tem apenas 4 KB, divididos com a pilha correspondente (2 KB por padrão);
+ * os buffers de `mem_layout_benchmark()` ocupam mais 256 bytes em cada um. O que não cabe fica na
+ * memória principal; um banco de rascunho cheio é acusado pelo ligador.
+ * Compilar com `GENIUS_MEM_LAYOUT=0` mantém todos os dados na memória principal, permitindo a
+ * comparação antes/depois com `mem_layout_benchmark()`.
+ */
+
+/******************************
+ * Macros de Posicionamento
+ ******************************/
+
+#if GENIUS_MEM_LAYOUT
+/**
+ * @brief Dados do caminho de áudio (quadros do afinador): banco SCRATCH_X.
+ *
+ * Uso: `static int16_t GENIUS_AUDIO_DATA("audio") buffer[64];`
+ */
+#define GENIUS_AUDIO_DATA(group) __scratch_x(group)
+
+/**
+ * @brief Filas de eventos pequenas, escritas por ISRs: banco SCRATCH_Y.
+ */
+#define GENIUS_RING_DATA(group) __scratch_y(group)
+#else
+#define GENIUS_AUDIO_DATA(group)
+#define GENIUS_RING_DATA(group)
+#endif
+
+/**
+ * @brief Buffers lidos ou escritos pela DMA: memória principal, alinhados à palavra.
+ *
+ * Mantido como macro para documentar o uso e permitir mover os buffers sem alterar o código.
+ */
+#define GENIUS_DMA_DATA(group) __attribute__((aligned(4)))
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Identifica o banco de SRAM de um endereço.
+ *
+ * @param addr Endereço a classificar.
+ * @return Nome do banco ("sram0-3", "scratch_x", "scratch_y" ou "flash/outro").
+ */
+const char *mem_layout_bank_name(const void *addr);
+
+/**
+ * @brief Imprime a região e o banco de cada grupo de dados do mapa de memória.
+ */
+void mem_layout_report();
+
+/**
+ * @brief Mede a contenção do caminho de áudio com a DMA ativa na memória principal.
+ *
+ * Um canal de DMA copia continuamente um buffer da memória principal enquanto o processador
+ * mistura um buffer de áudio com uma fila de eventos. São impressos o tempo do laço e os
+ * acessos disputados em cada banco. Requer `GENIUS_BUS_PROFILE`.
+ */
+void mem_layout_benchmark();
+
+#endif // MEM_LAYOUT_H
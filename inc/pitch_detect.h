@@ -0,0 +1,106 @@
+#ifndef PITCH_DETECT_H
+#define PITCH_DETECT_H
+
+#include "pico/stdlib.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file pitch_detect.h
+ * @brief Detector de altura (YIN) em ponto fixo para blocos de amostras do microfone
+ *
+ * Cada chamada analisa um quadro de `PITCH_FRAME` amostras do ADC (12 bits, ordem de tempo) a
+ * `PITCH_SAMPLE_RATE_HZ`. Etapas do YIN, todas em inteiros (o M0+ não tem FPU):
+ * 1. Remove a média do quadro e normaliza o pico para 512-1023 por deslocamento (sinais fracos
+ *    sobem, fortes descem), de modo que a função diferença cabe em 32 bits: janela de
+ *    `PITCH_WINDOW` amostras, diferença < 2^11, soma < 2^30.
+ * 2. Função diferença d(tau) = soma (x[j] - x[j + tau])^2, para tau de 1 a `PITCH_TAU_MAX` + 1:
+ *    o laço interno (`PITCH_WINDOW` x `PITCH_TAU_MAX` multiplicações de 32 bits) é quase todo o
+ *    custo do bloco.
+ * 3. Diferença normalizada pela média acumulada, d'(tau) = d(tau) * tau / soma(d(1..tau)): o
+ *    limiar é testado por multiplicação cruzada em 64 bits; a divisão só é feita nos poucos tau em
+ *    torno do mínimo escolhido.
+ * 4. O primeiro tau a partir de `PITCH_TAU_MIN` com d' abaixo de `PITCH_THRESHOLD_Q15`, seguido
+ *    até o mínimo local (evita o erro de oitava abaixo); sem nenhum, o quadro não tem nota.
+ * 5. Interpolação parabólica de d em torno do mínimo: período com 1/256 de amostra.
+ *
+ * Quadros com pico abaixo de `PITCH_MIN_LEVEL` (silêncio, ruído do ADC) não têm nota.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Taxa de amostragem do microfone.
+ */
+#define PITCH_SAMPLE_RATE_HZ 8000
+
+/**
+ * @brief Faixa detectada: `PITCH_MIN_HZ` a `PITCH_MAX_HZ` (período em amostras).
+ */
+#define PITCH_MIN_HZ 80
+#define PITCH_MAX_HZ 1000
+#define PITCH_TAU_MIN (PITCH_SAMPLE_RATE_HZ / PITCH_MAX_HZ)
+#define PITCH_TAU_MAX (PITCH_SAMPLE_RATE_HZ / PITCH_MIN_HZ)
+
+/**
+ * @brief Janela da função diferença e tamanho do quadro analisado.
+ */
+#define PITCH_WINDOW 256
+#define PITCH_FRAME (PITCH_WINDOW + PITCH_TAU_MAX + 1)
+
+/**
+ * @brief Limiar do YIN para d'(tau), em Q15 (0,15).
+ */
+#define PITCH_THRESHOLD_Q15 4915
+
+/**
+ * @brief Pico mínimo, em LSB do ADC, depois de remover a média.
+ */
+#define PITCH_MIN_LEVEL 24
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Resultado da análise de um quadro.
+ */
+typedef struct {
+    bool voiced;                // Há uma nota no quadro
+    uint32_t freq_q4;           // Frequência em Hz (Q4)
+    uint16_t aperiodicity_q15;  // d' no mínimo (0 = periódico perfeito)
+    uint16_t peak;              // Pico do quadro sem a média, em LSB
+} pitch_result_t;
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Analisa um quadro.
+ *
+ * @param frame `PITCH_FRAME` conversões do ADC, da mais antiga para a mais recente.
+ * @param result Recebe o resultado.
+ * @return `result->voiced`.
+ */
+bool pitch_detect(const uint16_t *frame, pitch_result_t *result);
+
+/**
+ * @brief Nota temperada mais próxima de uma frequência (lá 4 = 440 Hz).
+ *
+ * @param freq_q4 Frequência em Hz (Q4), maior que 0.
+ * @param cents Recebe o desvio em centésimos de semitom (-50 a +50; positivo = acima).
+ * @return Número MIDI da nota (69 = lá 4).
+ */
+int pitch_nearest_note(uint32_t freq_q4, int *cents);
+
+/**
+ * @brief Nome de uma nota MIDI sem a oitava ("C", "C#", ..., "B").
+ */
+const char *pitch_note_name(int midi);
+
+#endif // PITCH_DETECT_H
@@ -0,0 +1,135 @@
+#ifndef RHYTHM_H
+#define RHYTHM_H
+
+#include "pico/stdlib.h"
+#include "inc/board.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file rhythm.h
+ * @brief Modo de acompanhamento: o jogador toca o botão A junto com cada nota da música
+ *
+ * Uma rodada toca a música selecionada do início ao fim pelo reprodutor normal. Cada toque em A é
+ * comparado com o início da nota mais próxima e pontuado pela diferença (positiva = atrasado):
+ * - Até `RHYTHM_PERFECT_US`: perfeito (3 pontos); até `RHYTHM_GOOD_US`: bom (2); até
+ *   `RHYTHM_WINDOW_US`: ok (1).
+ * - Nota sem toque dentro da janela: perdida. Toque sem nota dentro da janela: extra.
+ *
+ * Os dois lados da diferença são marcas de tempo de hardware, não da tarefa que os trata:
+ * 1. Nota: instante devolvido por `start_tone_timed()` no sequenciador, o wrap do PWM em que o
+ *    tom realmente começa no pino (até um período da nota anterior depois da escrita, ~2,5 ms em
+ *    392 Hz, que sem correção pesaria mais que a tolerância de 1 ms).
+ * 2. Toque: instante de entrada do `gpio_irq_handler` (`gpio_irq_manager_edge_time_us()`).
+ *
+ * A calibração (`rhythm_calibrate()`) mede o que sobra entre essas marcas e os pinos e passa a
+ * descontar as médias:
+ * 1. Entrada: o pino `RHYTHM_CAL_PIN` estimula a si mesmo (como em `gpio_latency.h`), pelo mesmo
+ *    `gpio_irq_handler` dos botões; mede-se da inversão até a marca de tempo da borda.
+ * 2. Saída: tons de frequências variadas são ligados em fases aleatórias do período anterior e o
+ *    próprio `BUZZER_PIN` é lido pelo SIO (a entrada do pino continua ativa com a função PWM) até o
+ *    primeiro nível alto; mede-se o erro da previsão de `start_tone_timed()`. O relatório também
+ *    mostra a latência sem a previsão, que é o erro de quem usa o instante da escrita.
+ *
+ * A resposta mecânica do buzzer e a do dedo do jogador não entram: são iguais em todas as notas e
+ * aparecem como o atraso médio do relatório da rodada.
+ *
+ * O casamento de toques e notas é feito pela tarefa do modo, em ordem de tempo, quando a janela
+ * de cada evento já se fechou; o resultado de cada toque sai `RHYTHM_WINDOW_US` depois dele.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Faixas de pontuação pela diferença absoluta entre toque e nota.
+ */
+#define RHYTHM_PERFECT_US 20000
+#define RHYTHM_GOOD_US 50000
+#define RHYTHM_WINDOW_US 150000
+
+/**
+ * @brief Notas e toques aguardando o casamento.
+ */
+#define RHYTHM_QUEUE_SIZE 32
+
+/**
+ * @brief Período da tarefa do modo durante uma rodada.
+ */
+#define RHYTHM_POLL_MS 10
+
+/**
+ * @brief Pino estimulado na calibração da entrada (o mesmo de `gpio_latency.h`).
+ */
+#define RHYTHM_CAL_PIN IRQ_BENCH_LOAD_PIN
+
+/**
+ * @brief Amostras da calibração: bordas de entrada e tons de saída.
+ */
+#define RHYTHM_CAL_EDGES 256
+#define RHYTHM_CAL_TONES 48
+
+/**
+ * @brief Espera máxima por uma borda ou pelo primeiro pulso de um tom.
+ */
+#define RHYTHM_CAL_TIMEOUT_US 70000
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Registra a tarefa do modo. Requer `timer_wheel_init()`.
+ */
+void rhythm_init();
+
+/**
+ * @brief Começa uma rodada. O chamador inicia a música logo em seguida.
+ */
+void rhythm_start();
+
+/**
+ * @brief Indica o fim da música (ou a pausa). A rodada é pontuada depois da última janela e o
+ * modo termina.
+ */
+void rhythm_song_end();
+
+/**
+ * @brief Indica se há uma rodada em andamento (o botão A pertence ao modo).
+ */
+bool rhythm_active();
+
+/**
+ * @brief Registra o início de uma nota.
+ *
+ * @param onset_us Instante devolvido por `start_tone_timed()`.
+ */
+void rhythm_onset(uint32_t onset_us);
+
+/**
+ * @brief Registra um toque no botão A. Pode ser chamada de ISRs.
+ *
+ * @param time_us Instante da borda (`gpio_irq_manager_edge_time_us()`).
+ */
+void rhythm_press(uint32_t time_us);
+
+/**
+ * @brief Passa a descontar as latências medidas por `rhythm_calibrate()`.
+ *
+ * @param input_us Da borda no pino à marca de tempo do `gpio_irq_handler`.
+ * @param output_us Da previsão de `start_tone_timed()` ao primeiro pulso no pino.
+ */
+void rhythm_set_compensation(int32_t input_us, int32_t output_us);
+
+/**
+ * @brief Mede as latências de entrada e de saída, imprime o resultado e passa a descontá-las.
+ *
+ * Bloqueia por cerca de 1 s e usa o buzzer: o reprodutor deve estar parado. Nada deve estar
+ * conectado a `RHYTHM_CAL_PIN`.
+ */
+void rhythm_calibrate();
+
+#endif // RHYTHM_H
@@ -0,0 +1,110 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "pico/stdlib.h"
+#include "inc/timer_wheel.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file scheduler.h
+ * @brief Escalonador cooperativo de tarefas com alocação estática
+ *
+ * Substitui o laço principal que chamava todos os subsistemas a cada volta. Cada tarefa é uma
+ * função que roda até o fim (sem preempção entre tarefas) e só é executada quando está pronta:
+ * 1. Periódica: um temporizador de `timer_wheel.h` a torna pronta a cada `period_ms`.
+ * 2. Por evento: ISRs e outras tarefas chamam `scheduler_signal()`.
+ *
+ * Entre as tarefas prontas roda a de maior prioridade (menor número). Sem tarefas prontas o
+ * núcleo dorme em `__wfe()` até a próxima interrupção.
+ *
+ * Para cada tarefa são contabilizados execuções, tempo de execução (médio e máximo) e o pior
+ * tempo de resposta (WCRT): do instante em que ficou pronta até o fim da execução, incluindo a
+ * espera por tarefas de maior prioridade e pela tarefa que estava em execução.
+ *
+ * O escalonador define o contexto do rastreador de heap (`HEAP_CONTEXT`) com o nome da tarefa.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Número máximo de tarefas registradas.
+ */
+#define SCHED_MAX_TASKS 12
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Tarefa do escalonador. Deve ser inicializada com `scheduler_task_init()`.
+ */
+typedef struct {
+    const char *name;            // Nome exibido no relatório e usado como contexto do heap
+    void (*run)(void);           // Função executada a cada ativação
+    uint8_t priority;            // 0 = maior prioridade
+    uint32_t period_ms;          // 0 = somente por evento
+    timer_wheel_timer_t timer;   // Ativação periódica
+    volatile bool ready;         // Pronta para executar
+    uint32_t release_us;         // Instante em que ficou pronta
+    uint32_t runs;               // Execuções
+    uint64_t total_us;           // Tempo total de execução
+    uint32_t max_exec_us;        // Maior tempo de execução
+    uint32_t wcrt_us;            // Pior tempo de resposta
+} scheduler_task_t;
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Prepara uma tarefa.
+ *
+ * @param task Tarefa a inicializar.
+ * @param name Nome da tarefa.
+ * @param run Função executada a cada ativação.
+ * @param priority Prioridade (0 = maior).
+ * @param period_ms Período em milissegundos, ou 0 para tarefas só por evento.
+ */
+void scheduler_task_init(scheduler_task_t *task, const char *name, void (*run)(void),
+                         uint8_t priority, uint32_t period_ms);
+
+/**
+ * @brief Registra uma tarefa e, se for periódica, arma sua primeira ativação.
+ *
+ * Com a tabela cheia causa `panic()`: uma tarefa que não entra nunca executaria, sem aviso.
+ *
+ * @param task Tarefa inicializada.
+ */
+void scheduler_add(scheduler_task_t *task);
+
+/**
+ * @brief Torna uma tarefa pronta. Pode ser chamada de ISRs.
+ *
+ * @param task Tarefa a ativar.
+ */
+void scheduler_signal(scheduler_task_t *task);
+
+/**
+ * @brief Executa as tarefas prontas para sempre.
+ */
+void scheduler_run();
+
+/**
+ * @brief Obtém uma tarefa registrada, em ordem de prioridade.
+ *
+ * @param index Posição na tabela (0 = maior prioridade).
+ * @return Tarefa, ou NULL se `index` passar do número de tarefas registradas.
+ */
+const scheduler_task_t *scheduler_task_at(uint index);
+
+/**
+ * @brief Imprime execuções, tempos de execução, WCRT e ocupação da CPU de cada tarefa.
+ */
+void scheduler_report();
+
+#endif // SCHEDULER_H
@@ -0,0 +1,139 @@
+#ifndef SIMON_H
+#define SIMON_H
+
+#include "pico/stdlib.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file simon.h
+ * @brief Modo de jogo Genius (Simon) com tempo de reação em microssegundos
+ *
+ * A cada rodada o jogo acrescenta um passo aleatório à sequência, toca a sequência inteira no
+ * buzzer e espera o jogador repeti-la. São quatro símbolos, cada um com seu tom:
+ * - Botão A (415 Hz), botão B (310 Hz), joystick à esquerda (252 Hz) e à direita (209 Hz).
+ *
+ * Um erro ou `SIMON_TIMEOUT_MS` sem resposta encerra o jogo com um tom grave; o toque seguinte
+ * começa outro jogo.
+ *
+ * Implementação:
+ * 1. Sequência: 2 bits por passo em um vetor estático (`SIMON_MAX_STEPS` passos em
+ *    `SIMON_MAX_STEPS / 4` bytes).
+ * 2. Deixas: tocadas sem bloquear, como as notas do reprodutor: um temporizador da roda desliga
+ *    cada tom na IRQ e, depois do silêncio, a tarefa do jogo liga o próximo. O tom de cada passo
+ *    encurta com o avanço das rodadas, como no jogo original.
+ * 3. Entrada: os botões chegam com o instante de entrada do `gpio_irq_handler`
+ *    (`gpio_irq_manager_edge_time_us()`); o joystick é amostrado a cada `SIMON_POLL_MS` pela
+ *    tarefa do jogo, com histerese (precisa voltar ao centro entre dois movimentos), e o instante
+ *    é o da amostra. Os toques vão para uma fila e são validados em ordem pelo instante, então a
+ *    latência da tarefa não altera nem o resultado nem o tempo medido.
+ * 4. Reação: do fim do último tom da deixa até o primeiro toque e, depois, entre toques
+ *    consecutivos. Toques antes do fim da deixa são ignorados.
+ *
+ * Ao fim de cada rodada são impressos o mínimo, a média e o máximo da reação; no fim do jogo,
+ * os mesmos valores para o jogo inteiro e o recorde de rodadas.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Passos máximos de uma sequência (2 bits cada).
+ */
+#define SIMON_MAX_STEPS 4096
+
+/**
+ * @brief Duração do tom de cada passo da deixa: até a 5ª rodada, até a 13ª e depois.
+ */
+#define SIMON_CUE_SLOW_MS 420
+#define SIMON_CUE_MEDIUM_MS 320
+#define SIMON_CUE_FAST_MS 220
+
+/**
+ * @brief Silêncio entre os passos da deixa.
+ */
+#define SIMON_CUE_GAP_MS 50
+
+/**
+ * @brief Duração do tom de confirmação de cada toque do jogador.
+ */
+#define SIMON_FEEDBACK_MS 150
+
+/**
+ * @brief Espera máxima por cada toque do jogador.
+ */
+#define SIMON_TIMEOUT_MS 3000
+
+/**
+ * @brief Espera entre o entrar no modo (ou o fim de uma rodada) e a próxima deixa.
+ */
+#define SIMON_ROUND_PAUSE_MS 800
+
+/**
+ * @brief Tom e duração do fim de jogo.
+ */
+#define SIMON_FAIL_HZ 42
+#define SIMON_FAIL_MS 1500
+
+/**
+ * @brief Período de amostragem do joystick durante o jogo.
+ */
+#define SIMON_POLL_MS 2
+
+/**
+ * @brief Limiares do eixo X: movimento para a esquerda, para a direita e faixa do centro.
+ */
+#define SIMON_JOY_LEFT 1024
+#define SIMON_JOY_RIGHT 3072
+#define SIMON_JOY_CENTER_BAND 512
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Símbolos do jogo (2 bits).
+ */
+typedef enum {
+    SIMON_A = 0,
+    SIMON_B,
+    SIMON_LEFT,
+    SIMON_RIGHT,
+} simon_symbol_t;
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Prepara os temporizadores e registra a tarefa do jogo. Requer `timer_wheel_init()`.
+ */
+void simon_init();
+
+/**
+ * @brief Entra no modo de jogo e começa um jogo. O buzzer deve estar livre.
+ */
+void simon_start();
+
+/**
+ * @brief Sai do modo de jogo e libera o buzzer.
+ */
+void simon_stop();
+
+/**
+ * @brief Indica se o modo de jogo está ativo (os botões pertencem ao jogo).
+ */
+bool simon_active();
+
+/**
+ * @brief Entrega um toque do jogador. Pode ser chamada de ISRs.
+ *
+ * @param symbol Símbolo tocado.
+ * @param time_us Instante do toque (`time_us_32()`).
+ */
+void simon_press(simon_symbol_t symbol, uint32_t time_us);
+
+#endif // SIMON_H
@@ -0,0 +1,53 @@
+#ifndef SONGS_H
+#define SONGS_H
+
+#include "pico/stdlib.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file songs.h
+ * @brief Tabela das músicas tocadas pelo instrumento
+ *
+ * As notas e durações vêm de `melody.h`, que define os vetores e por isso só é incluído por
+ * `songs.c`. Os demais módulos (reprodutor, simulação) usam a tabela `melodies` declarada aqui.
+ *
+ * Cada nota soa por `durations[i]` ms e é seguida de um silêncio de mesma duração; frequência 0 é
+ * uma pausa de `2 * durations[i]` ms.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Número de músicas em `melodies`.
+ */
+#define SONG_COUNT 3
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Uma música: frequências (Hz, 0 = pausa) e durações (ms) de cada nota.
+ */
+typedef struct {
+    int *melody;
+    int *durations;
+    int length;
+    const char *name;
+} Melody;
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+/**
+ * @brief Músicas selecionáveis pelo botão A, na ordem de seleção.
+ */
+extern const Melody melodies[SONG_COUNT];
+
+#endif // SONGS_H
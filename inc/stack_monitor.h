@@ -0,0 +1,83 @@
+#ifndef STACK_MONITOR_H
+#define STACK_MONITOR_H
+
+#include "pico/stdlib.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file stack_monitor.h
+ * @brief Marca d'água máxima das pilhas dos dois núcleos
+ *
+ * Na inicialização as regiões de pilha são preenchidas com um padrão conhecido ("pintura").
+ * Em qualquer momento, a quantidade de palavras que ainda contém o padrão a partir do fundo da
+ * pilha indica a folga mínima já observada, ou seja, a marca d'água máxima de uso.
+ *
+ * No Cortex-M0+ as interrupções usam a pilha principal (MSP) do núcleo em que ocorrem. No
+ * núcleo 0 essa é a mesma pilha do laço principal: o valor medido para o núcleo 0 já inclui
+ * o aninhamento de ISRs, que é a "pilha de IRQ" do sistema.
+ *
+ * Funcionalidades:
+ * 1. Pintura das pilhas do núcleo 0 (SCRATCH_Y) e do núcleo 1 (SCRATCH_X).
+ * 2. Consulta em tempo de execução da marca d'água de cada pilha.
+ * 3. Relatório com tamanho, uso máximo e folga.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Padrão usado para pintar as pilhas.
+ */
+#define STACK_PAINT_PATTERN 0xC0DEC0DEu
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Pilhas monitoradas.
+ */
+typedef enum {
+    STACK_CORE0 = 0,  // Núcleo 0: laço principal e todas as ISRs do núcleo 0
+    STACK_CORE1,      // Núcleo 1 (vazia enquanto o núcleo 1 não for usado)
+    STACK_COUNT
+} stack_id_t;
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Pinta as regiões de pilha livres.
+ *
+ * Deve ser a primeira chamada de `main()` e preceder `multicore_launch_core1()`, pois a pilha do
+ * núcleo 1 é pintada por inteiro.
+ */
+void stack_monitor_init();
+
+/**
+ * @brief Obtém o tamanho total de uma pilha.
+ *
+ * @param id Pilha desejada.
+ * @return Tamanho em bytes (0 se a pilha não existir no mapa de memória).
+ */
+uint32_t stack_monitor_size(stack_id_t id);
+
+/**
+ * @brief Obtém a marca d'água máxima de uso de uma pilha.
+ *
+ * @param id Pilha desejada.
+ * @return Maior quantidade de bytes já usada desde a pintura.
+ */
+uint32_t stack_monitor_high_water(stack_id_t id);
+
+/**
+ * @brief Imprime tamanho, uso máximo e folga de cada pilha.
+ */
+void stack_monitor_report();
+
+#endif // STACK_MONITOR_H
@@ -0,0 +1,103 @@
+#ifndef THEREMIN_H
+#define THEREMIN_H
+
+#include "pico/stdlib.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file theremin.h
+ * @brief Modo teremim: o eixo X do joystick controla continuamente a altura de um tom
+ *
+ * Enquanto o botão do joystick (`JOYSTICK_BUTTON_PIN`) estiver pressionado o buzzer soa sem
+ * parar, com a frequência seguindo o eixo X em escala exponencial (`THEREMIN_OCTAVES` oitavas a
+ * partir de `THEREMIN_LOW_HZ`, como as notas de um instrumento); solto, o buzzer silencia.
+ *
+ * Laço de controle, a cada `THEREMIN_PERIOD_MS`:
+ * 1. Um temporizador periódico da roda sinaliza a tarefa do modo, que lê o joystick (eixo X e
+ *    botão) pelo `joystickPi_read()` (o ADC só é usado por tarefas, nunca por ISRs).
+ * 2. Filtro: passa-baixas de um polo em ponto fixo, `y += (x - y) >> THEREMIN_FILTER_SHIFT`,
+ *    depois da calibração do joystick. O botão só muda o estado depois de
+ *    `THEREMIN_GATE_DEBOUNCE_MS` leituras iguais seguidas.
+ * 3. Altura: período do PWM em tiques de `CLK_DIV_DEFAULT`, por uma tabela de 2^(-i/16) com
+ *    interpolação linear (erro abaixo de 0,5 cent, sem ponto flutuante).
+ * 4. Escrita: TOP e CC são registradores duplos, copiados no wrap do contador. Escritos pela
+ *    tarefa, um wrap entre os dois tocaria um período com o TOP novo e o CC antigo (um pulso de
+ *    largura errada, audível como um estalo). Por isso a tarefa só publica os valores novos e
+ *    habilita a IRQ de wrap do slice; a ISR (`PWM_IRQ_WRAP`, prioridade de áudio) escreve os dois
+ *    logo depois de um wrap, com um período inteiro de folga, e desabilita a IRQ até a próxima
+ *    publicação. Os valores passam a valer juntos no wrap seguinte.
+ *
+ * Latência movimento -> som: um evento começa na leitura em que o eixo X se afasta mais de
+ * `THEREMIN_MOTION_THRESHOLD` da referência e termina no wrap em que passa a soar um período
+ * calculado com o filtro já além da metade do degrau. O limite é a soma de:
+ * - até um intervalo de amostragem entre o movimento e a leitura (mais o atraso da tarefa);
+ * - as amostras que o filtro leva para passar da metade de um degrau;
+ * - até dois períodos do tom: a espera pelo próximo wrap (ISR) e o wrap em que os valores valem.
+ * Ao sair do modo é impresso o limite ao lado da latência medida (mínimo, média e máximo, e os
+ * estágios), do intervalo real entre leituras e das escritas que cruzaram um wrap (devem ser 0).
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Período do laço de controle.
+ */
+#define THEREMIN_PERIOD_MS 1
+
+/**
+ * @brief Frequência com o eixo X no mínimo e extensão em oitavas até o máximo.
+ */
+#define THEREMIN_LOW_HZ 131
+#define THEREMIN_OCTAVES 3
+
+/**
+ * @brief Filtro do eixo X: constante de tempo de ~2^n amostras.
+ */
+#define THEREMIN_FILTER_SHIFT 2
+
+/**
+ * @brief Leituras iguais seguidas do botão para ligar ou desligar o som.
+ */
+#define THEREMIN_GATE_DEBOUNCE_MS 5
+
+/**
+ * @brief Diferença mínima no eixo X (de 0 a 4095) que abre um evento de latência.
+ */
+#define THEREMIN_MOTION_THRESHOLD 64
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Prepara o temporizador e a ISR de wrap e registra a tarefa do modo. Requer
+ * `timer_wheel_init()`.
+ */
+void theremin_init();
+
+/**
+ * @brief Entra no modo. O buzzer deve estar livre (reprodutor, looper e jogos parados).
+ */
+void theremin_start();
+
+/**
+ * @brief Sai do modo, silencia o buzzer e imprime o relatório de latência.
+ */
+void theremin_stop();
+
+/**
+ * @brief Indica se o modo está ativo (o buzzer e o joystick pertencem a ele).
+ */
+bool theremin_active();
+
+/**
+ * @brief Frequência atual do tom, em Hz (0 com o som desligado).
+ */
+uint32_t theremin_freq_hz();
+
+#endif // THEREMIN_H
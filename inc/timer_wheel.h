@@ -0,0 +1,136 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include "pico/stdlib.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file timer_wheel.h
+ * @brief Serviço de temporizadores por software sobre um único alarme de hardware
+ *
+ * Multiplexa qualquer quantidade de timeouts (debounce, fim de nota, ticks de status, gestos,
+ * envelopes) em um alarme de hardware, usando uma roda de temporização hierárquica com 4 níveis
+ * de 64 posições e resolução de 1 ms:
+ *
+ * | Nível | Resolução | Alcance      |
+ * |-------|-----------|--------------|
+ * | 0     | 1 ms      | 64 ms        |
+ * | 1     | 64 ms     | 4,1 s        |
+ * | 2     | 4,1 s     | 4,4 min      |
+ * | 3     | 4,4 min   | 4,7 h        |
+ *
+ * Inserção e cancelamento são O(1): cada temporizador é um nó de lista duplamente encadeada
+ * alocado pelo chamador (sem heap). Ao virar uma posição do nível 0 os temporizadores do nível
+ * superior descem ("cascata"). O alarme de hardware só é programado para o próximo instante em
+ * que há algo a fazer, e fica desligado quando a roda está vazia.
+ *
+ * Os callbacks executam no contexto da interrupção do alarme (prioridade `IRQ_PRIORITY_TIMING`):
+ * devem ser curtos e, em geral, apenas sinalizar o laço principal. Um callback pode rearmar o
+ * próprio temporizador (temporizadores periódicos).
+ */
+
+/******************************
+ * Estruturas
+ ******************************/
+
+typedef struct timer_wheel_timer timer_wheel_timer_t;
+
+/**
+ * @brief Função chamada quando um temporizador expira.
+ *
+ * @param timer Temporizador que expirou (já fora da roda).
+ */
+typedef void (*timer_wheel_callback_t)(timer_wheel_timer_t *timer);
+
+/**
+ * @brief Temporizador por software. Deve ser inicializado com `timer_wheel_timer_init()`.
+ */
+struct timer_wheel_timer {
+    timer_wheel_timer_t *next;        // Próximo na mesma posição da roda
+    timer_wheel_timer_t *prev;        // Anterior na mesma posição da roda
+    uint32_t expires;                 // Tick (ms) absoluto de expiração
+    timer_wheel_callback_t callback;  // Função chamada na expiração
+    void *user_data;                  // Dado livre do usuário
+    uint8_t level;                    // Nível atual na roda
+    uint8_t slot;                     // Posição atual no nível
+    volatile bool pending;            // true enquanto estiver na roda
+};
+
+/**
+ * @brief Contadores da roda (os mesmos do relatório).
+ */
+typedef struct {
+    uint32_t active;        // Temporizadores armados
+    uint32_t wakeups;       // Execuções da interrupção do alarme
+    uint32_t expirations;   // Callbacks executados
+} timer_wheel_stats_t;
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Inicializa a roda e reserva um alarme de hardware livre.
+ */
+void timer_wheel_init();
+
+/**
+ * @brief Prepara um temporizador para uso.
+ *
+ * @param timer Temporizador a inicializar.
+ * @param callback Função chamada na expiração.
+ * @param user_data Dado livre disponível no callback.
+ */
+void timer_wheel_timer_init(timer_wheel_timer_t *timer, timer_wheel_callback_t callback, void *user_data);
+
+/**
+ * @brief Arma (ou rearma) um temporizador para expirar após `delay_ms`.
+ *
+ * Se o temporizador já estiver armado, o prazo anterior é descartado. Atrasos de 0 ms expiram
+ * no próximo tick.
+ *
+ * @param timer Temporizador.
+ * @param delay_ms Atraso em milissegundos.
+ */
+void timer_wheel_start(timer_wheel_timer_t *timer, uint32_t delay_ms);
+
+/**
+ * @brief Desarma um temporizador. Não faz nada se ele não estiver armado.
+ *
+ * @param timer Temporizador.
+ */
+void timer_wheel_cancel(timer_wheel_timer_t *timer);
+
+/**
+ * @brief Indica se um temporizador está armado.
+ *
+ * @param timer Temporizador.
+ * @return true se ainda não expirou nem foi cancelado.
+ */
+static inline bool timer_wheel_pending(const timer_wheel_timer_t *timer) {
+    return timer->pending;
+}
+
+/**
+ * @brief Obtém o tick atual (milissegundos desde a partida do temporizador).
+ *
+ * @return Tick atual.
+ */
+uint32_t timer_wheel_now();
+
+/**
+ * @brief Obtém os contadores da roda.
+ *
+ * @return Temporizadores ativos, despertares do alarme e expirações.
+ */
+timer_wheel_stats_t timer_wheel_stats();
+
+/**
+ * @brief Imprime temporizadores ativos, despertares do alarme e expirações.
+ */
+void timer_wheel_report();
+
+#endif // TIMER_WHEEL_H
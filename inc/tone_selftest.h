@@ -0,0 +1,68 @@
+#ifndef TONE_SELFTEST_H
+#define TONE_SELFTEST_H
+
+#include "pico/stdlib.h"
+#include "inc/board.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file tone_selftest.h
+ * @brief Autoteste da frequência real gerada pelo buzzer
+ *
+ * Cada nota é ligada no buzzer com `start_tone()` (o mesmo caminho do player) e a saída é medida
+ * por um slice PWM livre em modo de contagem: o canal B do slice de `FREQ_COUNT_PIN` conta as
+ * bordas de subida do sinal, ligado ao `BUZZER_PIN` por um fio (o RP2040 não encaminha a saída
+ * de um slice para a entrada de outro internamente).
+ *
+ * A frequência é obtida por contagem recíproca: o tempo de um número inteiro de períodos dentro
+ * da janela `TONE_SELFTEST_GATE_MS`, medido pelo temporizador de 1 MHz, o que dá resolução de
+ * centésimos de cent mesmo em notas graves. Para cada nota são informados:
+ * 1. O valor de wrap calculado por `calculate_wrap()`.
+ * 2. A frequência teórica desse wrap e seu erro em cents (truncamento e limite de 65535).
+ * 3. A frequência medida e seu erro em cents em relação à nota pedida.
+ *
+ * Sem o fio, nenhuma borda é contada e o teste informa a ligação necessária.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Janela de medição de cada nota.
+ */
+#define TONE_SELFTEST_GATE_MS 200
+
+/**
+ * @brief Tempo de acomodação após ligar cada nota.
+ */
+#define TONE_SELFTEST_SETTLE_MS 5
+
+/**
+ * @brief Tempo sem bordas após o qual a medição é abandonada.
+ */
+#define TONE_SELFTEST_TIMEOUT_MS 50
+
+/**
+ * @brief Tamanho máximo da tabela de notas distintas.
+ */
+#define TONE_SELFTEST_MAX_NOTES 64
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Mede cada frequência da tabela no buzzer e imprime o erro em cents.
+ *
+ * O buzzer é usado diretamente: o player deve estar parado.
+ *
+ * @param freqs Frequências das notas em Hz (valores 0 são ignorados).
+ * @param count Número de frequências.
+ */
+void tone_selftest_run(const uint32_t *freqs, uint count);
+
+#endif // TONE_SELFTEST_H
@@ -0,0 +1,85 @@
+#ifndef TUNER_H
+#define TUNER_H
+
+#include "pico/stdlib.h"
+#include "inc/pitch_detect.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file tuner.h
+ * @brief Afinador: altura do microfone (`MIC_PIN`) em tempo real, com o joystick no mesmo ADC
+ *
+ * Captura: o ADC converte sem parar, alternando entre os eixos do joystick e o microfone
+ * (`TUNER_CHANNELS` x `PITCH_SAMPLE_RATE_HZ` conversões por segundo), e a FIFO alimenta dois canais
+ * de DMA encadeados em pingue-pongue: enquanto um enche o seu bloco de `TUNER_HOP` conversões por
+ * canal, o outro bloco fica parado para a tarefa. Ao fim de cada bloco a ISR da DMA (`DMA_IRQ_0`,
+ * prioridade de áudio) rearma o canal e sinaliza a tarefa do afinador; nenhuma conversão passa pela
+ * CPU.
+ *
+ * Por bloco, a tarefa:
+ * 1. Separa as amostras do microfone e desliza o quadro do detector (`PITCH_FRAME` amostras) em
+ *    `TUNER_HOP` amostras.
+ * 2. Passa ao joystick a média das últimas `TUNER_JOYSTICK_AVG` conversões de cada eixo
+ *    (`joystickPi_stream_push()`): enquanto o afinador está ativo, `joystickPi_read()` não usa o
+ *    ADC.
+ * 3. Roda `pitch_detect()` sobre o quadro e publica a nota.
+ *
+ * Orçamento de tempo real: a tarefa precisa terminar um bloco antes que a DMA volte a escrever
+ * nele, ou seja, em `TUNER_HOP` / `PITCH_SAMPLE_RATE_HZ` (16 ms). O custo de cada bloco é medido
+ * em ciclos do processador pelo SysTick e, ao sair, é impresso (mínimo, média e máximo) como
+ * fração do orçamento, junto com os blocos perdidos (a DMA completou mais de um bloco entre duas
+ * execuções da tarefa).
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Canais alternados pelo ADC: eixo X, eixo Y e microfone.
+ */
+#define TUNER_CHANNELS 3
+
+/**
+ * @brief Conversões por canal em cada bloco da DMA (avanço do quadro do detector).
+ */
+#define TUNER_HOP 128
+
+/**
+ * @brief Conversões de cada eixo médias para o joystick, por bloco.
+ */
+#define TUNER_JOYSTICK_AVG 16
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Prepara o pino do microfone, os canais de DMA e a ISR e registra a tarefa do afinador.
+ */
+void tuner_init();
+
+/**
+ * @brief Liga a captura, se o ADC estiver livre (`joystickPi_adc_claim()`).
+ */
+void tuner_start();
+
+/**
+ * @brief Desliga a captura, devolve o ADC ao joystick e imprime o relatório de ciclos por bloco.
+ */
+void tuner_stop();
+
+/**
+ * @brief Indica se o afinador está ativo (o ADC pertence a ele).
+ */
+bool tuner_active();
+
+/**
+ * @brief Resultado do último quadro analisado.
+ */
+pitch_result_t tuner_result();
+
+#endif // TUNER_H
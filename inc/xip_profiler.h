@@ -0,0 +1,112 @@
+#ifndef XIP_PROFILER_H
+#define XIP_PROFILER_H
+
+#include "pico/stdlib.h"
+#include "inc/genius_config.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file xip_profiler.h
+ * @brief Medição da taxa de acerto do cache XIP por subsistema
+ *
+ * O RP2040 executa o código da flash através de um cache XIP de 16 KB. Cada falta no cache
+ * custa alguns microssegundos, o que é crítico dentro de uma ISR. Este módulo lê os contadores
+ * de acerto (CTR_HIT) e de acesso (CTR_ACC) do bloco XIP_CTRL antes e depois de cada subsistema,
+ * acumulando também o tempo de execução de cada trecho.
+ *
+ * Funcionalidades:
+ * 1. Marcação de início e fim de cada subsistema instrumentado.
+ * 2. Acúmulo de acertos, acessos, chamadas e tempo (médio e máximo) por subsistema.
+ * 3. Descarte do cache para medir o pior caso (cache frio).
+ * 4. Relatório em texto pela saída padrão.
+ *
+ * Os contadores do XIP são globais: um trecho interrompido por uma ISR também contabiliza os
+ * acessos da ISR. As macros `XIP_PROFILE_BEGIN`/`XIP_PROFILE_END` não geram código quando
+ * `GENIUS_XIP_PROFILE` é 0.
+ */
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Subsistemas instrumentados.
+ */
+typedef enum {
+    XIP_PROF_IRQ = 0,   // Tratamento de interrupções GPIO
+    XIP_PROF_INPUT,     // Tratamento dos botões (handle_input)
+    XIP_PROF_SOUND,     // Sequenciador e motor de áudio (update_sound)
+    XIP_PROF_STATUS,    // Formatação do status (show_status)
+    XIP_PROF_COUNT
+} xip_prof_section_t;
+
+/**
+ * @brief Estatísticas acumuladas de um subsistema.
+ */
+typedef struct {
+    uint32_t calls;      // Número de execuções medidas
+    uint32_t hits;       // Acertos no cache XIP
+    uint32_t accesses;   // Acessos totais ao XIP (acertos + faltas)
+    uint64_t total_us;   // Tempo total de execução em microssegundos
+    uint32_t max_us;     // Maior tempo de uma execução
+} xip_prof_stats_t;
+
+/******************************
+ * Macros de Instrumentação
+ ******************************/
+
+#if GENIUS_XIP_PROFILE
+#define XIP_PROFILE_BEGIN(section) xip_profiler_begin(section)
+#define XIP_PROFILE_END(section) xip_profiler_end(section)
+#else
+#define XIP_PROFILE_BEGIN(section) ((void)0)
+#define XIP_PROFILE_END(section) ((void)0)
+#endif
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Zera os contadores de hardware e as estatísticas acumuladas.
+ */
+void xip_profiler_init();
+
+/**
+ * @brief Marca o início da execução de um subsistema.
+ *
+ * @param section Subsistema instrumentado.
+ */
+void xip_profiler_begin(xip_prof_section_t section);
+
+/**
+ * @brief Marca o fim da execução de um subsistema e acumula as diferenças dos contadores.
+ *
+ * @param section Subsistema instrumentado.
+ */
+void xip_profiler_end(xip_prof_section_t section);
+
+/**
+ * @brief Obtém as estatísticas acumuladas de um subsistema.
+ *
+ * @param section Subsistema desejado.
+ * @return Ponteiro para as estatísticas (somente leitura).
+ */
+const xip_prof_stats_t *xip_profiler_get(xip_prof_section_t section);
+
+/**
+ * @brief Invalida todo o cache XIP, forçando faltas na próxima execução de cada trecho.
+ *
+ * Útil para medir a latência de pior caso (cache frio) dos caminhos críticos.
+ */
+void xip_profiler_flush_cache();
+
+/**
+ * @brief Imprime o relatório de todos os subsistemas e reinicia as estatísticas.
+ */
+void xip_profiler_report();
+
+#endif // XIP_PROFILER_H
@@ -0,0 +1,38 @@
+# Executa um roteiro de referência e compara o áudio e a tabela de notas com os arquivos em
+# sim/golden. Uso (registrado pelo sim/CMakeLists.txt):
+#
+#   cmake -DSIM=<GENIUS_sim> -DSCRIPT=<roteiro.txt> -DOUT=<dir> [-DUPDATE=ON] -P golden_check.cmake
+#
+# Com UPDATE=ON as referências são regravadas a partir da execução atual (depois de ouvir o WAV e
+# conferir a mudança).
+
+get_filename_component(name ${SCRIPT} NAME_WE)
+get_filename_component(golden_dir ${SCRIPT} DIRECTORY)
+set(outputs ${name}.onsets.csv ${name}.wav)
+
+file(MAKE_DIRECTORY ${OUT})
+execute_process(COMMAND ${SIM} ${SCRIPT} --quiet
+                        --onsets ${OUT}/${name}.onsets.csv --wav ${OUT}/${name}.wav
+                RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "GENIUS_sim terminou com codigo ${result}")
+endif()
+
+set(failed "")
+foreach (file ${outputs})
+    if (UPDATE)
+        file(COPY ${OUT}/${file} DESTINATION ${golden_dir})
+        message(STATUS "Referencia atualizada: ${golden_dir}/${file}")
+        continue()
+    endif()
+    execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${OUT}/${file} ${golden_dir}/${file}
+                    RESULT_VARIABLE different)
+    if (different)
+        list(APPEND failed ${file})
+    endif()
+endforeach()
+
+if (failed)
+    message(FATAL_ERROR "Diferente da referencia: ${failed}\n"
+            "Gerado em ${OUT}. Se a mudanca for intencional, atualize com o alvo sim_update_golden.")
+endif()
@@ -0,0 +1,23 @@
+#ifndef _HARDWARE_ADC_H
+#define _HARDWARE_ADC_H
+
+#include "pico.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file adc.h
+ * @brief Simulação no host: ADC de 12 bits
+ *
+ * Cada canal devolve o valor definido pelo roteiro da simulação (padrão: meio da escala).
+ */
+
+void adc_init(void);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint input);
+uint adc_get_selected_input(void);
+uint16_t adc_read(void);
+
+#endif // _HARDWARE_ADC_H
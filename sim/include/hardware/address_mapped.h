@@ -0,0 +1,38 @@
+#ifndef _HARDWARE_ADDRESS_MAPPED_H
+#define _HARDWARE_ADDRESS_MAPPED_H
+
+#include "pico.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file address_mapped.h
+ * @brief Simulação no host: acesso a registradores
+ *
+ * No host os "registradores" são estruturas comuns em memória; as operações atômicas de
+ * set/clear/xor do RP2040 viram leitura-modificação-escrita.
+ */
+
+typedef volatile uint32_t io_rw_32;
+typedef const volatile uint32_t io_ro_32;
+typedef volatile uint32_t io_wo_32;
+
+static inline void hw_set_bits(io_rw_32 *addr, uint32_t mask) {
+    *addr |= mask;
+}
+
+static inline void hw_clear_bits(io_rw_32 *addr, uint32_t mask) {
+    *addr &= ~mask;
+}
+
+static inline void hw_xor_bits(io_rw_32 *addr, uint32_t mask) {
+    *addr ^= mask;
+}
+
+static inline void hw_write_masked(io_rw_32 *addr, uint32_t values, uint32_t write_mask) {
+    *addr = (*addr & ~write_mask) | (values & write_mask);
+}
+
+#endif // _HARDWARE_ADDRESS_MAPPED_H
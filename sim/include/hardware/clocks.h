@@ -0,0 +1,45 @@
+#ifndef _HARDWARE_CLOCKS_H
+#define _HARDWARE_CLOCKS_H
+
+#include "pico.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file clocks.h
+ * @brief Simulação no host: clocks fixos na configuração padrão do SDK
+ */
+
+#define SIM_CLK_SYS_HZ 125000000u
+
+enum clock_index {
+    clk_gpout0 = 0,
+    clk_gpout1,
+    clk_gpout2,
+    clk_gpout3,
+    clk_ref,
+    clk_sys,
+    clk_peri,
+    clk_usb,
+    clk_adc,
+    clk_rtc,
+    CLK_COUNT
+};
+
+static inline uint32_t clock_get_hz(enum clock_index clk_index) {
+    switch (clk_index) {
+        case clk_usb:
+        case clk_adc:
+            return 48000000u;
+        case clk_ref:
+            return 12000000u;
+        case clk_rtc:
+            return 46875u;
+        default:
+            return SIM_CLK_SYS_HZ;
+    }
+}
+
+#endif // _HARDWARE_CLOCKS_H
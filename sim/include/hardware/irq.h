@@ -0,0 +1,70 @@
+#ifndef _HARDWARE_IRQ_H
+#define _HARDWARE_IRQ_H
+
+#include "pico.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file irq.h
+ * @brief Simulação no host: NVIC
+ *
+ * Prioridades e habilitações são apenas registradas; a simulação entrega as interrupções em
+ * ordem de tempo, sem preempção entre elas.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+enum irq_num_rp2040 {
+    TIMER_IRQ_0 = 0,
+    TIMER_IRQ_1 = 1,
+    TIMER_IRQ_2 = 2,
+    TIMER_IRQ_3 = 3,
+    PWM_IRQ_WRAP = 4,
+    USBCTRL_IRQ = 5,
+    XIP_IRQ = 6,
+    PIO0_IRQ_0 = 7,
+    PIO0_IRQ_1 = 8,
+    PIO1_IRQ_0 = 9,
+    PIO1_IRQ_1 = 10,
+    DMA_IRQ_0 = 11,
+    DMA_IRQ_1 = 12,
+    IO_IRQ_BANK0 = 13,
+    IO_IRQ_QSPI = 14,
+    SIO_IRQ_PROC0 = 15,
+    SIO_IRQ_PROC1 = 16,
+    CLOCKS_IRQ = 17,
+    SPI0_IRQ = 18,
+    SPI1_IRQ = 19,
+    UART0_IRQ = 20,
+    UART1_IRQ = 21,
+    ADC_IRQ_FIFO = 22,
+    I2C0_IRQ = 23,
+    I2C1_IRQ = 24,
+    RTC_IRQ = 25,
+    FIRST_USER_IRQ = 26,
+    NUM_IRQS = 32,
+};
+
+typedef void (*irq_handler_t)(void);
+
+/******************************
+ * Funções
+ ******************************/
+
+void irq_set_priority(uint num, uint8_t hardware_priority);
+uint irq_get_priority(uint num);
+void irq_set_enabled(uint num, bool enabled);
+bool irq_is_enabled(uint num);
+void irq_set_exclusive_handler(uint num, irq_handler_t handler);
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority);
+void irq_remove_handler(uint num, irq_handler_t handler);
+void irq_set_pending(uint num);
+int user_irq_claim_unused(bool required);
+void user_irq_unclaim(uint irq_num);
+
+#endif // _HARDWARE_IRQ_H
@@ -0,0 +1,130 @@
+#ifndef _HARDWARE_PWM_H
+#define _HARDWARE_PWM_H
+
+#include "pico.h"
+#include "hardware/address_mapped.h"
+#include "hardware/structs/pwm.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file pwm.h
+ * @brief Simulação no host: API de PWM do SDK sobre o banco de registradores simulado
+ *
+ * As funções escrevem em `pwm_hw` exatamente como as do SDK, de modo que as escritas diretas
+ * feitas pelo firmware (ex.: `start_tone()`) e as feitas pela API são capturadas da mesma forma.
+ */
+
+/******************************
+ * Estruturas
+ ******************************/
+
+enum pwm_chan {
+    PWM_CHAN_A = 0,
+    PWM_CHAN_B = 1,
+};
+
+typedef struct {
+    uint32_t csr;
+    uint32_t div;
+    uint32_t top;
+} pwm_config;
+
+/******************************
+ * Funções
+ ******************************/
+
+static inline uint pwm_gpio_to_slice_num(uint gpio) {
+    return (gpio >> 1u) & 7u;
+}
+
+static inline uint pwm_gpio_to_channel(uint gpio) {
+    return gpio & 1u;
+}
+
+static inline void pwm_set_wrap(uint slice_num, uint16_t wrap) {
+    pwm_hw->slice[slice_num].top = wrap;
+}
+
+static inline void pwm_set_clkdiv_int_frac(uint slice_num, uint8_t integer, uint8_t fract) {
+    pwm_hw->slice[slice_num].div = ((uint32_t)integer << PWM_CH0_DIV_INT_LSB) | (fract & 0xfu);
+}
+
+static inline void pwm_set_clkdiv(uint slice_num, float divider) {
+    uint32_t div16 = (uint32_t)(divider * 16.0f);
+    pwm_hw->slice[slice_num].div = div16 & 0xfffu;
+}
+
+static inline void pwm_set_chan_level(uint slice_num, uint chan, uint16_t level) {
+    hw_write_masked(&pwm_hw->slice[slice_num].cc, (uint32_t)level << (chan ? PWM_CH0_CC_B_LSB : 0),
+                    chan ? PWM_CH0_CC_B_BITS : PWM_CH0_CC_A_BITS);
+}
+
+static inline void pwm_set_both_levels(uint slice_num, uint16_t level_a, uint16_t level_b) {
+    pwm_hw->slice[slice_num].cc = ((uint32_t)level_b << PWM_CH0_CC_B_LSB) | level_a;
+}
+
+static inline void pwm_set_gpio_level(uint gpio, uint16_t level) {
+    pwm_set_chan_level(pwm_gpio_to_slice_num(gpio), pwm_gpio_to_channel(gpio), level);
+}
+
+static inline void pwm_set_enabled(uint slice_num, bool enabled) {
+    if (enabled) {
+        hw_set_bits(&pwm_hw->slice[slice_num].csr, PWM_CH0_CSR_EN_BITS);
+    } else {
+        hw_clear_bits(&pwm_hw->slice[slice_num].csr, PWM_CH0_CSR_EN_BITS);
+    }
+}
+
+static inline void pwm_set_mask_enabled(uint32_t mask) {
+    for (uint i = 0; i < NUM_PWM_SLICES; i++) {
+        pwm_set_enabled(i, (mask >> i) & 1u);
+    }
+}
+
+static inline void pwm_set_phase_correct(uint slice_num, bool phase_correct) {
+    hw_write_masked(&pwm_hw->slice[slice_num].csr, phase_correct ? PWM_CH0_CSR_PH_CORRECT_BITS : 0,
+                    PWM_CH0_CSR_PH_CORRECT_BITS);
+}
+
+static inline void pwm_clear_irq(uint slice_num) {
+    pwm_hw->intr &= ~(1u << slice_num); // No hardware o bit é limpo escrevendo 1
+}
+
+static inline void pwm_set_irq_enabled(uint slice_num, bool enabled) {
+    if (enabled) {
+        hw_set_bits(&pwm_hw->inte, 1u << slice_num);
+    } else {
+        hw_clear_bits(&pwm_hw->inte, 1u << slice_num);
+    }
+}
+
+static inline uint16_t pwm_get_counter(uint slice_num) {
+    return (uint16_t)pwm_hw->slice[slice_num].ctr;
+}
+
+static inline pwm_config pwm_get_default_config(void) {
+    pwm_config c = { .csr = 0, .div = 1u << PWM_CH0_DIV_INT_LSB, .top = 0xffff };
+    return c;
+}
+
+static inline void pwm_config_set_clkdiv(pwm_config *c, float div) {
+    c->div = (uint32_t)(div * 16.0f) & 0xfffu;
+}
+
+static inline void pwm_config_set_wrap(pwm_config *c, uint16_t wrap) {
+    c->top = wrap;
+}
+
+static inline void pwm_init(uint slice_num, pwm_config *c, bool start) {
+    pwm_hw->slice[slice_num].csr = 0;
+    pwm_hw->slice[slice_num].ctr = 0;
+    pwm_hw->slice[slice_num].cc = 0;
+    pwm_hw->slice[slice_num].top = c->top;
+    pwm_hw->slice[slice_num].div = c->div;
+    pwm_hw->slice[slice_num].csr = c->csr | (start ? PWM_CH0_CSR_EN_BITS : 0);
+}
+
+#endif // _HARDWARE_PWM_H
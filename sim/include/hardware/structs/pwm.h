@@ -0,0 +1,42 @@
+#ifndef _HARDWARE_STRUCTS_PWM_H
+#define _HARDWARE_STRUCTS_PWM_H
+
+#include "hardware/address_mapped.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file pwm.h
+ * @brief Simulação no host: banco de registradores do PWM (mesmo leiaute do RP2040)
+ */
+
+#define PWM_CH0_CSR_EN_BITS 0x00000001u
+#define PWM_CH0_CSR_PH_CORRECT_BITS 0x00000002u
+#define PWM_CH0_DIV_INT_LSB 4u
+#define PWM_CH0_CC_A_BITS 0x0000ffffu
+#define PWM_CH0_CC_B_BITS 0xffff0000u
+#define PWM_CH0_CC_B_LSB 16u
+
+typedef struct {
+    io_rw_32 csr;
+    io_rw_32 div;
+    io_rw_32 ctr;
+    io_rw_32 cc;
+    io_rw_32 top;
+} pwm_slice_hw_t;
+
+typedef struct {
+    pwm_slice_hw_t slice[8];
+    io_rw_32 en;
+    io_rw_32 intr;
+    io_rw_32 inte;
+    io_rw_32 intf;
+    io_ro_32 ints;
+} pwm_hw_t;
+
+extern pwm_hw_t sim_pwm_regs;
+#define pwm_hw (&sim_pwm_regs)
+
+#endif // _HARDWARE_STRUCTS_PWM_H
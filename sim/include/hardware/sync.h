@@ -0,0 +1,39 @@
+#ifndef _HARDWARE_SYNC_H
+#define _HARDWARE_SYNC_H
+
+#include "pico.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file sync.h
+ * @brief Simulação no host: seções críticas e espera por eventos
+ *
+ * `__wfe()`/`__wfi()` avançam o relógio virtual até o próximo evento (alarme ou entrada do
+ * roteiro) e entregam as interrupções correspondentes.
+ */
+
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t status);
+void __wfe(void);
+void __wfi(void);
+void __sev(void);
+
+static inline void __dmb(void) {
+    __compiler_memory_barrier();
+}
+
+static inline void __dsb(void) {
+    __compiler_memory_barrier();
+}
+
+static inline void __isb(void) {
+    __compiler_memory_barrier();
+}
+
+static inline void __nop(void) {
+}
+
+#endif // _HARDWARE_SYNC_H
@@ -0,0 +1,58 @@
+#ifndef _HARDWARE_TIMER_H
+#define _HARDWARE_TIMER_H
+
+#include "pico.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file timer.h
+ * @brief Simulação no host: temporizador de 1 MHz e alarmes de hardware sobre o relógio virtual
+ *
+ * O tempo só avança quando o firmware espera (`sleep_*`, `__wfe()`, `tight_loop_contents()`);
+ * um alarme vencido é entregue como interrupção nesses pontos ou ao reabilitar as interrupções.
+ */
+
+/******************************
+ * Estruturas
+ ******************************/
+
+typedef uint64_t absolute_time_t;
+
+typedef void (*hardware_alarm_callback_t)(uint alarm_num);
+
+/******************************
+ * Funções
+ ******************************/
+
+uint64_t time_us_64(void);
+
+static inline uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+static inline uint64_t to_us_since_boot(absolute_time_t t) {
+    return t;
+}
+
+static inline absolute_time_t from_us_since_boot(uint64_t us) {
+    return us;
+}
+
+void busy_wait_us(uint64_t delay_us);
+
+static inline void busy_wait_ms(uint32_t delay_ms) {
+    busy_wait_us((uint64_t)delay_ms * 1000);
+}
+
+void hardware_alarm_claim(uint alarm_num);
+int hardware_alarm_claim_unused(bool required);
+void hardware_alarm_unclaim(uint alarm_num);
+void hardware_alarm_set_callback(uint alarm_num, hardware_alarm_callback_t callback);
+bool hardware_alarm_set_target(uint alarm_num, absolute_time_t t);
+void hardware_alarm_cancel(uint alarm_num);
+void hardware_alarm_force_irq(uint alarm_num);
+
+#endif // _HARDWARE_TIMER_H
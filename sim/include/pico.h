@@ -0,0 +1,65 @@
+#ifndef PICO_H
+#define PICO_H
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file pico.h
+ * @brief Simulação no host: tipos e atributos básicos do SDK do Pico
+ *
+ * Substitui o cabeçalho de mesmo nome do SDK na compilação para o host (`GENIUS_SIM`). Os
+ * atributos de posicionamento em memória (SRAM, scratch) não têm efeito no host.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <assert.h>
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+typedef unsigned int uint;
+
+#define __not_in_flash(group)
+#define __not_in_flash_func(func_name) func_name
+#define __time_critical_func(func_name) func_name
+#define __scratch_x(group)
+#define __scratch_y(group)
+#define __uninitialized_ram(var) var
+#define __force_inline inline __attribute__((always_inline))
+#define __unused __attribute__((unused))
+#define __compiler_memory_barrier() __asm volatile ("" : : : "memory")
+
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+
+#ifndef MIN
+#define MIN(a, b) ((b) < (a) ? (b) : (a))
+#endif
+#ifndef MAX
+#define MAX(a, b) ((a) < (b) ? (b) : (a))
+#endif
+
+#define PICO_OK 0
+#define PICO_ERROR_TIMEOUT -1
+#define PICO_ERROR_GENERIC -2
+
+#define NUM_BANK0_GPIOS 30
+#define NUM_PWM_SLICES 8
+#define NUM_TIMERS 4
+
+#define PICO_DEFAULT_IRQ_PRIORITY 0x80
+#define PICO_TIME_DEFAULT_ALARM_POOL_HARDWARE_ALARM_NUM 3
+
+/**
+ * @brief Erro fatal: encerra a simulação com a mensagem.
+ */
+void panic(const char *fmt, ...);
+
+#define hard_assert(x) do { if (!(x)) panic("hard_assert: %s", #x); } while (0)
+
+#endif // PICO_H
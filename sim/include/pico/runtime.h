@@ -0,0 +1,21 @@
+#ifndef _PICO_RUNTIME_H
+#define _PICO_RUNTIME_H
+
+#include "pico.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file runtime.h
+ * @brief Simulação no host: funções de inicialização da `runtime_init` do SDK
+ *
+ * No host não há `runtime_init`; as funções registradas viram construtores, executados antes do
+ * `main()` com o relógio virtual ainda em 0.
+ */
+
+#define PICO_RUNTIME_INIT_FUNC_RUNTIME(func, priority_string) \
+    static void __attribute__((constructor)) func##_runtime_init(void) { func(); }
+
+#endif // _PICO_RUNTIME_H
@@ -0,0 +1,30 @@
+#ifndef _PICO_STDLIB_H
+#define _PICO_STDLIB_H
+
+#include "pico.h"
+#include "pico/time.h"
+#include "hardware/address_mapped.h"
+#include "hardware/gpio.h"
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file stdlib.h
+ * @brief Simulação no host: substituto de `pico/stdlib.h`
+ *
+ * A saída padrão do firmware vai para a saída padrão do processo; a entrada serial vem das
+ * teclas do roteiro da simulação.
+ */
+
+bool stdio_init_all(void);
+int getchar_timeout_us(uint32_t timeout_us);
+
+/**
+ * @brief Laço de espera ativa: avança o relógio virtual em 1 us.
+ */
+void tight_loop_contents(void);
+
+#endif // _PICO_STDLIB_H
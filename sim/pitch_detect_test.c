@@ -0,0 +1,182 @@
+#include "inc/pitch_detect.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file pitch_detect_test.c
+ * @brief Teste no host do detector de altura (`pitch_detect.h`)
+ *
+ * Alimenta o detector com quadros sintéticos como os do ADC (12 bits em torno do meio da escala,
+ * com um pouco de ruído) e confere:
+ * 1. Senoides de lá 4 (440 Hz), nas bordas da faixa (`PITCH_MIN_HZ` e `PITCH_MAX_HZ`) e no meio
+ *    dela: frequência detectada dentro de `FREQ_TOL_CENTS`, nota e desvio em centésimos de
+ *    `pitch_nearest_note()` iguais aos calculados em ponto flutuante (com `CENTS_TOL` de folga).
+ * 2. Sinais fracos: uma senoide com pico pouco acima de `PITCH_MIN_LEVEL` ainda tem nota.
+ * 3. Quadros sem nota: silêncio (só o ruído do ADC), ruído branco forte e uma senoide abaixo da
+ *    faixa.
+ *
+ * Uso: `GENIUS_pitch_test` (código 0 se todos os casos passarem; registrado no ctest).
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define ADC_MID 2048
+#define ADC_NOISE_LSB 3         // Ruído do ADC somado a todos os quadros (pico)
+#define FREQ_TOL_CENTS 10.0     // Erro aceito na frequência detectada
+#define CENTS_TOL 3             // Diferença aceita no desvio em centésimos (arredondamento)
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static uint16_t frame[PITCH_FRAME];
+static uint32_t rng_state = 1;
+static uint failures, cases;
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+static uint32_t rng_next() {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+/**
+ * @brief Valor uniforme em [-peak, peak].
+ */
+static int rng_range(int peak) {
+    return (int)(rng_next() % (uint32_t)(2 * peak + 1)) - peak;
+}
+
+static uint16_t clamp_adc(double v) {
+    long s = lround(v);
+    return (uint16_t)(s < 0 ? 0 : s > 4095 ? 4095 : s);
+}
+
+/**
+ * @brief Quadro com uma senoide de `freq` Hz e pico de `amplitude` LSB, mais o ruído do ADC.
+ */
+static void fill_sine(double freq, double amplitude, double phase) {
+    for (uint i = 0; i < PITCH_FRAME; i++) {
+        double v = ADC_MID + amplitude * sin(2 * M_PI * freq * i / PITCH_SAMPLE_RATE_HZ + phase);
+        frame[i] = clamp_adc(v + rng_range(ADC_NOISE_LSB));
+    }
+}
+
+/**
+ * @brief Quadro de ruído branco uniforme com pico de `amplitude` LSB.
+ */
+static void fill_noise(int amplitude) {
+    for (uint i = 0; i < PITCH_FRAME; i++) {
+        frame[i] = clamp_adc(ADC_MID + rng_range(amplitude));
+    }
+}
+
+static void fail(const char *name, const char *fmt, double got, double want) {
+    failures++;
+    printf("FALHA %-24s ", name);
+    printf(fmt, got, want);
+    printf("\n");
+}
+
+/**
+ * @brief Confere um quadro com nota em `freq` Hz.
+ */
+static void expect_voiced(const char *name, double freq) {
+    pitch_result_t result;
+    cases++;
+
+    if (!pitch_detect(frame, &result)) {
+        fail(name, "sem nota (pico %.0f LSB), esperado %.2f Hz", (double)result.peak, freq);
+        return;
+    }
+
+    double got = result.freq_q4 / 16.0;
+    double error_cents = 1200 * log2(got / freq);
+    if (fabs(error_cents) > FREQ_TOL_CENTS) {
+        fail(name, "%.2f Hz, esperado %.2f Hz", got, freq);
+        return;
+    }
+
+    // Nota e desvio calculados a partir da frequência detectada, em ponto flutuante
+    double semis = 69 + 12 * log2(got / 440.0);
+    int want_midi = (int)lround(semis);
+    int want_cents = (int)lround((semis - want_midi) * 100);
+    int cents;
+    int midi = pitch_nearest_note(result.freq_q4, &cents);
+    if (midi != want_midi) {
+        fail(name, "nota MIDI %.0f, esperada %.0f", (double)midi, (double)want_midi);
+        return;
+    }
+    if (abs(cents - want_cents) > CENTS_TOL) {
+        fail(name, "%+.0f centesimos, esperado %+.0f", (double)cents, (double)want_cents);
+        return;
+    }
+    printf("ok    %-24s %8.2f Hz (%+5.1f cents) %s%d %+d\n", name, got, error_cents, pitch_note_name(midi),
+           midi / 12 - 1, cents);
+}
+
+/**
+ * @brief Confere um quadro sem nota.
+ */
+static void expect_unvoiced(const char *name) {
+    pitch_result_t result;
+    cases++;
+
+    if (pitch_detect(frame, &result)) {
+        fail(name, "nota em %.2f Hz (d' %.0f/32768), esperado sem nota", result.freq_q4 / 16.0,
+             (double)result.aperiodicity_q15);
+        return;
+    }
+    printf("ok    %-24s sem nota (pico %u LSB)\n", name, result.peak);
+}
+
+/******************************
+ * Função Principal
+ ******************************/
+
+int main(void) {
+    static const struct {
+        const char *name;
+        double freq;
+    } sines[] = {
+        { "la 4", 440.0 },
+        { "la 4 + 20 cents", 445.11 },
+        { "la 4 - 40 cents", 429.98 },
+        { "borda inferior", PITCH_MIN_HZ * 1.01 },
+        { "mi 2 (82,41 Hz)", 82.41 },
+        { "do 3 (130,81 Hz)", 130.81 },
+        { "la 3 (220 Hz)", 220.0 },
+        { "do 5 (523,25 Hz)", 523.25 },
+        { "la 5 (880 Hz)", 880.0 },
+        { "borda superior", PITCH_MAX_HZ * 0.99 },
+    };
+
+    for (uint i = 0; i < sizeof(sines) / sizeof(sines[0]); i++) {
+        fill_sine(sines[i].freq, 1200, 0.3 * i);
+        expect_voiced(sines[i].name, sines[i].freq);
+    }
+
+    fill_sine(440.0, PITCH_MIN_LEVEL * 3, 0);
+    expect_voiced("la 4 fraco", 440.0);
+
+    fill_sine(440.0, 0, 0);
+    expect_unvoiced("silencio");
+
+    fill_noise(1500);
+    expect_unvoiced("ruido branco");
+
+    fill_sine(PITCH_MIN_HZ * 0.6, 1200, 0);
+    expect_unvoiced("abaixo da faixa");
+
+    printf("%u casos, %u falhas\n", cases, failures);
+    return failures ? 1 : 0;
+}
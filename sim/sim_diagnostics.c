@@ -0,0 +1,105 @@
+#include "inc/stack_monitor.h"
+#include "inc/mem_layout.h"
+#include "inc/irq_latency.h"
+#include "inc/gpio_latency.h"
+#include "inc/tone_selftest.h"
+#include "inc/bounce_profiler.h"
+#include "inc/JoystickPi_calibration.h"
+#include "inc/rhythm.h"
+#include "inc/tuner.h"
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file sim_diagnostics.c
+ * @brief Simulação no host: diagnósticos que dependem do hardware real
+ *
+ * `stack_monitor.c`, `mem_layout.c`, `irq_latency.c`, `gpio_latency.c`, `tone_selftest.c`,
+ * `bounce_profiler.c`, `JoystickPi_calibration.c` e `rhythm_calibration.c` medem o mapa de memória,
+ * as pilhas, o NVIC, o banco GPIO, a saída PWM, as chaves físicas e o ruído do ADC do RP2040 e não
+ * têm equivalente no host; `tuner.c` depende da DMA e da conversão contínua do ADC, que o HAL
+ * simulado não tem (`pitch_detect.c` é compilado normalmente). Estas versões mantêm os comandos
+ * da serial funcionando e informam que a medição não está disponível.
+ */
+
+void stack_monitor_init() {
+}
+
+uint32_t stack_monitor_size(stack_id_t id) {
+    (void)id;
+    return 0;
+}
+
+uint32_t stack_monitor_high_water(stack_id_t id) {
+    (void)id;
+    return 0;
+}
+
+void stack_monitor_report() {
+    printf("\nPilhas: indisponivel na simulacao\n");
+}
+
+const char *mem_layout_bank_name(const void *addr) {
+    (void)addr;
+    return "host";
+}
+
+void mem_layout_report() {
+    printf("\nMapa de memoria: indisponivel na simulacao\n");
+}
+
+void mem_layout_benchmark() {
+    printf("\nBenchmark de bancos: indisponivel na simulacao\n");
+}
+
+void irq_latency_benchmark() {
+    printf("\nLatencia de IRQ: indisponivel na simulacao\n");
+}
+
+void gpio_latency_benchmark() {
+    printf("\nLatencia GPIO: indisponivel na simulacao\n");
+}
+
+void tone_selftest_run(const uint32_t *freqs, uint count) {
+    (void)freqs;
+    (void)count;
+    printf("\nAutoteste de frequencia: indisponivel na simulacao (use --pwm)\n");
+}
+
+void bounce_profiler_run(bool apply) {
+    (void)apply;
+    printf("\nRepique das chaves: indisponivel na simulacao (o roteiro nao tem repique)\n");
+}
+
+void joystickPi_calibration_init() {
+}
+
+bool joystickPi_calibrate() {
+    printf("\nCalibracao do joystick: indisponivel na simulacao (o ADC simulado nao tem ruido)\n");
+    return false;
+}
+
+void rhythm_calibrate() {
+    printf("\nCalibracao do acompanhamento: indisponivel na simulacao (entrada e saida sem atraso)\n");
+}
+
+void tuner_init() {
+}
+
+void tuner_start() {
+    printf("\nAfinador: indisponivel na simulacao (sem DMA nem microfone)\n");
+}
+
+void tuner_stop() {
+}
+
+bool tuner_active() {
+    return false;
+}
+
+pitch_result_t tuner_result() {
+    return (pitch_result_t){ 0 };
+}
@@ -0,0 +1,648 @@
+#include "sim/sim_hal.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/irq.h"
+#include "hardware/pwm.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file sim_hal.c
+ * @brief Simulação no host: implementação do HAL simulado e do relógio virtual
+ *
+ * Modelo de interrupções: uma interrupção pendente (alarme vencido, borda em um GPIO, IRQ de
+ * usuário) é entregue assim que o firmware a permite — ao esperar, ao reabilitar as
+ * interrupções ou logo após a ação que a gerou. As interrupções não se aninham: uma ISR em
+ * execução nunca é interrompida por outra, e os alarmes são entregues antes do banco de GPIOs.
+ *
+ * O contador do PWM não é simulado: um slice ligado com a IRQ de wrap habilitada gera um wrap
+ * a cada entrega (uma vez por entrega, para uma ISR que não a desabilita não prender o relógio).
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define SIM_ADC_CHANNELS 5
+#define SIM_ADC_MIDSCALE 2048
+#define SIM_SERIAL_QUEUE 256
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+pwm_hw_t sim_pwm_regs;
+
+static uint64_t now_us;          // Relógio virtual
+static uintptr_t stack_base;     // Topo da pilha do host ao carregar o programa
+static uintptr_t stack_low;      // Menor endereço de pilha visto nas entradas do HAL
+static uint32_t irq_disabled;    // Estado salvo por save_and_disable_interrupts()
+static bool in_irq;              // Uma ISR simulada está em execução
+
+static struct {
+    uint8_t function;
+    bool out_dir;
+    bool out_level;
+    bool pull_up;
+    bool pull_down;
+    int8_t drive;                // Nível imposto pelo roteiro (-1 = nenhum)
+    uint32_t irq_mask;           // Eventos habilitados
+    uint32_t pending;            // Eventos pendentes
+} gpios[NUM_BANK0_GPIOS];
+static gpio_irq_callback_t gpio_callback;
+
+static struct {
+    bool claimed;
+    bool armed;
+    bool forced;
+    uint64_t target;
+    hardware_alarm_callback_t callback;
+} alarms[NUM_TIMERS];
+
+static struct {
+    uint8_t priority;
+    bool enabled;
+    bool pending;
+    irq_handler_t handler;
+} irqs[NUM_IRQS];
+static uint32_t user_irqs_claimed;
+
+static uint16_t adc_values[SIM_ADC_CHANNELS];
+static uint adc_input;
+
+static int serial_queue[SIM_SERIAL_QUEUE];
+static uint serial_head, serial_tail;
+
+static struct {
+    bool valid;
+    double freq_hz;
+    uint32_t duty;
+} pwm_reported[NUM_BANK0_GPIOS];
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Estado de reset: pinos sem função com pull-down, ADC no meio da escala.
+ */
+__attribute__((constructor)) static void sim_reset() {
+    stack_base = stack_low = (uintptr_t)__builtin_frame_address(0);
+    for (uint g = 0; g < NUM_BANK0_GPIOS; g++) {
+        gpios[g].function = GPIO_FUNC_NULL;
+        gpios[g].pull_down = true;
+        gpios[g].drive = -1;
+    }
+    for (uint c = 0; c < SIM_ADC_CHANNELS; c++) {
+        adc_values[c] = SIM_ADC_MIDSCALE;
+    }
+    for (uint i = 0; i < NUM_IRQS; i++) {
+        irqs[i].priority = PICO_DEFAULT_IRQ_PRIORITY;
+    }
+    alarms[PICO_TIME_DEFAULT_ALARM_POOL_HARDWARE_ALARM_NUM].claimed = true; // Pool padrão do SDK
+}
+
+/**
+ * @brief Nível lógico atual de um pino.
+ */
+static bool gpio_level(uint gpio) {
+    if (gpios[gpio].function == GPIO_FUNC_SIO && gpios[gpio].out_dir) {
+        return gpios[gpio].out_level;
+    }
+    if (gpios[gpio].drive >= 0) {
+        return gpios[gpio].drive;
+    }
+    return gpios[gpio].pull_up;
+}
+
+/**
+ * @brief Gera os eventos de borda de um pino cujo nível pode ter mudado.
+ */
+static void gpio_detect_edge(uint gpio, bool before) {
+    bool after = gpio_level(gpio);
+
+    if (after != before) {
+        uint32_t event = after ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL;
+        gpios[gpio].pending |= event & gpios[gpio].irq_mask;
+    }
+}
+
+/**
+ * @brief Registra a profundidade da pilha na entrada atual do HAL.
+ */
+static inline void stack_sample() {
+    uintptr_t sp = (uintptr_t)__builtin_frame_address(0);
+    if (sp < stack_low) {
+        stack_low = sp;
+    }
+}
+
+/**
+ * @brief Slices ligados com a IRQ de wrap habilitada.
+ */
+static uint32_t pwm_wrap_mask() {
+    uint32_t mask = 0;
+
+    for (uint s = 0; s < NUM_PWM_SLICES; s++) {
+        if (sim_pwm_regs.slice[s].csr & PWM_CH0_CSR_EN_BITS) {
+            mask |= 1u << s;
+        }
+    }
+    return mask & sim_pwm_regs.inte;
+}
+
+/**
+ * @brief Entrega todas as interrupções pendentes no instante atual.
+ */
+static void deliver_interrupts() {
+    stack_sample();
+    if (in_irq || irq_disabled) {
+        return;
+    }
+
+    in_irq = true;
+    bool pwm_wrapped = false;
+    bool delivered;
+    do {
+        delivered = false;
+
+        for (uint a = 0; a < NUM_TIMERS; a++) {
+            if ((alarms[a].armed && alarms[a].target <= now_us) || alarms[a].forced) {
+                alarms[a].armed = false;
+                alarms[a].forced = false;
+                if (alarms[a].callback && irqs[TIMER_IRQ_0 + a].enabled) {
+                    alarms[a].callback(a);
+                    delivered = true;
+                }
+            }
+        }
+
+        for (uint g = 0; g < NUM_BANK0_GPIOS; g++) {
+            if (gpios[g].pending && irqs[IO_IRQ_BANK0].enabled && gpio_callback) {
+                uint32_t events = gpios[g].pending;
+                gpios[g].pending = 0;
+                gpio_callback(g, events);
+                delivered = true;
+            }
+        }
+
+        uint32_t wrapping = pwm_wrap_mask();
+        if (wrapping && !pwm_wrapped && irqs[PWM_IRQ_WRAP].enabled && irqs[PWM_IRQ_WRAP].handler) {
+            pwm_wrapped = true;
+            sim_pwm_regs.intr |= wrapping;
+            irqs[PWM_IRQ_WRAP].handler();
+            delivered = true;
+        }
+
+        for (uint i = FIRST_USER_IRQ; i < NUM_IRQS; i++) {
+            if (irqs[i].pending && irqs[i].enabled && irqs[i].handler) {
+                irqs[i].pending = false;
+                irqs[i].handler();
+                delivered = true;
+            }
+        }
+    } while (delivered);
+    in_irq = false;
+}
+
+/**
+ * @brief Instante do próximo evento: alarme (se puder ser entregue agora) ou entrada do roteiro.
+ */
+static uint64_t next_event_us() {
+    uint64_t next = sim_script_next_us();
+
+    if (in_irq || irq_disabled) {
+        return next; // Alarmes vencidos ficam pendentes até a reabilitação
+    }
+    for (uint a = 0; a < NUM_TIMERS; a++) {
+        if (alarms[a].forced) {
+            return now_us;
+        }
+        if (alarms[a].armed && alarms[a].target < next) {
+            next = alarms[a].target < now_us ? now_us : alarms[a].target;
+        }
+    }
+    return next;
+}
+
+/**
+ * @brief Move o relógio, registrando antes as saídas PWM do intervalo que termina.
+ */
+static void move_time(uint64_t t) {
+    if (t > now_us) {
+        sim_pwm_capture();
+        now_us = t;
+    }
+}
+
+/**
+ * @brief Avança o relógio até `target`, processando os eventos do caminho em ordem.
+ */
+static void advance_to(uint64_t target) {
+    uint64_t next;
+
+    deliver_interrupts();
+    while ((next = next_event_us()) <= target) {
+        move_time(next);
+        sim_script_apply(now_us);
+        deliver_interrupts();
+    }
+    move_time(target);
+    deliver_interrupts();
+}
+
+/******************************
+ * Funções da Simulação
+ ******************************/
+
+void sim_set_time_us(uint64_t t) {
+    now_us = t;
+}
+
+size_t sim_stack_take_peak() {
+    size_t depth = stack_base - stack_low;
+    stack_low = stack_base;
+    return depth;
+}
+
+void sim_gpio_drive(uint gpio, int level) {
+    bool before = gpio_level(gpio);
+    gpios[gpio].drive = level < 0 ? -1 : (level != 0);
+    gpio_detect_edge(gpio, before);
+    deliver_interrupts();
+}
+
+void sim_adc_set(uint channel, uint16_t value) {
+    if (channel < SIM_ADC_CHANNELS) {
+        adc_values[channel] = value > 4095 ? 4095 : value;
+    }
+}
+
+void sim_serial_push(int c) {
+    uint next = (serial_tail + 1) % SIM_SERIAL_QUEUE;
+    if (next != serial_head) {
+        serial_queue[serial_tail] = c;
+        serial_tail = next;
+    }
+}
+
+bool sim_pwm_output(uint gpio, double *freq_hz, uint32_t *duty_permille) {
+    if (gpio >= NUM_BANK0_GPIOS || gpios[gpio].function != GPIO_FUNC_PWM) {
+        return false;
+    }
+
+    pwm_slice_hw_t *slice = &sim_pwm_regs.slice[pwm_gpio_to_slice_num(gpio)];
+    uint32_t top = slice->top & 0xffffu;
+    uint32_t div16 = slice->div & 0xfffu;
+    uint32_t level = pwm_gpio_to_channel(gpio) ? slice->cc >> 16 : slice->cc & 0xffffu;
+
+    if ((div16 >> 4) == 0) {
+        div16 += 256u << 4; // Parte inteira 0 vale 256
+    }
+    if (!(slice->csr & PWM_CH0_CSR_EN_BITS) || level == 0) {
+        *freq_hz = 0;
+        *duty_permille = 0;
+        return true;
+    }
+
+    double period = (double)(top + 1) * ((slice->csr & PWM_CH0_CSR_PH_CORRECT_BITS) ? 2 : 1);
+    *freq_hz = SIM_CLK_SYS_HZ * 16.0 / div16 / period;
+    *duty_permille = level > top ? 1000 : level * 1000 / (top + 1);
+    return true;
+}
+
+void sim_pwm_capture() {
+    // As escritas valem na hora: o contador fica no penúltimo tique do período, o que leva a
+    // previsão de `start_tone_timed()` a 2 tiques do instante simulado
+    for (uint s = 0; s < NUM_PWM_SLICES; s++) {
+        pwm_slice_hw_t *slice = &sim_pwm_regs.slice[s];
+        slice->ctr = slice->top > 0 ? slice->top - 1 : 0;
+    }
+    for (uint g = 0; g < NUM_BANK0_GPIOS; g++) {
+        double freq;
+        uint32_t duty;
+        if (!sim_pwm_output(g, &freq, &duty)) {
+            continue;
+        }
+        if (!pwm_reported[g].valid || pwm_reported[g].freq_hz != freq || pwm_reported[g].duty != duty) {
+            pwm_reported[g].valid = true;
+            pwm_reported[g].freq_hz = freq;
+            pwm_reported[g].duty = duty;
+            sim_script_pwm_changed(now_us, g, freq, duty);
+        }
+    }
+}
+
+/******************************
+ * Funções do SDK: base, tempo e stdio
+ ******************************/
+
+void panic(const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    fflush(stdout);
+    fprintf(stderr, "\n[sim] panic em %.3f ms: ", now_us / 1000.0);
+    vfprintf(stderr, fmt, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+    exit(2);
+}
+
+uint64_t time_us_64(void) {
+    return now_us;
+}
+
+void busy_wait_us(uint64_t delay_us) {
+    advance_to(now_us + delay_us);
+}
+
+void sleep_us(uint64_t us) {
+    advance_to(now_us + us);
+}
+
+void sleep_ms(uint32_t ms) {
+    advance_to(now_us + (uint64_t)ms * 1000);
+}
+
+void sleep_until(absolute_time_t target) {
+    if (target > now_us) {
+        advance_to(target);
+    }
+}
+
+void tight_loop_contents(void) {
+    advance_to(now_us + 1);
+}
+
+bool stdio_init_all(void) {
+    return true;
+}
+
+int getchar_timeout_us(uint32_t timeout_us) {
+    uint64_t deadline = now_us + timeout_us;
+
+    while (serial_head == serial_tail && now_us < deadline) {
+        uint64_t next = next_event_us();
+        advance_to(next < deadline ? next : deadline);
+    }
+    if (serial_head == serial_tail) {
+        return PICO_ERROR_TIMEOUT;
+    }
+
+    int c = serial_queue[serial_head];
+    serial_head = (serial_head + 1) % SIM_SERIAL_QUEUE;
+    return c;
+}
+
+/******************************
+ * Funções do SDK: sincronização e interrupções
+ ******************************/
+
+uint32_t save_and_disable_interrupts(void) {
+    uint32_t status = irq_disabled;
+    irq_disabled = 1;
+    return status;
+}
+
+void restore_interrupts(uint32_t status) {
+    irq_disabled = status;
+    deliver_interrupts();
+}
+
+void __wfe(void) {
+    uint64_t next = next_event_us();
+    if (next == UINT64_MAX) {
+        panic("__wfe() sem eventos futuros");
+    }
+    advance_to(next > now_us ? next : now_us);
+}
+
+void __wfi(void) {
+    __wfe();
+}
+
+void __sev(void) {
+}
+
+void irq_set_priority(uint num, uint8_t hardware_priority) {
+    irqs[num].priority = hardware_priority;
+}
+
+uint irq_get_priority(uint num) {
+    return irqs[num].priority;
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    irqs[num].enabled = enabled;
+    deliver_interrupts();
+}
+
+bool irq_is_enabled(uint num) {
+    return irqs[num].enabled;
+}
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+    irqs[num].handler = handler;
+}
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) {
+    (void)order_priority;
+    irqs[num].handler = handler;
+}
+
+void irq_remove_handler(uint num, irq_handler_t handler) {
+    if (irqs[num].handler == handler) {
+        irqs[num].handler = NULL;
+    }
+}
+
+void irq_set_pending(uint num) {
+    irqs[num].pending = true;
+    deliver_interrupts();
+}
+
+int user_irq_claim_unused(bool required) {
+    for (uint i = FIRST_USER_IRQ; i < NUM_IRQS; i++) {
+        if (!(user_irqs_claimed & (1u << i))) {
+            user_irqs_claimed |= 1u << i;
+            return i;
+        }
+    }
+    if (required) {
+        panic("nenhuma IRQ de usuario livre");
+    }
+    return -1;
+}
+
+void user_irq_unclaim(uint irq_num) {
+    user_irqs_claimed &= ~(1u << irq_num);
+}
+
+/******************************
+ * Funções do SDK: alarmes
+ ******************************/
+
+void hardware_alarm_claim(uint alarm_num) {
+    if (alarms[alarm_num].claimed) {
+        panic("alarme %u ja reservado", alarm_num);
+    }
+    alarms[alarm_num].claimed = true;
+}
+
+int hardware_alarm_claim_unused(bool required) {
+    for (uint a = 0; a < NUM_TIMERS; a++) {
+        if (!alarms[a].claimed) {
+            alarms[a].claimed = true;
+            return a;
+        }
+    }
+    if (required) {
+        panic("nenhum alarme de hardware livre");
+    }
+    return -1;
+}
+
+void hardware_alarm_unclaim(uint alarm_num) {
+    alarms[alarm_num].claimed = false;
+}
+
+void hardware_alarm_set_callback(uint alarm_num, hardware_alarm_callback_t callback) {
+    alarms[alarm_num].callback = callback;
+    irqs[TIMER_IRQ_0 + alarm_num].enabled = callback != NULL;
+}
+
+bool hardware_alarm_set_target(uint alarm_num, absolute_time_t t) {
+    if (t <= now_us) {
+        alarms[alarm_num].armed = false;
+        return true; // Instante já passou: o alarme não dispara
+    }
+    alarms[alarm_num].armed = true;
+    alarms[alarm_num].target = t;
+    return false;
+}
+
+void hardware_alarm_cancel(uint alarm_num) {
+    alarms[alarm_num].armed = false;
+}
+
+void hardware_alarm_force_irq(uint alarm_num) {
+    alarms[alarm_num].forced = true;
+    deliver_interrupts();
+}
+
+/******************************
+ * Funções do SDK: GPIO
+ ******************************/
+
+void gpio_init(uint gpio) {
+    bool before = gpio_level(gpio);
+    gpios[gpio].out_dir = false;
+    gpios[gpio].out_level = false;
+    gpios[gpio].function = GPIO_FUNC_SIO;
+    gpio_detect_edge(gpio, before);
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn) {
+    bool before = gpio_level(gpio);
+    gpios[gpio].function = fn;
+    gpio_detect_edge(gpio, before);
+}
+
+enum gpio_function gpio_get_function(uint gpio) {
+    return gpios[gpio].function;
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+    bool before = gpio_level(gpio);
+    gpios[gpio].out_dir = out;
+    gpio_detect_edge(gpio, before);
+    deliver_interrupts();
+}
+
+bool gpio_is_dir_out(uint gpio) {
+    return gpios[gpio].out_dir;
+}
+
+void gpio_set_pulls(uint gpio, bool up, bool down) {
+    bool before = gpio_level(gpio);
+    gpios[gpio].pull_up = up;
+    gpios[gpio].pull_down = down;
+    gpio_detect_edge(gpio, before);
+    deliver_interrupts();
+}
+
+void gpio_put(uint gpio, bool value) {
+    bool before = gpio_level(gpio);
+    gpios[gpio].out_level = value;
+    gpio_detect_edge(gpio, before);
+    deliver_interrupts();
+}
+
+bool gpio_get(uint gpio) {
+    return gpio_level(gpio);
+}
+
+uint32_t gpio_get_all(void) {
+    uint32_t all = 0;
+    for (uint g = 0; g < NUM_BANK0_GPIOS; g++) {
+        all |= (uint32_t)gpio_level(g) << g;
+    }
+    return all;
+}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled) {
+    gpios[gpio].pending &= ~event_mask; // O SDK limpa as bordas antigas ao (des)habilitar
+    if (enabled) {
+        gpios[gpio].irq_mask |= event_mask;
+    } else {
+        gpios[gpio].irq_mask &= ~event_mask;
+    }
+}
+
+void gpio_set_irq_callback(gpio_irq_callback_t callback) {
+    gpio_callback = callback;
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t callback) {
+    gpio_set_irq_enabled(gpio, event_mask, enabled);
+    gpio_set_irq_callback(callback);
+    if (enabled) {
+        irq_set_enabled(IO_IRQ_BANK0, true);
+    }
+}
+
+void gpio_acknowledge_irq(uint gpio, uint32_t event_mask) {
+    gpios[gpio].pending &= ~event_mask;
+}
+
+/******************************
+ * Funções do SDK: ADC
+ ******************************/
+
+void adc_init(void) {
+    adc_input = 0;
+}
+
+void adc_gpio_init(uint gpio) {
+    gpios[gpio].function = GPIO_FUNC_NULL;
+    gpios[gpio].pull_up = false;
+    gpios[gpio].pull_down = false;
+}
+
+void adc_select_input(uint input) {
+    adc_input = input;
+}
+
+uint adc_get_selected_input(void) {
+    return adc_input;
+}
+
+uint16_t adc_read(void) {
+    return adc_input < SIM_ADC_CHANNELS ? adc_values[adc_input] : 0;
+}
@@ -0,0 +1,110 @@
+#ifndef SIM_HAL_H
+#define SIM_HAL_H
+
+#include "pico/stdlib.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file sim_hal.h
+ * @brief Simulação no host: controle do HAL simulado e ganchos do roteiro
+ *
+ * O HAL simulado (`sim_hal.c`) implementa a parte do SDK usada pelo firmware sobre um relógio
+ * virtual determinístico. O tempo só avança quando o firmware espera; a cada avanço o HAL
+ * entrega, em ordem de tempo, os alarmes vencidos e os eventos do roteiro (`sim_script.c`), e
+ * registra as mudanças na saída dos pinos em modo PWM.
+ *
+ * Funções `sim_*` são exclusivas da simulação: o firmware nunca as chama.
+ */
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Define o relógio virtual. Só pode ser chamada antes de o firmware começar.
+ *
+ * Permite começar perto dos pontos de volta de `time_us_32()` (2^32 us) e do tick da roda de
+ * temporizadores (2^32 ms).
+ *
+ * @param t Instante inicial em microssegundos.
+ */
+void sim_set_time_us(uint64_t t);
+
+/**
+ * @brief Maior profundidade de pilha do host vista nas entradas do HAL desde a última chamada.
+ *
+ * Medida a partir do início do programa, a cada entrega de interrupções; detecta aninhamento que
+ * cresce com o tempo (ex.: espera dentro de callback), não o pico exato do firmware.
+ *
+ * @return Profundidade em bytes.
+ */
+size_t sim_stack_take_peak();
+
+/**
+ * @brief Aciona um pino externamente (botão, sinal de teste).
+ *
+ * @param gpio Pino.
+ * @param level 0 ou 1, ou -1 para soltar o pino (volta a valer o pull).
+ */
+void sim_gpio_drive(uint gpio, int level);
+
+/**
+ * @brief Define o valor devolvido por um canal do ADC.
+ *
+ * @param channel Canal (0-4).
+ * @param value Valor de 12 bits.
+ */
+void sim_adc_set(uint channel, uint16_t value);
+
+/**
+ * @brief Coloca um caractere na entrada serial lida por `getchar_timeout_us()`.
+ *
+ * @param c Caractere.
+ */
+void sim_serial_push(int c);
+
+/**
+ * @brief Estado atual da saída PWM de um pino.
+ *
+ * @param gpio Pino.
+ * @param freq_hz Recebe a frequência do sinal (0 se o canal estiver parado ou com nível 0).
+ * @param duty_permille Recebe o ciclo de trabalho em milésimos.
+ * @return false se o pino não estiver em modo PWM.
+ */
+bool sim_pwm_output(uint gpio, double *freq_hz, uint32_t *duty_permille);
+
+/**
+ * @brief Compara as saídas PWM com o último estado registrado e informa as mudanças.
+ */
+void sim_pwm_capture();
+
+/******************************
+ * Ganchos implementados pelo roteiro
+ ******************************/
+
+/**
+ * @brief Instante (us) do próximo evento do roteiro, ou `UINT64_MAX` se não houver.
+ */
+uint64_t sim_script_next_us();
+
+/**
+ * @brief Aplica todos os eventos do roteiro com instante até `now_us`.
+ *
+ * @param now_us Tempo virtual atual.
+ */
+void sim_script_apply(uint64_t now_us);
+
+/**
+ * @brief Recebe uma mudança na saída PWM de um pino.
+ *
+ * @param now_us Instante da mudança.
+ * @param gpio Pino.
+ * @param freq_hz Nova frequência (0 = silêncio).
+ * @param duty_permille Novo ciclo de trabalho em milésimos.
+ */
+void sim_script_pwm_changed(uint64_t now_us, uint gpio, double freq_hz, uint32_t duty_permille);
+
+#endif // SIM_HAL_H
@@ -0,0 +1,95 @@
+#include "sim/sim_script.h"
+#include "sim/sim_render.h"
+#include "sim/sim_soak.h"
+#include "sim/sim_hal.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file sim_main.c
+ * @brief Simulação no host: ponto de entrada do GENIUS_sim
+ *
+ * Uso: `GENIUS_sim <roteiro> [--pwm saida.csv] [--wav audio.wav] [--onsets notas.csv] [--quiet]`
+ *  ou: `GENIUS_sim --soak <horas> [--seed n] [--start-ms n] [--quiet]`
+ *
+ * Carrega o roteiro e executa o `main()` do firmware (renomeado para `genius_firmware_main`) sobre
+ * o HAL simulado. `--pwm` grava cada mudança nas saídas PWM; `--wav` e `--onsets` gravam o áudio
+ * do buzzer e a tabela de notas (`sim_render.h`). A saída padrão do firmware vai para stdout
+ * (`--quiet` a descarta); mensagens da simulação vão para stderr.
+ *
+ * `--soak` troca o roteiro pelo teste de longa duração (`sim_soak.h`); `--start-ms` começa o
+ * relógio virtual no instante dado, por exemplo perto da volta de 32 bits do tick em ms.
+ */
+
+/**
+ * @brief `main()` do GENIUS.c, renomeado na compilação da simulação.
+ */
+int genius_firmware_main(void);
+
+int main(int argc, char **argv) {
+    const char *script = NULL;
+    const char *pwm_path = NULL;
+    const char *wav_path = NULL;
+    const char *onsets_path = NULL;
+    bool quiet = false;
+    double soak_hours = 0;
+    uint64_t seed = 1;
+    uint64_t start_ms = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--pwm") == 0 && i + 1 < argc) {
+            pwm_path = argv[++i];
+        } else if (strcmp(argv[i], "--wav") == 0 && i + 1 < argc) {
+            wav_path = argv[++i];
+        } else if (strcmp(argv[i], "--onsets") == 0 && i + 1 < argc) {
+            onsets_path = argv[++i];
+        } else if (strcmp(argv[i], "--soak") == 0 && i + 1 < argc) {
+            soak_hours = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--start-ms") == 0 && i + 1 < argc) {
+            start_ms = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            quiet = true;
+        } else if (script == NULL) {
+            script = argv[i];
+        } else {
+            script = NULL;
+            break;
+        }
+    }
+    if ((script == NULL) == (soak_hours <= 0)) {
+        fprintf(stderr, "uso: %s <roteiro> [--pwm saida.csv] [--wav audio.wav] [--onsets notas.csv] [--quiet]\n"
+                "     %s --soak <horas> [--seed n] [--start-ms n] [--quiet]\n", argv[0], argv[0]);
+        return 2;
+    }
+
+    sim_set_time_us(start_ms * 1000);
+    if (soak_hours > 0) {
+        sim_soak_start(soak_hours, seed);
+    } else if (!sim_script_load(script)) {
+        return 2;
+    }
+    if (pwm_path) {
+        FILE *out = fopen(pwm_path, "w");
+        if (out == NULL) {
+            fprintf(stderr, "[sim] nao foi possivel criar %s\n", pwm_path);
+            return 2;
+        }
+        sim_script_set_capture(out);
+    }
+    if (!sim_render_open(wav_path, onsets_path)) {
+        return 2;
+    }
+    if (quiet && freopen("/dev/null", "w", stdout) == NULL) {
+        return 2;
+    }
+    sim_script_capture_output();
+
+    return genius_firmware_main(); // Termina no evento 'end' do roteiro ou no fim do teste
+}
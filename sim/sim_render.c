@@ -0,0 +1,159 @@
+#include "sim/sim_render.h"
+#include <math.h>
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file sim_render.c
+ * @brief Simulação no host: implementação do WAV e da tabela de notas declarados em `sim_render.h`
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define WAV_HEADER_BYTES 44
+#define SILENCE 128
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static FILE *wav, *onsets;
+static uint64_t samples_written;
+
+// Onda atual: fase em ponto fixo de 32 bits (uma volta = 2^32)
+static uint32_t phase, phase_step, duty_threshold;
+
+// Nota em andamento
+static bool sounding;
+static uint64_t note_start_us;
+static double note_freq;
+static uint32_t note_duty;
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+static void put_u16(uint16_t v) {
+    fputc(v & 0xff, wav);
+    fputc(v >> 8, wav);
+}
+
+static void put_u32(uint32_t v) {
+    put_u16(v & 0xffff);
+    put_u16(v >> 16);
+}
+
+/**
+ * @brief Grava o cabeçalho WAV (PCM mono de 8 bits) para `data_bytes` amostras.
+ */
+static void write_header(uint32_t data_bytes) {
+    fseek(wav, 0, SEEK_SET);
+    fwrite("RIFF", 1, 4, wav);
+    put_u32(WAV_HEADER_BYTES - 8 + data_bytes);
+    fwrite("WAVEfmt ", 1, 8, wav);
+    put_u32(16);                 // Tamanho do bloco fmt
+    put_u16(1);                  // PCM
+    put_u16(1);                  // Mono
+    put_u32(SIM_RENDER_RATE);
+    put_u32(SIM_RENDER_RATE);    // Bytes por segundo
+    put_u16(1);                  // Bytes por amostra
+    put_u16(8);                  // Bits por amostra
+    fwrite("data", 1, 4, wav);
+    put_u32(data_bytes);
+}
+
+/**
+ * @brief Sintetiza a onda atual até o instante `t_us`.
+ */
+static void render_until(uint64_t t_us) {
+    uint64_t target = t_us * SIM_RENDER_RATE / 1000000u;
+
+    if (wav == NULL) {
+        samples_written = target; // Sem WAV a fase não importa (relógio pode começar em dias)
+        return;
+    }
+    for (; samples_written < target; samples_written++) {
+        int value = SILENCE;
+        if (phase_step) {
+            value += phase < duty_threshold ? SIM_RENDER_AMPLITUDE : -SIM_RENDER_AMPLITUDE;
+            phase += phase_step;
+        }
+        if (wav) {
+            fputc(value, wav);
+        }
+    }
+}
+
+/**
+ * @brief Fecha a nota em andamento em `t_us`.
+ */
+static void end_note(uint64_t t_us) {
+    if (sounding && onsets) {
+        fprintf(onsets, "%llu,%llu,%.2f,%u\n", (unsigned long long)note_start_us,
+                (unsigned long long)t_us, note_freq, note_duty);
+    }
+    sounding = false;
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+bool sim_render_open(const char *wav_path, const char *onsets_path) {
+    if (wav_path) {
+        wav = fopen(wav_path, "wb");
+        if (wav == NULL) {
+            fprintf(stderr, "[sim] nao foi possivel criar %s\n", wav_path);
+            return false;
+        }
+        write_header(0); // Reescrito com o tamanho em sim_render_finish()
+    }
+    if (onsets_path) {
+        onsets = fopen(onsets_path, "w");
+        if (onsets == NULL) {
+            fprintf(stderr, "[sim] nao foi possivel criar %s\n", onsets_path);
+            return false;
+        }
+        fprintf(onsets, "inicio_us,fim_us,freq_hz,duty\n");
+    }
+    return true;
+}
+
+void sim_render_pwm(uint64_t now_us, double freq_hz, uint32_t duty_permille) {
+    render_until(now_us);
+    end_note(now_us);
+
+    if (freq_hz <= 0 || duty_permille == 0) {
+        phase_step = 0;
+        phase = 0; // A próxima nota começa do início do período
+        return;
+    }
+
+    phase_step = (uint32_t)llround(freq_hz * 4294967296.0 / SIM_RENDER_RATE);
+    duty_threshold = duty_permille >= 1000 ? UINT32_MAX : (uint32_t)(((uint64_t)duty_permille << 32) / 1000u);
+
+    sounding = true;
+    note_start_us = now_us;
+    note_freq = freq_hz;
+    note_duty = duty_permille;
+}
+
+void sim_render_finish(uint64_t end_us) {
+    render_until(end_us);
+    end_note(end_us);
+
+    if (wav) {
+        write_header((uint32_t)samples_written);
+        fclose(wav);
+        wav = NULL;
+    }
+    if (onsets) {
+        fclose(onsets);
+        onsets = NULL;
+    }
+}
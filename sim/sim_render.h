@@ -0,0 +1,61 @@
+#ifndef SIM_RENDER_H
+#define SIM_RENDER_H
+
+#include "pico/stdlib.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file sim_render.h
+ * @brief Simulação no host: áudio do buzzer em WAV e tabela de notas
+ *
+ * As mudanças na saída PWM do `BUZZER_PIN` (frequência e ciclo de trabalho, obtidos dos
+ * registradores wrap/nível/habilitação a cada escrita) são convertidas ao longo do tempo virtual em:
+ * 1. Um arquivo WAV mono de 8 bits a `SIM_RENDER_RATE` Hz, para ouvir uma mudança sem a placa.
+ * 2. Um CSV com uma linha por nota (`inicio_us,fim_us,freq_hz,duty`), com o início, o fim e a
+ *    altura de cada trecho em que o buzzer soou.
+ *
+ * O tempo é virtual e a fase da onda é acumulada em ponto fixo de 32 bits, portanto os dois
+ * arquivos são idênticos byte a byte entre execuções e podem ser comparados com as referências em
+ * `sim/golden` (ver `sim/CMakeLists.txt`).
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define SIM_RENDER_RATE 8000     // Amostras por segundo do WAV
+#define SIM_RENDER_AMPLITUDE 64  // Amplitude da onda quadrada (8 bits, centro em 128)
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Abre os arquivos de saída (qualquer um pode ser NULL).
+ *
+ * @param wav_path Caminho do WAV.
+ * @param onsets_path Caminho do CSV de notas.
+ * @return false se algum arquivo não puder ser criado.
+ */
+bool sim_render_open(const char *wav_path, const char *onsets_path);
+
+/**
+ * @brief Registra uma mudança na saída do buzzer.
+ *
+ * @param now_us Instante da mudança.
+ * @param freq_hz Nova frequência (0 = silêncio).
+ * @param duty_permille Novo ciclo de trabalho em milésimos.
+ */
+void sim_render_pwm(uint64_t now_us, double freq_hz, uint32_t duty_permille);
+
+/**
+ * @brief Completa o áudio até `end_us`, fecha a última nota e grava os arquivos.
+ *
+ * @param end_us Instante final da simulação.
+ */
+void sim_render_finish(uint64_t end_us);
+
+#endif // SIM_RENDER_H
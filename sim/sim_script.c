@@ -0,0 +1,384 @@
+#define _GNU_SOURCE // fopencookie()
+#include "sim/sim_script.h"
+#include "sim/sim_hal.h"
+#include "sim/sim_render.h"
+#include "sim/sim_soak.h"
+#include "inc/board.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file sim_script.c
+ * @brief Simulação no host: implementação do roteiro declarado em `sim_script.h`
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define SCRIPT_LINE_MAX 256
+#define TAP_DEFAULT_MS 50
+#define EXPECT_DEFAULT_TOL 1.0
+
+/******************************
+ * Estruturas
+ ******************************/
+
+typedef enum {
+    EV_DRIVE,       // a = pino, b = nível
+    EV_ADC,         // a = canal, b = valor
+    EV_KEY,         // a = caractere
+    EV_EXPECT,      // a = pino, value = Hz (0 = silêncio), tol = %
+    EV_OUTPUT,      // text = trecho esperado na saída do firmware
+    EV_END,
+} event_kind_t;
+
+typedef struct {
+    uint64_t time_us;
+    uint seq;          // Ordem no arquivo (desempate)
+    uint line;
+    event_kind_t kind;
+    uint a;
+    uint b;
+    double value;
+    double tol;
+    char *text;
+} script_event_t;
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static script_event_t *events;
+static uint event_count, event_capacity;
+static uint next_event;
+static uint expectations, failures;
+static FILE *capture;
+
+// Saída do firmware desde a última expectativa de saída atendida (só com `expect output`)
+static bool output_expected;
+static FILE *output_sink;       // stdout original (ou /dev/null com --quiet)
+static char *output_log;
+static size_t output_len, output_capacity;
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+static script_event_t *add_event(double time_ms, uint line, event_kind_t kind) {
+    if (event_count == event_capacity) {
+        event_capacity = event_capacity ? event_capacity * 2 : 64;
+        events = realloc(events, event_capacity * sizeof(*events));
+        if (events == NULL) {
+            panic("roteiro: sem memoria");
+        }
+    }
+
+    script_event_t *e = &events[event_count];
+    *e = (script_event_t){ .time_us = (uint64_t)llround(time_ms * 1000.0), .seq = event_count,
+                           .line = line, .kind = kind };
+    event_count++;
+    return e;
+}
+
+static int compare_events(const void *pa, const void *pb) {
+    const script_event_t *a = pa, *b = pb;
+    if (a->time_us != b->time_us) {
+        return a->time_us < b->time_us ? -1 : 1;
+    }
+    return a->seq < b->seq ? -1 : (a->seq > b->seq);
+}
+
+/**
+ * @brief Converte um nome ou número de pino.
+ *
+ * @return Pino, ou -1 se inválido.
+ */
+static int parse_pin(const char *name) {
+    if (strcmp(name, "a") == 0) return BUTTON_A_PIN;
+    if (strcmp(name, "b") == 0) return BUTTON_B_PIN;
+    if (strcmp(name, "joy") == 0) return JOYSTICK_BUTTON_PIN;
+    if (strcmp(name, "buzzer") == 0) return BUZZER_PIN;
+
+    char *end;
+    long pin = strtol(name, &end, 10);
+    return (*end == '\0' && pin >= 0 && pin < NUM_BANK0_GPIOS) ? (int)pin : -1;
+}
+
+/**
+ * @brief Interpreta uma linha do roteiro.
+ *
+ * @return false em caso de erro de sintaxe.
+ */
+static bool parse_line(char *text, uint line) {
+    char *hash = strchr(text, '#');
+    if (hash) {
+        *hash = '\0';
+    }
+
+    char cmd[32], arg1[32], arg2[32];
+    double time_ms;
+    int n = sscanf(text, "%lf %31s %31s %31s", &time_ms, cmd, arg1, arg2);
+    if (n <= 0) {
+        return true; // Linha vazia
+    }
+    if (n < 2 || time_ms < 0) {
+        return false;
+    }
+
+    if (strcmp(cmd, "press") == 0 || strcmp(cmd, "release") == 0 || strcmp(cmd, "tap") == 0) {
+        int pin = n >= 3 ? parse_pin(arg1) : -1;
+        if (pin < 0) {
+            return false;
+        }
+        bool press = strcmp(cmd, "release") != 0;
+        script_event_t *e = add_event(time_ms, line, EV_DRIVE);
+        e->a = pin;
+        e->b = press ? 0 : 1;
+        if (strcmp(cmd, "tap") == 0) {
+            double hold = n >= 4 ? atof(arg2) : TAP_DEFAULT_MS;
+            e = add_event(time_ms + hold, line, EV_DRIVE);
+            e->a = pin;
+            e->b = 1;
+        }
+    } else if (strcmp(cmd, "joy") == 0 && n == 4) {
+        script_event_t *e = add_event(time_ms, line, EV_ADC);
+        e->a = JOYSTICK_X_ADC;
+        e->b = atoi(arg1);
+        e = add_event(time_ms, line, EV_ADC);
+        e->a = JOYSTICK_Y_ADC;
+        e->b = atoi(arg2);
+    } else if (strcmp(cmd, "adc") == 0 && n == 4) {
+        script_event_t *e = add_event(time_ms, line, EV_ADC);
+        e->a = atoi(arg1);
+        e->b = atoi(arg2);
+    } else if (strcmp(cmd, "key") == 0 && n >= 3) {
+        script_event_t *e = add_event(time_ms, line, EV_KEY);
+        e->a = (unsigned char)arg1[0];
+    } else if (strcmp(cmd, "expect") == 0 && n >= 4 && strcmp(arg1, "output") == 0) {
+        char *start = strstr(strstr(text, cmd) + strlen(cmd), arg1) + strlen(arg1);
+        start += strspn(start, " \t");
+        size_t len = strlen(start);
+        while (len > 0 && strchr(" \t\r\n", start[len - 1])) {
+            len--;
+        }
+        script_event_t *e = add_event(time_ms, line, EV_OUTPUT);
+        e->text = strndup(start, len);
+        output_expected = true;
+    } else if (strcmp(cmd, "expect") == 0 && n >= 4) {
+        int pin = parse_pin(arg1);
+        if (pin < 0) {
+            return false;
+        }
+        script_event_t *e = add_event(time_ms, line, EV_EXPECT);
+        e->a = pin;
+        e->value = strcmp(arg2, "off") == 0 ? 0 : atof(arg2);
+        e->tol = EXPECT_DEFAULT_TOL;
+        double tol;
+        if (sscanf(text, "%*f %*s %*s %*s %lf", &tol) == 1) {
+            e->tol = tol;
+        }
+    } else if (strcmp(cmd, "end") == 0) {
+        add_event(time_ms, line, EV_END);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Verifica uma expectativa contra a saída PWM atual.
+ */
+static void check_expect(const script_event_t *e) {
+    double freq = 0;
+    uint32_t duty = 0;
+    bool is_pwm = sim_pwm_output(e->a, &freq, &duty);
+    bool ok;
+
+    expectations++;
+    if (e->value == 0) {
+        ok = is_pwm ? freq == 0 : true;
+    } else {
+        ok = is_pwm && fabs(freq - e->value) <= e->value * e->tol / 100.0;
+    }
+
+    if (!ok) {
+        failures++;
+        fprintf(stderr, "[sim] FALHA linha %u (%.3f ms): pino %u em %.2f Hz, esperado ",
+                e->line, e->time_us / 1000.0, e->a, freq);
+        if (e->value == 0) {
+            fprintf(stderr, "silencio\n");
+        } else {
+            fprintf(stderr, "%.2f Hz +-%.1f%%\n", e->value, e->tol);
+        }
+    }
+}
+
+/**
+ * @brief Recebe a saída do firmware: guarda para `expect output` e repassa ao stdout original.
+ */
+static ssize_t output_write(void *cookie, const char *buf, size_t size) {
+    (void)cookie;
+    if (output_len + size > output_capacity) {
+        output_capacity = (output_len + size) * 2;
+        output_log = realloc(output_log, output_capacity);
+        if (output_log == NULL) {
+            panic("saida: sem memoria");
+        }
+    }
+    memcpy(output_log + output_len, buf, size);
+    output_len += size;
+    fwrite(buf, 1, size, output_sink);
+    return (ssize_t)size;
+}
+
+/**
+ * @brief Procura o trecho na saída desde a última expectativa de saída atendida.
+ *
+ * Se encontrado, a saída até o fim do trecho é descartada: expectativas seguidas conferem a ordem.
+ */
+static void check_output(const script_event_t *e) {
+    fflush(stdout);
+    expectations++;
+
+    size_t len = strlen(e->text);
+    for (size_t i = 0; len <= output_len && i <= output_len - len; i++) {
+        if (memcmp(output_log + i, e->text, len) == 0) {
+            output_len -= i + len;
+            memmove(output_log, output_log + i + len, output_len);
+            return;
+        }
+    }
+    failures++;
+    fprintf(stderr, "[sim] FALHA linha %u (%.3f ms): saida sem \"%s\"\n", e->line, e->time_us / 1000.0,
+            e->text);
+}
+
+/**
+ * @brief Encerra a simulação com o resultado das expectativas.
+ */
+static void finish(uint64_t now_us) {
+    sim_pwm_capture();
+    sim_render_finish(now_us);
+    fflush(stdout);
+    if (capture) {
+        fclose(capture);
+    }
+
+    fprintf(stderr, "\n[sim] fim em %.3f ms: %u eventos, %u expectativas, %u falhas\n",
+            now_us / 1000.0, event_count, expectations, failures);
+    exit(failures ? 1 : 0);
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+bool sim_script_load(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        fprintf(stderr, "[sim] nao foi possivel abrir %s\n", path);
+        return false;
+    }
+
+    char text[SCRIPT_LINE_MAX];
+    uint line = 0;
+    bool ok = true, has_end = false;
+    while (fgets(text, sizeof(text), f)) {
+        line++;
+        if (!parse_line(text, line)) {
+            fprintf(stderr, "[sim] %s:%u: linha invalida\n", path, line);
+            ok = false;
+        }
+    }
+    fclose(f);
+
+    qsort(events, event_count, sizeof(*events), compare_events);
+    for (uint i = 0; i < event_count; i++) {
+        has_end |= events[i].kind == EV_END;
+    }
+    if (!has_end) {
+        fprintf(stderr, "[sim] %s: falta o evento 'end'\n", path);
+        ok = false;
+    }
+    return ok;
+}
+
+void sim_script_capture_output() {
+    if (!output_expected) {
+        return;
+    }
+    output_sink = stdout;
+    FILE *out = fopencookie(NULL, "w", (cookie_io_functions_t){ .write = output_write });
+    if (out == NULL) {
+        panic("saida: fopencookie");
+    }
+    setvbuf(out, NULL, _IOLBF, 0);
+    stdout = out;
+}
+
+void sim_script_set_capture(FILE *out) {
+    capture = out;
+    if (capture) {
+        fprintf(capture, "tempo_us,pino,freq_hz,duty\n");
+    }
+}
+
+/******************************
+ * Ganchos do HAL simulado
+ ******************************/
+
+uint64_t sim_script_next_us() {
+    if (sim_soak_active()) {
+        return sim_soak_next_us();
+    }
+    return next_event < event_count ? events[next_event].time_us : UINT64_MAX;
+}
+
+void sim_script_apply(uint64_t now_us) {
+    if (sim_soak_active()) {
+        sim_soak_apply(now_us);
+        return;
+    }
+    while (next_event < event_count && events[next_event].time_us <= now_us) {
+        const script_event_t *e = &events[next_event++];
+
+        switch (e->kind) {
+            case EV_DRIVE:
+                sim_gpio_drive(e->a, e->b);
+                break;
+            case EV_ADC:
+                sim_adc_set(e->a, e->b);
+                break;
+            case EV_KEY:
+                sim_serial_push(e->a);
+                break;
+            case EV_EXPECT:
+                check_expect(e);
+                break;
+            case EV_OUTPUT:
+                check_output(e);
+                break;
+            case EV_END:
+                finish(now_us);
+                break;
+        }
+    }
+}
+
+void sim_script_pwm_changed(uint64_t now_us, uint gpio, double freq_hz, uint32_t duty_permille) {
+    if (capture) {
+        fprintf(capture, "%llu,%u,%.3f,%u\n", (unsigned long long)now_us, gpio, freq_hz, duty_permille);
+    }
+    if (gpio == BUZZER_PIN) {
+        sim_render_pwm(now_us, freq_hz, duty_permille);
+    }
+    if (sim_soak_active()) {
+        sim_soak_pwm_changed(now_us, gpio, freq_hz);
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef SIM_SCRIPT_H
+#define SIM_SCRIPT_H
+
+#include "pico/stdlib.h"
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file sim_script.h
+ * @brief Simulação no host: roteiro de entradas, expectativas e captura do PWM
+ *
+ * Um roteiro é um arquivo texto com um evento por linha, em ordem qualquer (são ordenados pelo
+ * instante; eventos no mesmo instante mantêm a ordem do arquivo). `#` inicia um comentário.
+ *
+ *     <ms> press <pino>               Pressiona um botão (nível 0; botões usam pull-up)
+ *     <ms> release <pino>             Solta o botão
+ *     <ms> tap <pino> [duração_ms]    Pressiona e solta após a duração (padrão 50 ms)
+ *     <ms> joy <x> <y>                Valores de 12 bits dos eixos do joystick
+ *     <ms> adc <canal> <valor>        Valor de 12 bits de um canal do ADC
+ *     <ms> key <caractere>            Caractere recebido pela serial
+ *     <ms> expect <pino> off          A saída PWM do pino deve estar em silêncio
+ *     <ms> expect <pino> <hz> [tol%]  A saída PWM deve estar em `hz` (tolerância padrão 1%)
+ *     <ms> expect output <texto>      O firmware deve ter impresso `texto` desde a última
+ *                                     expectativa de saída atendida (confere a ordem)
+ *     <ms> end                        Fim da simulação (obrigatório)
+ *
+ * Pinos podem ser números ou nomes da placa: `a`, `b`, `joy` e `buzzer` (`board.h`).
+ *
+ * Ao final, o processo termina com código 0 se todas as expectativas foram atendidas e 1 caso
+ * contrário.
+ */
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Carrega e ordena um roteiro.
+ *
+ * @param path Caminho do arquivo.
+ * @return false se o arquivo não puder ser lido ou tiver erros (mensagens em stderr).
+ */
+bool sim_script_load(const char *path);
+
+/**
+ * @brief Passa a guardar a saída padrão do firmware, se o roteiro tiver `expect output`.
+ *
+ * Chamada depois de `--quiet` redirecionar o stdout: a saída continua indo para ele.
+ */
+void sim_script_capture_output();
+
+/**
+ * @brief Define o arquivo CSV que recebe as mudanças na saída PWM (`tempo_us,pino,freq_hz,duty`).
+ *
+ * @param out Arquivo aberto para escrita, ou NULL para não capturar.
+ */
+void sim_script_set_capture(FILE *out);
+
+#endif // SIM_SCRIPT_H
@@ -0,0 +1,505 @@
+#include "sim/sim_soak.h"
+#include "sim/sim_hal.h"
+#include "inc/board.h"
+#include "inc/songs.h"
+#include "inc/scheduler.h"
+#include "inc/timer_wheel.h"
+#include <malloc.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file sim_soak.c
+ * @brief Simulação no host: implementação do teste de longa duração declarado em `sim_soak.h`
+ *
+ * O gerador mantém um modelo do reprodutor (música selecionada, tocando ou não, próxima nota e
+ * seu instante ideal) e só age em instantes em que o comportamento esperado não é ambíguo. Todas
+ * as ações têm instante próprio; `sim_soak_next_us()` devolve o menor deles.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define SOAK_WARMUP_US 1000000            // Linha de base após a inicialização do firmware
+#define SOAK_IDLE_MIN_US 300000           // Espera antes de uma ação com o instrumento parado
+#define SOAK_IDLE_MAX_US 1000000
+#define SOAK_HOLD_MIN_US 30000            // Duração de cada toque
+#define SOAK_HOLD_MAX_US 120000
+#define SOAK_REPRESS_US 250000            // Soltura -> novo toque (bem acima do debounce padrão)
+#define SOAK_STOP_AFTER_US (SOAK_HOLD_MAX_US + SOAK_REPRESS_US) // Início -> pausa ou troca, já sem debounce
+#define SOAK_STOP_GUARD_US 3000           // Distância mínima entre uma pausa e o início de uma nota
+#define SOAK_JOY_MIN_US 50000             // Intervalo entre mudanças do joystick
+#define SOAK_JOY_MAX_US 700000
+#define SOAK_ADC_GUARD_US 1000            // Mudança do eixo X tão perto de uma nota: altura não conferida
+#define SOAK_KEY_MIN_US 60000000ull       // Intervalo entre relatórios pela serial
+#define SOAK_KEY_MAX_US 600000000ull
+#define SOAK_DRIFT_SLACK_US 250           // Variação aceita no erro médio por hora
+#define SOAK_MAX_COUNTERS (SCHED_MAX_TASKS + 2)
+#define SOAK_MAX_REPORTS 20               // Falhas descritas individualmente
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Próxima ação sobre os botões.
+ */
+typedef enum {
+    ACTION_NONE = 0,
+    ACTION_NEXT_SONG,   // Toque em A
+    ACTION_PLAY_PAUSE,  // Toque em B
+} soak_action_t;
+
+/**
+ * @brief Contador do firmware acompanhado entre as verificações.
+ */
+typedef struct {
+    const char *name;
+    uint32_t first;     // Valor na linha de base
+    uint32_t last;      // Valor na verificação anterior
+} soak_counter_t;
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static bool active;
+static uint64_t rng_state;
+static uint64_t start_us, end_us;
+static struct timespec wall_start;
+static uint failures;
+
+// Entradas
+static soak_action_t action;
+static uint64_t action_us;
+static uint release_pin;
+static uint64_t release_us = UINT64_MAX;
+static uint64_t joy_us, key_us;
+static uint16_t joy_x = 2048;
+static uint64_t joy_changed_us;
+static uint key_count;
+
+// Modelo do reprodutor
+static uint song;
+static bool playing;
+static int next_note = -1;        // Próxima nota com som, ou -1
+static uint64_t next_onset_us;    // Instante ideal do seu início
+static uint64_t song_end_us;      // Instante ideal do fim da música
+
+// Verificações
+static uint64_t checkpoint_us;
+static bool has_baseline;
+static uint64_t baseline_us;
+static soak_counter_t counters[SOAK_MAX_COUNTERS];
+static uint counter_count;
+static uint32_t task_runs0[SCHED_MAX_TASKS];
+static size_t stack_first, heap_first;
+static uint hour;
+static bool has_first_hour;
+static int64_t first_mean_err;
+
+// Notas da hora atual
+static uint64_t notes_total;
+static uint32_t hour_notes, hour_checked;
+static int64_t hour_err_sum;
+static uint32_t hour_err_max;
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Gerador xorshift64* (determinístico para uma semente).
+ */
+static uint64_t rng_next() {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545F4914F6CDD1Dull;
+}
+
+/**
+ * @brief Valor uniforme em [lo, hi].
+ */
+static uint64_t rng_range(uint64_t lo, uint64_t hi) {
+    return lo + rng_next() % (hi - lo + 1);
+}
+
+static double elapsed_s(uint64_t now_us) {
+    return (now_us - start_us) / 1e6;
+}
+
+/**
+ * @brief Registra uma falha; as primeiras são descritas em stderr.
+ */
+static void fail(uint64_t now_us, const char *what, long long value) {
+    failures++;
+    if (failures <= SOAK_MAX_REPORTS) {
+        fprintf(stderr, "[soak] FALHA em %.6f s: %s (%lld)\n", elapsed_s(now_us), what, value);
+    }
+}
+
+/**
+ * @brief Procura a próxima nota com som a partir de `note` e calcula seu instante ideal.
+ *
+ * @param note Índice da primeira candidata.
+ * @param t Instante ideal do início da nota `note`.
+ */
+static void expect_from(int note, uint64_t t) {
+    const Melody *m = &melodies[song];
+
+    while (note < m->length && m->melody[note] == 0) {
+        t += 2000ull * m->durations[note];
+        note++;
+    }
+    next_note = note < m->length ? note : -1;
+    next_onset_us = t;
+}
+
+/**
+ * @brief Duração ideal da música selecionada, com o silêncio da última nota.
+ */
+static uint64_t song_length_us() {
+    const Melody *m = &melodies[song];
+    uint64_t total = 0;
+
+    for (int n = 0; n < m->length; n++) {
+        total += 2000ull * m->durations[n];
+    }
+    return total;
+}
+
+/**
+ * @brief Afasta `t` do início ideal das notas da música que começou em `play_us`.
+ *
+ * @return O próprio `t`, ou o primeiro instante depois dele a mais de `SOAK_STOP_GUARD_US` de
+ *         qualquer início de nota.
+ */
+static uint64_t clear_of_onsets(uint64_t t, uint64_t play_us) {
+    const Melody *m = &melodies[song];
+    uint64_t onset = play_us;
+
+    for (int n = 0; n < m->length; n++) {
+        if (m->melody[n] > 0 && t + SOAK_STOP_GUARD_US > onset && t < onset + SOAK_STOP_GUARD_US) {
+            t = onset + SOAK_STOP_GUARD_US; // As notas duram no mínimo dezenas de ms
+        }
+        onset += 2000ull * m->durations[n];
+    }
+    return t;
+}
+
+/**
+ * @brief Agenda a próxima ação com o instrumento parado.
+ */
+static void plan_idle(uint64_t after_us) {
+    action = rng_range(0, 3) == 0 ? ACTION_NEXT_SONG : ACTION_PLAY_PAUSE;
+    action_us = after_us + rng_range(SOAK_IDLE_MIN_US, SOAK_IDLE_MAX_US);
+}
+
+/**
+ * @brief Agenda o que acontece com a música que começou em `play_us`.
+ *
+ * Metade das vezes ela vai até o fim; nas demais é interrompida por B (pausa) ou A (troca).
+ */
+static void plan_playing(uint64_t play_us) {
+    uint64_t earliest = play_us + SOAK_STOP_AFTER_US;
+    uint64_t latest = song_end_us - SOAK_STOP_GUARD_US;
+
+    if (rng_range(0, 1) == 0 && earliest < latest) {
+        uint64_t t = clear_of_onsets(rng_range(earliest, latest), play_us);
+        if (t < latest) {
+            action = rng_range(0, 2) == 0 ? ACTION_NEXT_SONG : ACTION_PLAY_PAUSE;
+            action_us = t;
+            return;
+        }
+    }
+    plan_idle(song_end_us);
+}
+
+/**
+ * @brief Toca um botão e atualiza o modelo do reprodutor.
+ */
+static void do_action(uint64_t now_us) {
+    uint pin = action == ACTION_NEXT_SONG ? BUTTON_A_PIN : BUTTON_B_PIN;
+
+    sim_gpio_drive(pin, 0);
+    release_pin = pin;
+    release_us = now_us + rng_range(SOAK_HOLD_MIN_US, SOAK_HOLD_MAX_US);
+
+    if (action == ACTION_NEXT_SONG) {
+        song = (song + 1) % SONG_COUNT;
+        playing = false;
+        next_note = -1;
+    } else if (playing) {
+        playing = false;
+        next_note = -1;
+    } else {
+        playing = true;
+        song_end_us = now_us + song_length_us();
+        expect_from(0, now_us);
+    }
+
+    if (playing) {
+        plan_playing(now_us);
+    } else {
+        plan_idle(now_us);
+    }
+    // O mesmo pino só volta a ser tocado depois do debounce da soltura
+    if (action_us < release_us + SOAK_REPRESS_US) {
+        action_us = release_us + SOAK_REPRESS_US;
+    }
+}
+
+/**
+ * @brief Registra um contador do firmware na linha de base.
+ */
+static void add_counter(const char *name, uint32_t value) {
+    counters[counter_count++] = (soak_counter_t){ .name = name, .first = value, .last = value };
+}
+
+/**
+ * @brief Lê os contadores na mesma ordem de `take_baseline()`.
+ */
+static uint read_counters(uint32_t *values) {
+    uint n = 0;
+    const scheduler_task_t *task;
+    timer_wheel_stats_t wheel = timer_wheel_stats();
+
+    for (uint i = 0; (task = scheduler_task_at(i)) != NULL && n < SCHED_MAX_TASKS; i++) {
+        values[n++] = task->runs;
+    }
+    values[n++] = wheel.wakeups;
+    values[n++] = wheel.expirations;
+    return n;
+}
+
+/**
+ * @brief Linha de base das verificações, depois da inicialização do firmware.
+ */
+static void take_baseline(uint64_t now_us) {
+    uint32_t values[SOAK_MAX_COUNTERS];
+    uint n = read_counters(values);
+    const scheduler_task_t *task;
+
+    counter_count = 0;
+    for (uint i = 0; i < n; i++) {
+        task = scheduler_task_at(i);
+        add_counter(task ? task->name : (i == n - 2 ? "despertares" : "expiracoes"), values[i]);
+        if (task) {
+            task_runs0[i] = task->runs;
+        }
+    }
+    sim_stack_take_peak(); // Descarta a inicialização
+    baseline_us = now_us;
+    has_baseline = true;
+}
+
+/**
+ * @brief Verificação horária: deriva, contadores, pilha, heap e erro das notas.
+ */
+static void checkpoint(uint64_t now_us) {
+    uint32_t values[SOAK_MAX_COUNTERS];
+    uint n = read_counters(values);
+    uint64_t span_us = now_us - baseline_us;
+    double min_wrap_days = 1e9;
+    const scheduler_task_t *task;
+
+    hour++;
+
+    // Tarefas periódicas: uma execução por período desde a linha de base
+    for (uint i = 0; (task = scheduler_task_at(i)) != NULL; i++) {
+        if (task->period_ms == 0) {
+            continue;
+        }
+        int64_t expected = span_us / (task->period_ms * 1000ull);
+        int64_t drift = (int64_t)(uint32_t)(task->runs - task_runs0[i]) - expected;
+        if (drift < -1 || drift > 1) {
+            fail(now_us, task->name, drift);
+        }
+    }
+
+    // Contadores: monotônicos e longe da volta no ritmo medido
+    for (uint i = 0; i < n && i < counter_count; i++) {
+        if (values[i] < counters[i].last) {
+            fail(now_us, counters[i].name, values[i]);
+        }
+        counters[i].last = values[i];
+
+        double per_day = (values[i] - counters[i].first) * 86400e6 / span_us;
+        double wrap_days = per_day > 0 ? 4294967296.0 / per_day : 1e9;
+        if (wrap_days < min_wrap_days) {
+            min_wrap_days = wrap_days;
+        }
+        if (wrap_days < SOAK_MIN_WRAP_DAYS) {
+            fail(now_us, counters[i].name, (long long)wrap_days);
+        }
+    }
+
+    // Pilha e heap do host: nada cresce depois da primeira hora
+    size_t stack = sim_stack_take_peak();
+    size_t heap = mallinfo2().uordblks;
+    if (hour == 1) {
+        stack_first = stack;
+        heap_first = heap;
+    } else {
+        if (stack > stack_first + SOAK_STACK_SLACK) {
+            fail(now_us, "pilha cresceu", (long long)stack);
+        }
+        if (heap > heap_first) {
+            fail(now_us, "heap cresceu", (long long)heap);
+        }
+    }
+
+    // Deriva das notas: o erro médio da hora não se afasta do da primeira hora
+    int64_t mean_err = hour_checked ? hour_err_sum / (int64_t)hour_checked : 0;
+    if (hour_checked && !has_first_hour) {
+        first_mean_err = mean_err;
+        has_first_hour = true;
+    } else if (hour_checked && llabs(mean_err - first_mean_err) > SOAK_DRIFT_SLACK_US) {
+        fail(now_us, "erro medio das notas mudou", mean_err);
+    }
+
+    fprintf(stderr, "[soak] %3u h: %6lu notas | erro medio %5lld us max %4lu us | pilha %5zu B | "
+            "heap %7zu B | volta em %5.0f dias | falhas %u\n",
+            hour, (unsigned long)hour_notes, (long long)mean_err, (unsigned long)hour_err_max, stack,
+            heap, min_wrap_days, failures);
+
+    hour_notes = hour_checked = 0;
+    hour_err_sum = 0;
+    hour_err_max = 0;
+}
+
+/**
+ * @brief Encerra o teste com o resumo e o ritmo da simulação.
+ */
+static void finish(uint64_t now_us) {
+    struct timespec wall_end;
+    clock_gettime(CLOCK_MONOTONIC, &wall_end);
+    double wall_s = (wall_end.tv_sec - wall_start.tv_sec) + (wall_end.tv_nsec - wall_start.tv_nsec) / 1e9;
+    double sim_h = (now_us - start_us) / 3.6e9;
+
+    fflush(stdout);
+    fprintf(stderr, "\n[soak] fim: %.2f h simuladas em %.2f s (%.1f h/s) | %llu notas | %u falhas\n",
+            sim_h, wall_s, wall_s > 0 ? sim_h / wall_s : 0, (unsigned long long)notes_total, failures);
+    exit(failures ? 1 : 0);
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+void sim_soak_start(double hours, uint64_t seed) {
+    active = true;
+    rng_state = seed ? seed : 1;
+    start_us = time_us_64();
+    end_us = start_us + (uint64_t)(hours * 3.6e9);
+    checkpoint_us = start_us + SOAK_WARMUP_US;
+    joy_us = start_us + rng_range(SOAK_JOY_MIN_US, SOAK_JOY_MAX_US);
+    key_us = start_us + rng_range(SOAK_KEY_MIN_US, SOAK_KEY_MAX_US);
+    plan_idle(start_us + SOAK_WARMUP_US);
+    clock_gettime(CLOCK_MONOTONIC, &wall_start);
+}
+
+bool sim_soak_active() {
+    return active;
+}
+
+uint64_t sim_soak_next_us() {
+    uint64_t next = end_us;
+
+    if (checkpoint_us < next) next = checkpoint_us;
+    if (action_us < next) next = action_us;
+    if (release_us < next) next = release_us;
+    if (joy_us < next) next = joy_us;
+    if (key_us < next) next = key_us;
+    if (next_note >= 0 && next_onset_us + SOAK_ONSET_TOL_US + 1 < next) {
+        next = next_onset_us + SOAK_ONSET_TOL_US + 1; // Prazo da próxima nota
+    }
+    return next;
+}
+
+void sim_soak_apply(uint64_t now_us) {
+    // Nota esperada que não começou dentro da tolerância: conta e segue para a próxima
+    while (next_note >= 0 && now_us > next_onset_us + SOAK_ONSET_TOL_US) {
+        fail(now_us, "nota nao tocou", next_note);
+        expect_from(next_note + 1, next_onset_us + 2000ull * melodies[song].durations[next_note]);
+    }
+    if (playing && now_us >= song_end_us) {
+        playing = false;
+    }
+
+    if (release_us <= now_us) {
+        sim_gpio_drive(release_pin, 1);
+        release_us = UINT64_MAX;
+    }
+    if (action_us <= now_us) {
+        do_action(now_us);
+    }
+    if (joy_us <= now_us) {
+        joy_x = rng_range(0, 4095);
+        sim_adc_set(JOYSTICK_X_ADC, joy_x);
+        sim_adc_set(JOYSTICK_Y_ADC, rng_range(0, 4095));
+        joy_changed_us = now_us;
+        joy_us = now_us + rng_range(SOAK_JOY_MIN_US, SOAK_JOY_MAX_US);
+    }
+    if (key_us <= now_us) {
+        sim_serial_push(key_count++ % 2 ? 'w' : 't');
+        key_us = now_us + rng_range(SOAK_KEY_MIN_US, SOAK_KEY_MAX_US);
+    }
+
+    if (checkpoint_us <= now_us) {
+        if (!has_baseline) {
+            take_baseline(now_us);
+        } else {
+            checkpoint(now_us);
+        }
+        checkpoint_us = now_us + SOAK_CHECKPOINT_US;
+    }
+    if (now_us >= end_us) {
+        finish(now_us);
+    }
+}
+
+void sim_soak_pwm_changed(uint64_t now_us, uint gpio, double freq_hz) {
+    static double previous;
+
+    if (gpio != BUZZER_PIN) {
+        return;
+    }
+    bool onset = previous == 0 && freq_hz > 0;
+    previous = freq_hz;
+    if (!onset) {
+        return;
+    }
+
+    notes_total++;
+    hour_notes++;
+    int64_t err = (int64_t)(now_us - next_onset_us);
+    if (next_note < 0 || err < -SOAK_ONSET_TOL_US) {
+        fail(now_us, "nota inesperada", (long long)freq_hz);
+        return;
+    }
+
+    // Mesmo cálculo do reprodutor: nota * (0.5 + x / 4095), truncado para inteiro
+    int original = melodies[song].melody[next_note];
+    int expected = original * (0.5f + (joy_x / 4095.0f));
+    if (now_us - joy_changed_us > SOAK_ADC_GUARD_US &&
+        fabs(freq_hz - expected) * 100 > expected * SOAK_FREQ_TOL_PCT) {
+        fail(now_us, "frequencia da nota", (long long)freq_hz);
+    }
+
+    hour_checked++;
+    hour_err_sum += err;
+    uint32_t abs_err = err < 0 ? -err : err;
+    if (abs_err > hour_err_max) {
+        hour_err_max = abs_err;
+    }
+    expect_from(next_note + 1, next_onset_us + 2000ull * melodies[song].durations[next_note]);
+}
@@ -0,0 +1,94 @@
+#ifndef SIM_SOAK_H
+#define SIM_SOAK_H
+
+#include "pico/stdlib.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file sim_soak.h
+ * @brief Simulação no host: teste de longa duração com entradas aleatórias
+ *
+ * Substitui o roteiro por um gerador de entradas que percorre as músicas sem parar durante o
+ * tempo virtual pedido (dias, se necessário):
+ * 1. Com o instrumento parado: toques em A (troca de música) ou em B (início), 300-1000 ms após
+ *    o último evento, com 30-120 ms de pressão e respeitando o debounce de cada pino.
+ * 2. Com uma música tocando: ela vai até o fim ou é interrompida por B (pausa) ou A (troca) em
+ *    um instante aleatório longe de qualquer início de nota.
+ * 3. Eixos do joystick em valores aleatórios a cada 50-700 ms e os relatórios 't' e 'w' pela
+ *    serial a cada poucos minutos.
+ *
+ * O gerador conhece o comportamento esperado do reprodutor e confere cada início de nota no
+ * buzzer (transição de silêncio para som):
+ * - Instante: a linha do tempo ideal é o toque em B mais `2 * duração` por nota, sem acúmulo; o
+ *   erro não pode passar de `SOAK_ONSET_TOL_US`, e o erro médio de cada hora não pode se afastar
+ *   do da primeira hora (deriva).
+ * - Altura: a nota da música multiplicada pelo fator do eixo X, com tolerância de 1%.
+ * - Eventos perdidos: nota esperada que não começou até o fim da tolerância.
+ * - Eventos inesperados: nota que começou com o instrumento parado ou fora da linha do tempo.
+ *
+ * A cada hora simulada (`SOAK_CHECKPOINT_US`) são verificados:
+ * - Deriva das tarefas periódicas: execuções desde o início iguais a tempo / período (±1).
+ * - Contadores (execuções das tarefas, despertares e expirações da roda de temporizadores):
+ *   nunca diminuem e, no ritmo medido, levam ao menos `SOAK_MIN_WRAP_DAYS` para dar a volta.
+ * - Pilha (`sim_stack_take_peak()`) e heap do host (`mallinfo2()`): não crescem depois da
+ *   primeira hora.
+ *
+ * O relógio pode começar perto da volta do tick de 32 bits da roda (`--start-ms`), e
+ * `time_us_32()` dá a volta a cada 71,6 minutos de qualquer forma. Ao fim é impresso o ritmo em
+ * horas simuladas por segundo de relógio, e o processo termina com código 1 se houve falhas.
+ *
+ *     GENIUS_sim --soak 72 --seed 7 --quiet      # três dias, alguns minutos de relógio
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define SOAK_CHECKPOINT_US 3600000000ull  // Uma hora simulada entre verificações
+#define SOAK_ONSET_TOL_US 2000            // Erro máximo no instante de início das notas
+#define SOAK_FREQ_TOL_PCT 1               // Erro máximo na frequência das notas
+#define SOAK_STACK_SLACK 1024             // Folga da pilha sobre a primeira hora, em bytes
+#define SOAK_MIN_WRAP_DAYS 365            // Tempo mínimo para um contador de 32 bits dar a volta
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Ativa o teste no lugar do roteiro. Chamar antes de iniciar o firmware.
+ *
+ * @param hours Duração em horas simuladas.
+ * @param seed Semente do gerador de entradas (a mesma semente repete a mesma execução).
+ */
+void sim_soak_start(double hours, uint64_t seed);
+
+/**
+ * @brief Indica se o teste de longa duração substitui o roteiro.
+ */
+bool sim_soak_active();
+
+/**
+ * @brief Instante (us) da próxima ação do teste: entrada, prazo de uma nota ou verificação.
+ */
+uint64_t sim_soak_next_us();
+
+/**
+ * @brief Executa as ações do teste com instante até `now_us`.
+ *
+ * @param now_us Tempo virtual atual.
+ */
+void sim_soak_apply(uint64_t now_us);
+
+/**
+ * @brief Recebe uma mudança na saída PWM de um pino e confere os inícios de nota do buzzer.
+ *
+ * @param now_us Instante da mudança.
+ * @param gpio Pino.
+ * @param freq_hz Nova frequência (0 = silêncio).
+ */
+void sim_soak_pwm_changed(uint64_t now_us, uint gpio, double freq_hz);
+
+#endif // SIM_SOAK_H
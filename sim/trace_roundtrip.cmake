@@ -0,0 +1,64 @@
+# Ida e volta do registro de entradas (input_trace.h): executa um roteiro que grava ('r') e imprime
+# ('o') o registro, executa o roteiro impresso e compara a tabela de notas das duas execuções.
+# Uso (registrado pelo sim/CMakeLists.txt):
+#
+#   cmake -DSIM=<GENIUS_sim> -DSCRIPT=<roteiro.txt> -DOUT=<dir> -P trace_roundtrip.cmake
+#
+# As linhas `key` antes do primeiro `key r` (o modo em que a gravação começou) são repetidas no
+# início do roteiro impresso, que só contém as entradas.
+
+get_filename_component(name ${SCRIPT} NAME_WE)
+file(MAKE_DIRECTORY ${OUT})
+
+execute_process(COMMAND ${SIM} ${SCRIPT} --onsets ${OUT}/${name}.record.csv
+                OUTPUT_VARIABLE output
+                RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "GENIUS_sim terminou com codigo ${result} na gravacao")
+endif()
+
+set(replay "")
+file(STRINGS ${SCRIPT} script_lines)
+foreach (line ${script_lines})
+    if (line MATCHES "^ *[0-9.]+ +key +r( |$)")
+        break()
+    endif()
+    if (line MATCHES "^ *[0-9.]+ +key ")
+        string(APPEND replay "${line}\n")
+    endif()
+endforeach()
+
+# O registro vai da linha "# Registro de entradas" até a linha "end", no meio da saída da tarefa
+# de status (que usa '\r')
+string(REPLACE "\r" "\n" output "${output}")
+string(REPLACE ";" "," output "${output}")
+string(REPLACE "\n" ";" output_lines "${output}")
+set(copying OFF)
+foreach (line ${output_lines})
+    if (line MATCHES "^# Registro de entradas")
+        set(copying ON)
+    endif()
+    if (copying)
+        string(APPEND replay "${line}\n")
+        if (line MATCHES "^[0-9]+ end$")
+            break()
+        endif()
+    endif()
+endforeach()
+if (NOT copying)
+    message(FATAL_ERROR "Registro nao encontrado na saida de ${SCRIPT}")
+endif()
+file(WRITE ${OUT}/${name}.replay.txt "${replay}")
+
+execute_process(COMMAND ${SIM} ${OUT}/${name}.replay.txt --quiet --onsets ${OUT}/${name}.replay.csv
+                RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "GENIUS_sim terminou com codigo ${result} na reproducao")
+endif()
+
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${OUT}/${name}.record.csv ${OUT}/${name}.replay.csv
+                RESULT_VARIABLE different)
+if (different)
+    message(FATAL_ERROR "A reproducao do registro difere da gravacao: compare ${OUT}/${name}.record.csv "
+            "e ${OUT}/${name}.replay.csv (roteiro em ${OUT}/${name}.replay.txt)")
+endif()
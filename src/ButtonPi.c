@@ -67,7 +67,6 @@ bool ButtonPi_read(ButtonPi *btn) {
 void ButtonPi_attach_callback(ButtonPi *btn, void (*callback)(void)) {
     gpio_irq_manager_init(); // Garante que o gerenciador de interrupções esteja inicializado
 
-    if (btn->pin < 30) { // Verifica se o pino é válido (pinos GPIO válidos no Raspberry Pi Pico)
-        register_gpio_callback(btn->pin, callback, GPIO_IRQ_EDGE_FALL); // Configura a interrupção na borda de descida
-    }
+    // Os pinos dos botões são validados em tempo de compilação (board.h)
+    register_gpio_callback(btn->pin, callback, GPIO_IRQ_EDGE_FALL); // Configura a interrupção na borda de descida
 }
@@ -1,5 +1,7 @@
 #include "inc/BuzzerPi.h"
+#include "inc/genius_config.h"
 #include "hardware/clocks.h"
+#include "hardware/sync.h"
 #include <stdio.h>
 
 /******************************
@@ -46,7 +48,7 @@ void initialize_pwm(uint pin) {
  * @param clkdiv Divisor de clock usado para o PWM.
  * @return Valor de "wrap" calculado. Se o valor exceder 65535, retorna 65535.
  */
-uint16_t calculate_wrap(uint32_t target_frequency, float clkdiv) {
+uint16_t GENIUS_HOT_FUNC(calculate_wrap)(uint32_t target_frequency, float clkdiv) {
     uint32_t clock_freq = clock_get_hz(clk_sys); // Obtém a frequência do clock do sistema
     uint32_t wrap = (clock_freq / (target_frequency * clkdiv)) - 1; // Calcula o valor de wrap
     return (wrap > 65535) ? 65535 : wrap; // Limita o valor de wrap a 65535 (máximo suportado)
@@ -61,19 +63,43 @@ uint16_t calculate_wrap(uint32_t target_frequency, float clkdiv) {
  * @param freq Frequência do tom em Hz.
  * @param duration_ms Duração do tom em milissegundos.
  */
-void play_tone(uint pin, uint32_t freq, uint duration_ms) {
-    uint slice_num = pwm_gpio_to_slice_num(pin); // Obtém o número do slice PWM associado ao pino
+void GENIUS_HOT_FUNC(play_tone)(uint pin, uint32_t freq, uint duration_ms) {
+    start_tone(pin, freq); // Liga o tom
 
-    uint16_t wrap_value = calculate_wrap(freq, CLK_DIV_DEFAULT); // Calcula o valor de wrap
+    sleep_ms(duration_ms); // Mantém o tom ativo pelo tempo especificado
 
-    pwm_set_wrap(slice_num, wrap_value); // Configura o valor de wrap no slice PWM
-    pwm_set_clkdiv(slice_num, CLK_DIV_DEFAULT); // Configura o divisor de clock
-    pwm_set_gpio_level(pin, wrap_value / 2); // Define o nível do PWM para 50% (duty cycle)
-    pwm_set_enabled(slice_num, true); // Habilita o PWM
+    stop_tone(pin); // Desliga o PWM
+}
 
-    sleep_ms(duration_ms); // Mantém o tom ativo pelo tempo especificado
+/**
+ * @brief Igual a `start_tone()`, devolvendo o instante em que o tom chega ao pino.
+ * 
+ * O contador é lido com as interrupções desligadas, no mesmo tique da escrita: se ele estiver no
+ * último tique do período, a escrita espera o wrap (no máximo um tique) para não ficar do lado
+ * errado dele.
+ * 
+ * @param slice_num Slice do PWM do pino.
+ * @param chan Canal do pino no slice (0 = A, 1 = B).
+ * @param freq Frequência do tom em Hz.
+ * @return Instante do início do tom, na base de `time_us_32()`.
+ */
+uint32_t GENIUS_HOT_FUNC(start_tone_timed_slice)(uint slice_num, uint chan, uint32_t freq) {
+    pwm_slice_hw_t *slice = &pwm_hw->slice[slice_num];
+    bool running = slice->csr & PWM_CH0_CSR_EN_BITS;
+    uint32_t top = slice->top; // Período em andamento (a escrita de TOP só vale no wrap)
+    uint32_t div16 = slice->div & 0xfffu;
+    uint32_t irq_state = save_and_disable_interrupts();
+
+    while (running && top > 0 && slice->ctr >= top) {
+        tight_loop_contents(); // Último tique do período: espera o wrap
+    }
+    uint32_t now = time_us_32();
+    uint32_t ticks = running ? top - slice->ctr + 1 : 0; // Tiques até o próximo wrap
+    start_tone_slice(slice, chan, freq);
+    restore_interrupts(irq_state);
 
-    pwm_set_gpio_level(pin, 0); // Desliga o PWM
+    uint32_t mhz = clock_get_hz(clk_sys) / 1000000;
+    return now + ticks * div16 / (16 * mhz);
 }
 
 /**
@@ -86,7 +112,7 @@ void play_tone(uint pin, uint32_t freq, uint duration_ms) {
  * @param duration_ms Duração do tom em milissegundos.
  * @param clkdiv Divisor de clock usado para o PWM.
  */
-void play_tone_clkdiv(uint pin, int freq, int duration_ms, float clkdiv) {
+void GENIUS_HOT_FUNC(play_tone_clkdiv)(uint pin, int freq, int duration_ms, float clkdiv) {
     uint slice_num = pwm_gpio_to_slice_num(pin); // Obtém o número do slice PWM associado ao pino
 
     uint16_t wrap_value = calculate_wrap(freq, clkdiv); // Calcula o valor de wrap
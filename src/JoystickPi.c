@@ -1,4 +1,6 @@
 #include "inc/JoystickPi.h"
+#include "inc/input_trace.h"
+#include "hardware/sync.h"
 
 /******************************
  * Documentação do Arquivo
@@ -18,8 +20,92 @@
  * 2. Leitura dos valores dos eixos X e Y (valores brutos do ADC).
  * 3. Leitura do estado do botão (pressionado ou não pressionado).
  * 4. Mapeamento dos valores do ADC para uma faixa personalizada (útil para normalização).
+ * 5. Calibração dos eixos: filtro por média de conversões, centro e zona morta.
  */
 
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+/**
+ * @brief Calibração atual; a padrão (centro nominal, sem zona morta nem filtro) é a identidade.
+ */
+static joystick_calibration_t calibration = {
+    .x = { .center = JOYSTICK_CENTER, .deadzone = 0, .oversample_log2 = 0 },
+    .y = { .center = JOYSTICK_CENTER, .deadzone = 0, .oversample_log2 = 0 },
+};
+
+/**
+ * @brief Conversões fornecidas por quem ocupa o ADC (`joystickPi_stream_begin()`).
+ */
+static bool streaming;
+static uint16_t stream_raw[2] = { JOYSTICK_CENTER, JOYSTICK_CENTER }; // Índice: canal do ADC; também a última leitura avulsa
+
+/**
+ * @brief Módulo que reservou o ADC (`joystickPi_adc_claim()`), ou NULL.
+ */
+static const char *volatile adc_owner;
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Lê um eixo com o filtro e a correção de centro e zona morta da calibração.
+ * 
+ * @param channel Canal do ADC.
+ * @param cal Calibração do eixo.
+ * @return Leitura calibrada (0-4095, `JOYSTICK_CENTER` em repouso).
+ */
+static uint16_t read_axis(uint channel, const joystick_axis_cal_t *cal) {
+    uint32_t raw;
+
+    if (streaming || adc_owner) {
+        raw = stream_raw[channel]; // Sem fornecedor, a última leitura antes da reserva
+    } else {
+        uint32_t sum = 0;
+        adc_select_input(channel); // Seleciona o canal do eixo
+        for (uint i = 0; i < (1u << cal->oversample_log2); i++) {
+            sum += adc_read(); // Conversões seguidas, ~2 us cada
+        }
+        raw = sum >> cal->oversample_log2;
+        stream_raw[channel] = (uint16_t)raw;
+    }
+
+    uint32_t low = cal->center - cal->deadzone;    // Fim do curso abaixo da zona morta
+    uint32_t high = cal->center + cal->deadzone;   // Início do curso acima da zona morta
+    if (raw < low) {
+        return (uint16_t)(raw * JOYSTICK_CENTER / low);
+    }
+    if (raw > high) {
+        return (uint16_t)(JOYSTICK_CENTER + (raw - high) * (JOYSTICK_ADC_MAX - JOYSTICK_CENTER) /
+                          (JOYSTICK_ADC_MAX - high));
+    }
+    return JOYSTICK_CENTER;
+}
+
+/**
+ * @brief Limita a calibração de um eixo à faixa aceita por `read_axis`.
+ */
+static joystick_axis_cal_t clamp_axis(joystick_axis_cal_t cal) {
+    if (cal.oversample_log2 > JOYSTICK_MAX_OVERSAMPLE_LOG2) {
+        cal.oversample_log2 = JOYSTICK_MAX_OVERSAMPLE_LOG2;
+    }
+    if (cal.center < 1) {
+        cal.center = 1;
+    } else if (cal.center > JOYSTICK_ADC_MAX - 1) {
+        cal.center = JOYSTICK_ADC_MAX - 1;
+    }
+
+    // Ao menos uma leitura de curso em cada lado da zona morta
+    uint16_t room = cal.center - 1 < JOYSTICK_ADC_MAX - 1 - cal.center ? cal.center - 1
+                                                                         : JOYSTICK_ADC_MAX - 1 - cal.center;
+    if (cal.deadzone > room) {
+        cal.deadzone = room;
+    }
+    return cal;
+}
+
 /******************************
  * Funções
  ******************************/
@@ -35,8 +121,8 @@ void joystickPi_init() {
     adc_init();
 
     // Configura os pinos do joystick como entradas analógicas
-    adc_gpio_init(JOYSTICK_X_PIN); // Configura o pino do eixo X (GP26)
-    adc_gpio_init(JOYSTICK_Y_PIN); // Configura o pino do eixo Y (GP27)
+    adc_gpio_init(JOYSTICK_X_PIN); // Configura o pino do eixo X
+    adc_gpio_init(JOYSTICK_Y_PIN); // Configura o pino do eixo Y
 
     // Configura o pino do botão como entrada digital
     gpio_init(JOYSTICK_BUTTON_PIN);
@@ -47,43 +133,40 @@ void joystickPi_init() {
 /**
  * @brief Lê o estado atual do joystick (eixos X e Y e botão).
  * 
+ * Os eixos passam pela calibração atual (filtro, centro e zona morta).
+ * 
  * @return Estrutura `joystick_state_t` contendo os valores dos eixos X e Y e o estado do botão.
  */
 joystick_state_t joystickPi_read() {
     joystick_state_t state;
 
-    // Lê o valor do eixo X
-    adc_select_input(0); // Seleciona o canal ADC0 (GP26)
-    state.x = adc_read(); // Lê o valor do ADC
-
-    // Lê o valor do eixo Y
-    adc_select_input(1); // Seleciona o canal ADC1 (GP27)
-    state.y = adc_read(); // Lê o valor do ADC
+    // Lê os eixos X e Y com a calibração atual
+    state.x = read_axis(JOYSTICK_X_ADC, &calibration.x);
+    state.y = read_axis(JOYSTICK_Y_ADC, &calibration.y);
 
     // Lê o estado do botão
     state.button = !gpio_get(JOYSTICK_BUTTON_PIN); // Inverte o valor porque o botão está em pull-up
 
+    INPUT_TRACE_JOYSTICK(&state); // Gravação, ou leitura gravada durante a reprodução
     return state;
 }
 
 /**
- * @brief Lê apenas o valor do eixo X do joystick.
+ * @brief Lê apenas o valor do eixo X do joystick, com a calibração atual.
  * 
  * @return Valor do eixo X (0-4095).
  */
 uint16_t joystickPi_read_x() {
-    adc_select_input(0); // Seleciona o canal ADC0 (GP26)
-    return adc_read(); // Lê o valor do ADC
+    return read_axis(JOYSTICK_X_ADC, &calibration.x);
 }
 
 /**
- * @brief Lê apenas o valor do eixo Y do joystick.
+ * @brief Lê apenas o valor do eixo Y do joystick, com a calibração atual.
  * 
  * @return Valor do eixo Y (0-4095).
  */
 uint16_t joystickPi_read_y() {
-    adc_select_input(1); // Seleciona o canal ADC1 (GP27)
-    return adc_read(); // Lê o valor do ADC
+    return read_axis(JOYSTICK_Y_ADC, &calibration.y);
 }
 
 /**
@@ -110,3 +193,83 @@ bool joystickPi_read_button() {
 int16_t joystickPi_map_value(uint16_t value, uint16_t min_input, uint16_t max_input, int16_t min_output, int16_t max_output) {
     return (int16_t)((value - min_input) * (max_output - min_output) / (max_input - min_input) + min_output);
 }
+
+/**
+ * @brief Substitui a calibração usada pelas leituras dos eixos.
+ * 
+ * Valores fora da faixa são limitados (filtro até `JOYSTICK_MAX_OVERSAMPLE_LOG2`, zona morta
+ * deixando ao menos uma leitura de curso em cada lado).
+ * 
+ * @param cal Nova calibração.
+ */
+void joystickPi_set_calibration(const joystick_calibration_t *cal) {
+    calibration.x = clamp_axis(cal->x);
+    calibration.y = clamp_axis(cal->y);
+}
+
+/**
+ * @brief Obtém a calibração atual.
+ * 
+ * @return Calibração usada pelas leituras dos eixos.
+ */
+joystick_calibration_t joystickPi_get_calibration() {
+    return calibration;
+}
+
+/**
+ * @brief Passa a ler os eixos das conversões fornecidas por `joystickPi_stream_push()`.
+ * 
+ * Centro e zona morta continuam valendo; o filtro por média fica a cargo de quem fornece. Até o
+ * primeiro `joystickPi_stream_push()` vale a última leitura avulsa.
+ */
+void joystickPi_stream_begin() {
+    streaming = true;
+}
+
+/**
+ * @brief Fornece as conversões mais recentes dos eixos.
+ * 
+ * @param x Conversão do eixo X (0-4095).
+ * @param y Conversão do eixo Y (0-4095).
+ */
+void joystickPi_stream_push(uint16_t x, uint16_t y) {
+    stream_raw[JOYSTICK_X_ADC] = x;
+    stream_raw[JOYSTICK_Y_ADC] = y;
+}
+
+/**
+ * @brief Volta às leituras avulsas do ADC.
+ */
+void joystickPi_stream_end() {
+    streaming = false;
+}
+
+/**
+ * @brief Reserva o ADC para um módulo que muda a FIFO, o divisor ou a alternância.
+ * 
+ * @param owner Nome do módulo (impresso por quem encontrar o ADC ocupado).
+ * @return false se o ADC já estiver reservado; nada é alterado.
+ */
+bool joystickPi_adc_claim(const char *owner) {
+    uint32_t irq_state = save_and_disable_interrupts(); // Teste e reserva sem interrupção no meio
+    bool claimed = adc_owner == NULL;
+    if (claimed) {
+        adc_owner = owner;
+    }
+    restore_interrupts(irq_state);
+    return claimed;
+}
+
+/**
+ * @brief Devolve o ADC às leituras avulsas do joystick.
+ */
+void joystickPi_adc_release() {
+    adc_owner = NULL;
+}
+
+/**
+ * @brief Módulo que reservou o ADC, ou NULL se estiver livre.
+ */
+const char *joystickPi_adc_owner() {
+    return adc_owner;
+}
@@ -0,0 +1,587 @@
+#include "inc/JoystickPi_calibration.h"
+#include "inc/mem_layout.h"
+#include "inc/scheduler.h"
+#include "inc/timer_wheel.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file JoystickPi_calibration.c
+ * @brief Implementação da calibração do joystick declarada em `JoystickPi_calibration.h`
+ *
+ * As estatísticas são acumuladas em inteiros (somas e somas dos quadrados exatas em 64 bits); só o
+ * espectro usa ponto flutuante. O RP2040 não tem FPU, mas a FFT de 512 pontos em software leva
+ * poucos milissegundos por bloco, o que não importa em uma calibração.
+ *
+ * A medição é uma máquina de estados na tarefa `joycal`: a espera inicial e os intervalos entre
+ * blocos são temporizadores da roda, e cada ativação captura e acumula um bloco. Entre as
+ * ativações o resto do firmware continua rodando.
+ *
+ * A calibração é gravada no último setor da flash (`CAL_FLASH_OFFSET`) como um registro com
+ * assinatura, versão, tamanho e CRC-32; um registro que não confere é ignorado na partida. Apagar
+ * e programar o setor exige que nada rode da flash, então as interrupções ficam desligadas por
+ * cerca de 50 ms (o som para durante esse tempo). A gravação é recusada se o programa ocupar o
+ * último setor (`__flash_binary_end`).
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define AXIS_COUNT 2
+#define FILTER_STEPS (JOYSTICK_MAX_OVERSAMPLE_LOG2 + 1)
+#define SPECTRUM_BINS (JOYSTICK_CAL_SAMPLES / 2)
+#define ADC_CYCLES_PER_SAMPLE 96
+#define HIST_BAR_MAX 40
+
+/**
+ * @brief Registro da calibração na flash: último setor, assinatura e versão do formato.
+ */
+#define CAL_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
+#define CAL_FLASH_MAGIC 0x4A43414Cu // "JCAL"
+#define CAL_FLASH_VERSION 1
+
+static_assert((JOYSTICK_CAL_SAMPLES & (JOYSTICK_CAL_SAMPLES - 1)) == 0,
+              "JOYSTICK_CAL_SAMPLES deve ser potencia de 2 (FFT)");
+static_assert(JOYSTICK_CAL_SAMPLES % (1u << JOYSTICK_MAX_OVERSAMPLE_LOG2) == 0,
+              "JOYSTICK_CAL_SAMPLES deve ser multiplo do maior filtro");
+
+// Canais na ordem da alternância do ADC: o de menor número é convertido primeiro
+#define FIRST_ADC (JOYSTICK_X_ADC < JOYSTICK_Y_ADC ? JOYSTICK_X_ADC : JOYSTICK_Y_ADC)
+
+static const char *axis_names[AXIS_COUNT] = { "X", "Y" };
+static const uint axis_channels[AXIS_COUNT] = { JOYSTICK_X_ADC, JOYSTICK_Y_ADC };
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Etapas da medição.
+ */
+typedef enum {
+    CAL_IDLE = 0,   // Nenhuma calibração em andamento
+    CAL_SETTLE,     // Aguardando o joystick parar
+    CAL_CAPTURE,    // Capturando os blocos
+} cal_state_t;
+
+/**
+ * @brief Registro gravado na flash (uma página).
+ */
+typedef struct {
+    uint32_t magic;                 // CAL_FLASH_MAGIC
+    uint16_t version;               // CAL_FLASH_VERSION
+    uint16_t size;                  // sizeof(joystick_calibration_t)
+    joystick_calibration_t cal;
+    uint32_t crc;                   // CRC-32 dos campos anteriores
+} cal_record_t;
+
+static_assert(sizeof(cal_record_t) <= FLASH_PAGE_SIZE, "registro da calibracao maior que uma pagina");
+
+/**
+ * @brief Estatísticas acumuladas de um eixo.
+ */
+typedef struct {
+    uint64_t sum, sum_sq;                  // Conversões
+    uint32_t count;
+    uint16_t min, max;
+    int32_t hist_origin;                   // Leitura no centro do histograma
+    uint32_t hist[JOYSTICK_CAL_HIST_BINS];
+    uint64_t block_sum[FILTER_STEPS];      // Somas de 2^n conversões seguidas, por n
+    uint64_t block_sum_sq[FILTER_STEPS];
+    uint32_t block_min[FILTER_STEPS], block_max[FILTER_STEPS];
+    uint32_t block_count[FILTER_STEPS];
+    float power[SPECTRUM_BINS];            // Potência somada entre os blocos
+} axis_stats_t;
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static uint16_t GENIUS_DMA_DATA("joystick_cal") samples[AXIS_COUNT * JOYSTICK_CAL_SAMPLES];
+static float fft_re[JOYSTICK_CAL_SAMPLES], fft_im[JOYSTICK_CAL_SAMPLES];
+static float cos_table[SPECTRUM_BINS], sin_table[SPECTRUM_BINS];
+static axis_stats_t stats[AXIS_COUNT];
+
+static scheduler_task_t cal_task;
+static timer_wheel_timer_t cal_timer;      // Espera inicial e intervalo entre blocos
+static volatile cal_state_t cal_state = CAL_IDLE;
+static uint cal_block;                     // Próximo bloco a capturar
+static int cal_dma_chan;
+static dma_channel_config cal_dma_cfg;
+static bool loaded_from_flash;             // A calibração atual veio da flash
+
+extern char __flash_binary_end;            // Fim do programa na flash (ligador)
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Índice, em `samples`, da conversão `i` de um eixo.
+ */
+static inline uint sample_index(uint axis, uint i) {
+    return 2 * i + (axis_channels[axis] == FIRST_ADC ? 0 : 1);
+}
+
+/**
+ * @brief Captura um bloco: `JOYSTICK_CAL_SAMPLES` conversões de cada eixo, intercaladas.
+ */
+static void capture_block(uint dma_chan, const dma_channel_config *cfg) {
+    adc_select_input(FIRST_ADC); // A alternância recomeça pelo primeiro canal
+    dma_channel_configure(dma_chan, cfg, samples, &adc_hw->fifo, count_of(samples), true);
+    adc_run(true);
+    dma_channel_wait_for_finish_blocking(dma_chan);
+    adc_run(false);
+    adc_fifo_drain(); // Conversão em andamento ao parar
+}
+
+/**
+ * @brief FFT radix-2 in-place sobre `fft_re` e `fft_im`.
+ */
+static void fft() {
+    const uint n = JOYSTICK_CAL_SAMPLES;
+
+    for (uint i = 1, j = 0; i < n; i++) {
+        uint bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            float t = fft_re[i]; fft_re[i] = fft_re[j]; fft_re[j] = t;
+            t = fft_im[i]; fft_im[i] = fft_im[j]; fft_im[j] = t;
+        }
+    }
+
+    for (uint len = 2; len <= n; len <<= 1) {
+        uint step = n / len;
+        for (uint start = 0; start < n; start += len) {
+            for (uint k = 0; k < len / 2; k++) {
+                float wr = cos_table[k * step], wi = -sin_table[k * step];
+                uint a = start + k, b = a + len / 2;
+                float tr = fft_re[b] * wr - fft_im[b] * wi;
+                float ti = fft_re[b] * wi + fft_im[b] * wr;
+                fft_re[b] = fft_re[a] - tr;
+                fft_im[b] = fft_im[a] - ti;
+                fft_re[a] += tr;
+                fft_im[a] += ti;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Janela de Hann no ponto `i`.
+ */
+static float hann(uint i) {
+    uint j = i < SPECTRUM_BINS ? i : JOYSTICK_CAL_SAMPLES - i; // Simétrica
+    return j == SPECTRUM_BINS ? 1.0f : 0.5f - 0.5f * cos_table[j];
+}
+
+/**
+ * @brief Acumula as estatísticas de um eixo com o bloco capturado.
+ */
+static void accumulate(uint axis, bool first_block) {
+    axis_stats_t *s = &stats[axis];
+    uint32_t block_total = 0;
+
+    for (uint i = 0; i < JOYSTICK_CAL_SAMPLES; i++) {
+        block_total += samples[sample_index(axis, i)];
+    }
+    if (first_block) {
+        s->hist_origin = (block_total + JOYSTICK_CAL_SAMPLES / 2) / JOYSTICK_CAL_SAMPLES;
+    }
+
+    // Momentos, extremos e histograma
+    for (uint i = 0; i < JOYSTICK_CAL_SAMPLES; i++) {
+        uint16_t v = samples[sample_index(axis, i)];
+        int32_t offset = (int32_t)v - s->hist_origin + (JOYSTICK_CAL_HIST_BINS / 2) * JOYSTICK_CAL_HIST_WIDTH;
+        int32_t bin = offset < 0 ? 0 : offset / JOYSTICK_CAL_HIST_WIDTH;
+
+        s->sum += v;
+        s->sum_sq += (uint32_t)v * v;
+        if (v < s->min) s->min = v;
+        if (v > s->max) s->max = v;
+        s->hist[bin < JOYSTICK_CAL_HIST_BINS ? bin : JOYSTICK_CAL_HIST_BINS - 1]++;
+    }
+    s->count += JOYSTICK_CAL_SAMPLES;
+
+    // Saída do filtro de média de 2^n conversões, para cada n
+    for (uint n = 0; n < FILTER_STEPS; n++) {
+        for (uint start = 0; start < JOYSTICK_CAL_SAMPLES; start += 1u << n) {
+            uint32_t sum = 0;
+            for (uint i = start; i < start + (1u << n); i++) {
+                sum += samples[sample_index(axis, i)];
+            }
+            s->block_sum[n] += sum;
+            s->block_sum_sq[n] += (uint64_t)sum * sum;
+            if (sum < s->block_min[n]) s->block_min[n] = sum;
+            if (sum > s->block_max[n]) s->block_max[n] = sum;
+            s->block_count[n]++;
+        }
+    }
+
+    // Espectro do bloco, sem a componente contínua
+    float mean = (float)block_total / JOYSTICK_CAL_SAMPLES;
+    for (uint i = 0; i < JOYSTICK_CAL_SAMPLES; i++) {
+        fft_re[i] = ((float)samples[sample_index(axis, i)] - mean) * hann(i);
+        fft_im[i] = 0.0f;
+    }
+    fft();
+    for (uint k = 0; k < SPECTRUM_BINS; k++) {
+        s->power[k] += fft_re[k] * fft_re[k] + fft_im[k] * fft_im[k];
+    }
+}
+
+/**
+ * @brief Desvio padrão, em centésimos de LSB, a partir de contagem, soma e soma dos quadrados.
+ *
+ * @param scale_log2 As somas são de 2^scale_log2 conversões (desvio da média delas).
+ */
+static uint32_t std_centi(uint32_t count, uint64_t sum, uint64_t sum_sq, uint scale_log2) {
+    uint64_t num = (uint64_t)count * sum_sq - sum * sum; // Exato: count² * variância
+    float var = (float)num / ((float)count * count) / (float)(1u << (2 * scale_log2));
+    return (uint32_t)(sqrtf(var) * 100.0f + 0.5f);
+}
+
+/**
+ * @brief Imprime um valor em centésimos com duas casas decimais.
+ */
+static void print_centi(uint32_t centi) {
+    printf("%lu.%02lu", (unsigned long)(centi / 100), (unsigned long)(centi % 100));
+}
+
+/**
+ * @brief Imprime o histograma de um eixo (só o trecho com amostras).
+ */
+static void print_histogram(const axis_stats_t *s) {
+    uint32_t peak = 0;
+    int first = -1, last = -1;
+
+    for (int bin = 0; bin < JOYSTICK_CAL_HIST_BINS; bin++) {
+        if (s->hist[bin] > 0) {
+            if (first < 0) first = bin;
+            last = bin;
+        }
+        if (s->hist[bin] > peak) peak = s->hist[bin];
+    }
+    for (int bin = first; bin >= 0 && bin <= last; bin++) {
+        int32_t low = s->hist_origin + (bin - JOYSTICK_CAL_HIST_BINS / 2) * JOYSTICK_CAL_HIST_WIDTH;
+        uint bar = (s->hist[bin] * HIST_BAR_MAX + peak - 1) / peak;
+
+        printf("  %s%4ld %6lu ", bin == 0 ? "<=" : bin == JOYSTICK_CAL_HIST_BINS - 1 ? ">=" : "  ",
+               (long)low, (unsigned long)s->hist[bin]);
+        for (uint i = 0; i < bar; i++) {
+            putchar('#');
+        }
+        putchar('\n');
+    }
+}
+
+/**
+ * @brief Imprime os maiores picos do espectro de um eixo.
+ *
+ * @param fs_hz Taxa de amostragem de cada eixo.
+ */
+static void print_peaks(const axis_stats_t *s, uint32_t fs_hz) {
+    uint peaks[JOYSTICK_CAL_PEAKS];
+    uint found = 0;
+
+    // Máximos locais, fora das duas primeiras classes (componente contínua e vazamento da janela)
+    for (uint k = 2; k < SPECTRUM_BINS - 1; k++) {
+        if (s->power[k] <= s->power[k - 1] || s->power[k] < s->power[k + 1]) {
+            continue;
+        }
+        if (found == JOYSTICK_CAL_PEAKS && s->power[k] <= s->power[peaks[found - 1]]) {
+            continue;
+        }
+
+        // Inserção na lista ordenada por potência decrescente (descarta o menor se cheia)
+        uint pos = found < JOYSTICK_CAL_PEAKS ? found++ : JOYSTICK_CAL_PEAKS - 1;
+        while (pos > 0 && s->power[peaks[pos - 1]] < s->power[k]) {
+            peaks[pos] = peaks[pos - 1];
+            pos--;
+        }
+        peaks[pos] = k;
+    }
+
+    printf("  picos:");
+    for (uint i = 0; i < found; i++) {
+        // Senoide de amplitude A com janela de Hann: |X| = A * N / 4
+        float magnitude = sqrtf(s->power[peaks[i]] / JOYSTICK_CAL_BLOCKS);
+        uint32_t amplitude = (uint32_t)(magnitude * 4.0f / JOYSTICK_CAL_SAMPLES * 100.0f + 0.5f);
+
+        printf(" %lu Hz (", (unsigned long)((uint64_t)peaks[i] * fs_hz / JOYSTICK_CAL_SAMPLES));
+        print_centi(amplitude);
+        printf(" LSB)");
+    }
+    printf(found ? "\n" : " nenhum\n");
+}
+
+/**
+ * @brief Imprime o relatório de um eixo e deriva sua calibração.
+ */
+static joystick_axis_cal_t analyze(uint axis, uint32_t fs_hz) {
+    const axis_stats_t *s = &stats[axis];
+    joystick_axis_cal_t cal = { .oversample_log2 = JOYSTICK_MAX_OVERSAMPLE_LOG2 };
+    uint32_t mean_centi = (uint32_t)((s->sum * 100 + s->count / 2) / s->count);
+
+    cal.center = (uint16_t)((s->sum + s->count / 2) / s->count);
+
+    printf("\nEixo %s: media ", axis_names[axis]);
+    print_centi(mean_centi);
+    printf(" | desvio ");
+    print_centi(std_centi(s->count, s->sum, s->sum_sq, 0));
+    printf(" | min %u | max %u\n", s->min, s->max);
+    print_histogram(s);
+    print_peaks(s, fs_hz);
+
+    // Filtro: menor média que atinge o desvio desejado
+    printf("  desvio apos media de 2^n:");
+    bool chosen = false;
+    for (uint n = 0; n < FILTER_STEPS; n++) {
+        uint32_t std = std_centi(s->block_count[n], s->block_sum[n], s->block_sum_sq[n], n);
+
+        printf(" n=%u ", n);
+        print_centi(std);
+        if (!chosen && std <= JOYSTICK_CAL_TARGET_STD_CENTI) {
+            cal.oversample_log2 = n;
+            chosen = true;
+        }
+    }
+    printf("\n");
+
+    // Zona morta: maior afastamento da saída do filtro em relação ao centro
+    uint n = cal.oversample_log2;
+    uint32_t center_sum = (uint32_t)cal.center << n;
+    uint32_t below = center_sum > s->block_min[n] ? center_sum - s->block_min[n] : 0;
+    uint32_t above = s->block_max[n] > center_sum ? s->block_max[n] - center_sum : 0;
+    uint32_t spread = below > above ? below : above;
+    cal.deadzone = (uint16_t)(((spread + (1u << n) - 1) >> n) + JOYSTICK_CAL_DEADZONE_MARGIN);
+
+    return cal;
+}
+
+/**
+ * @brief CRC-32 (polinômio 0xEDB88320, o do zlib), bit a bit: o registro tem poucos bytes.
+ */
+static uint32_t crc32(const uint8_t *data, size_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1u));
+        }
+    }
+    return ~crc;
+}
+
+/**
+ * @brief Registro gravado, lido diretamente pelo XIP.
+ */
+static const cal_record_t *stored_record() {
+    return (const cal_record_t *)(XIP_BASE + CAL_FLASH_OFFSET);
+}
+
+/**
+ * @brief Verifica assinatura, versão, tamanho e CRC de um registro.
+ */
+static bool record_valid(const cal_record_t *rec) {
+    return rec->magic == CAL_FLASH_MAGIC && rec->version == CAL_FLASH_VERSION &&
+           rec->size == sizeof(joystick_calibration_t) &&
+           rec->crc == crc32((const uint8_t *)rec, offsetof(cal_record_t, crc));
+}
+
+/**
+ * @brief Grava a calibração no último setor da flash, se ela mudou.
+ */
+static void save_calibration(const joystick_calibration_t *cal) {
+    static uint8_t page[FLASH_PAGE_SIZE];
+    cal_record_t rec;
+
+    if ((uintptr_t)&__flash_binary_end > XIP_BASE + CAL_FLASH_OFFSET) {
+        printf("Calibracao nao gravada: o programa ocupa o ultimo setor da flash\n");
+        return;
+    }
+
+    memset(&rec, 0, sizeof(rec)); // Sem lixo no preenchimento coberto pelo CRC
+    rec.magic = CAL_FLASH_MAGIC;
+    rec.version = CAL_FLASH_VERSION;
+    rec.size = sizeof(joystick_calibration_t);
+    rec.cal = *cal;
+    rec.crc = crc32((const uint8_t *)&rec, offsetof(cal_record_t, crc));
+    if (memcmp(stored_record(), &rec, sizeof(rec)) == 0) {
+        printf("Calibracao igual a gravada na flash\n");
+        return; // Poupa um ciclo de apagamento
+    }
+
+    memset(page, 0xFF, sizeof(page));
+    memcpy(page, &rec, sizeof(rec));
+    fflush(stdout);
+
+    uint32_t irq_state = save_and_disable_interrupts(); // Nada pode rodar da flash agora
+    flash_range_erase(CAL_FLASH_OFFSET, FLASH_SECTOR_SIZE);
+    flash_range_program(CAL_FLASH_OFFSET, page, FLASH_PAGE_SIZE);
+    restore_interrupts(irq_state);
+
+    loaded_from_flash = record_valid(stored_record());
+    printf(loaded_from_flash ? "Calibracao gravada na flash\n" : "Falha ao gravar a calibracao na flash\n");
+}
+
+/**
+ * @brief Prepara as tabelas, as estatísticas, a DMA e o ADC para a captura.
+ */
+static void begin_capture() {
+    for (uint i = 0; i < SPECTRUM_BINS; i++) {
+        float angle = 2.0f * (float)M_PI * i / JOYSTICK_CAL_SAMPLES;
+        cos_table[i] = cosf(angle);
+        sin_table[i] = sinf(angle);
+    }
+    for (uint axis = 0; axis < AXIS_COUNT; axis++) {
+        memset(&stats[axis], 0, sizeof(stats[axis]));
+        stats[axis].min = UINT16_MAX;
+        for (uint n = 0; n < FILTER_STEPS; n++) {
+            stats[axis].block_min[n] = UINT32_MAX;
+        }
+    }
+
+    // ADC em conversão contínua, alternando entre os eixos, com a FIFO alimentando a DMA
+    cal_dma_chan = dma_claim_unused_channel(true);
+    cal_dma_cfg = dma_channel_get_default_config(cal_dma_chan);
+    channel_config_set_transfer_data_size(&cal_dma_cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cal_dma_cfg, false);
+    channel_config_set_write_increment(&cal_dma_cfg, true);
+    channel_config_set_dreq(&cal_dma_cfg, DREQ_ADC);
+
+    adc_set_round_robin((1u << JOYSTICK_X_ADC) | (1u << JOYSTICK_Y_ADC));
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv(0); // Taxa máxima
+    adc_fifo_drain();
+    cal_block = 0;
+}
+
+/**
+ * @brief Devolve o ADC, analisa as estatísticas, aplica e grava a calibração.
+ */
+static void finish_capture() {
+    uint32_t fs_hz = clock_get_hz(clk_adc) / ADC_CYCLES_PER_SAMPLE / AXIS_COUNT;
+
+    // Devolve o ADC às leituras avulsas de JoystickPi
+    adc_set_round_robin(0);
+    adc_fifo_setup(false, false, 0, false, false);
+    adc_fifo_drain();
+    dma_channel_unclaim(cal_dma_chan);
+    joystickPi_adc_release();
+
+    printf("%d blocos de %d conversoes por eixo a %lu Hz\n", JOYSTICK_CAL_BLOCKS, JOYSTICK_CAL_SAMPLES,
+           (unsigned long)fs_hz);
+
+    joystick_calibration_t cal = {
+        .x = analyze(0, fs_hz),
+        .y = analyze(1, fs_hz),
+    };
+    joystickPi_set_calibration(&cal);
+    cal = joystickPi_get_calibration(); // Com os limites aplicados
+
+    printf("\n%-4s %6s %11s %8s\n", "eixo", "centro", "zona_morta", "media_de");
+    printf("%-4s %6u %11u %8u\n", "X", cal.x.center, cal.x.deadzone, 1u << cal.x.oversample_log2);
+    printf("%-4s %6u %11u %8u\n", "Y", cal.y.center, cal.y.deadzone, 1u << cal.y.oversample_log2);
+    save_calibration(&cal);
+}
+
+/**
+ * @brief Fim da espera inicial ou do intervalo entre blocos (contexto de interrupção).
+ */
+static void cal_timer_callback(timer_wheel_timer_t *timer) {
+    (void)timer;
+    scheduler_signal(&cal_task);
+}
+
+/**
+ * @brief Tarefa da calibração: captura e acumula um bloco por ativação.
+ */
+static void cal_run() {
+    switch (cal_state) {
+        case CAL_SETTLE:
+            begin_capture();
+            cal_state = CAL_CAPTURE;
+            // fallthrough
+        case CAL_CAPTURE: {
+            uint32_t start_us = time_us_32();
+
+            capture_block(cal_dma_chan, &cal_dma_cfg);
+            for (uint axis = 0; axis < AXIS_COUNT; axis++) {
+                accumulate(axis, cal_block == 0);
+            }
+            if (++cal_block < JOYSTICK_CAL_BLOCKS) {
+                uint32_t elapsed_ms = (time_us_32() - start_us) / 1000;
+                timer_wheel_start(&cal_timer, elapsed_ms < JOYSTICK_CAL_BLOCK_GAP_MS
+                                                  ? JOYSTICK_CAL_BLOCK_GAP_MS - elapsed_ms : 0);
+                return;
+            }
+            finish_capture();
+            cal_state = CAL_IDLE;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Aplica a calibração gravada na flash, se houver, e registra a tarefa da calibração.
+ */
+void joystickPi_calibration_init() {
+    const cal_record_t *rec = stored_record();
+
+    if (record_valid(rec)) {
+        joystickPi_set_calibration(&rec->cal);
+        loaded_from_flash = true;
+    }
+
+    timer_wheel_timer_init(&cal_timer, cal_timer_callback, NULL);
+    scheduler_task_init(&cal_task, "joycal", cal_run, 3, 0); // Prioridade dos comandos
+    scheduler_add(&cal_task);
+}
+
+/**
+ * @brief Inicia a medição do ruído dos eixos em repouso.
+ *
+ * @return false se uma calibração já estiver em andamento ou o ADC estiver ocupado.
+ */
+bool joystickPi_calibrate() {
+    if (cal_state != CAL_IDLE) {
+        printf("\nCalibracao do joystick: ja em andamento\n");
+        return false;
+    }
+    if (!joystickPi_adc_claim("calibracao")) {
+        printf("\nCalibracao do joystick: ADC ocupado (%s)\n", joystickPi_adc_owner());
+        return false;
+    }
+
+    printf("\n--- Calibracao do joystick ---\n");
+    printf("Calibracao atual: %s\n", loaded_from_flash ? "gravada na flash" : "padrao");
+    printf("Solte o joystick; a medicao comeca em %d ms\n", JOYSTICK_CAL_SETTLE_MS);
+    fflush(stdout);
+
+    cal_state = CAL_SETTLE;
+    timer_wheel_start(&cal_timer, JOYSTICK_CAL_SETTLE_MS);
+    return true;
+}
@@ -0,0 +1,84 @@
+#include "inc/boot_profiler.h"
+#include "pico/runtime.h"
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file boot_profiler.c
+ * @brief Implementação da linha do tempo da inicialização
+ *
+ * Este arquivo implementa as funções declaradas em `boot_profiler.h`. As marcas são gravadas
+ * antes de a saída USB existir; o relatório é impresso depois, sob demanda.
+ */
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static uint32_t phase_us[BOOT_PHASE_COUNT];
+
+static const char *phase_names[BOOT_PHASE_COUNT] = {
+    "clocks", "runtime", "adc", "pwm", "gpio_irq", "pronto", "stdio"
+};
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Marca o fim dos clocks: executada pela `runtime_init` logo depois dos resets pós-clock,
+ * quando o temporizador já conta.
+ */
+static void mark_clocks() {
+    boot_profiler_mark(BOOT_PHASE_CLOCKS);
+}
+PICO_RUNTIME_INIT_FUNC_RUNTIME(mark_clocks, "00601");
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Registra o fim de uma fase de inicialização.
+ *
+ * @param phase Fase concluída.
+ */
+void boot_profiler_mark(boot_phase_t phase) {
+    phase_us[phase] = time_us_32();
+}
+
+/**
+ * @brief Obtém o instante em que uma fase terminou.
+ *
+ * @param phase Fase desejada.
+ * @return Microssegundos desde a partida do temporizador.
+ */
+uint32_t boot_profiler_time_us(boot_phase_t phase) {
+    return phase_us[phase];
+}
+
+/**
+ * @brief Imprime a linha do tempo da inicialização.
+ *
+ * Para cada fase são exibidos o instante de término e a duração desde a fase anterior. Além das
+ * fases, imprime o instante da primeira nota possível e quanto ele seria com a USB inicializada
+ * antes do escalonador (a ordem anterior do `main()`).
+ */
+void boot_profiler_report() {
+    uint32_t previous = 0;
+
+    printf("\n--- Inicializacao ---\n");
+    printf("%-9s %9s %9s\n", "fase", "fim_us", "dur_us");
+    for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+        printf("%-9s %9lu %9lu\n", phase_names[i], (unsigned long)phase_us[i],
+               (unsigned long)(phase_us[i] - previous));
+        previous = phase_us[i];
+    }
+    uint32_t ready = phase_us[BOOT_PHASE_READY];
+    uint32_t usb = phase_us[BOOT_PHASE_STDIO] ? phase_us[BOOT_PHASE_STDIO] - ready : 0;
+    printf("primeira nota disponivel em %lu us (com a USB antes do escalonador: ate %lu us)\n",
+           (unsigned long)ready, (unsigned long)(ready + usb));
+}
@@ -0,0 +1,284 @@
+#include "inc/bounce_profiler.h"
+#include "inc/gpio_irq_manager.h"
+#include "hardware/irq.h"
+#include "hardware/structs/sio.h"
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file bounce_profiler.c
+ * @brief Implementação da caracterização do repique declarada em `bounce_profiler.h`
+ *
+ * As bordas são gravadas como o estado dos três pinos (um bit por botão) após cada mudança, para
+ * a captura ler o SIO uma única vez por volta do laço.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define BOUNCE_PROF_PINS 3
+#define BOUNCE_PROF_MAX_BURSTS 256
+
+static const uint pins[BOUNCE_PROF_PINS] = { BUTTON_A_PIN, BUTTON_B_PIN, JOYSTICK_BUTTON_PIN };
+static const char *pin_names[BOUNCE_PROF_PINS] = { "A", "B", "joy" };
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Repiques de um tipo de transição (aperto ou soltura) em um pino.
+ */
+typedef struct {
+    uint32_t us[BOUNCE_PROF_MAX_BURSTS];   // Duração de cada rajada
+    uint count;
+    uint max_edges;                         // Maior número de bordas em uma rajada
+} burst_set_t;
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static uint32_t edge_time[BOUNCE_PROF_MAX_EDGES];
+static uint8_t edge_state[BOUNCE_PROF_MAX_EDGES];
+static uint edge_count;
+
+static burst_set_t presses, releases;
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Converte o nível dos pinos no SIO em um bit por botão.
+ */
+static inline uint8_t pack_state(uint32_t in) {
+    uint8_t state = 0;
+
+    for (uint i = 0; i < BOUNCE_PROF_PINS; i++) {
+        if (in & BOARD_PIN_MASK(pins[i])) {
+            state |= 1u << i;
+        }
+    }
+    return state;
+}
+
+/**
+ * @brief Grava as bordas dos botões até a captura terminar.
+ *
+ * @return Duração da captura em milissegundos.
+ */
+static uint32_t capture() {
+    uint press_count[BOUNCE_PROF_PINS] = {0};
+    uint32_t last_change[BOUNCE_PROF_PINS];
+    uint32_t start = time_us_32();
+    uint32_t last_edge = start;
+    uint32_t last_in = sio_hw->gpio_in & BOARD_BUTTONS_MASK;
+    bool pressed_any = false;
+
+    for (uint i = 0; i < BOUNCE_PROF_PINS; i++) {
+        last_change[i] = start - BOUNCE_PROF_GAP_US - 1;
+    }
+    edge_count = 0;
+
+    while (edge_count < BOUNCE_PROF_MAX_EDGES) {
+        uint32_t in = sio_hw->gpio_in & BOARD_BUTTONS_MASK;
+        uint32_t now = time_us_32();
+
+        if (in != last_in) {
+            uint8_t state = pack_state(in);
+            uint8_t changed = state ^ pack_state(last_in);
+            bool done = true;
+
+            edge_time[edge_count] = now;
+            edge_state[edge_count] = state;
+            edge_count++;
+
+            for (uint i = 0; i < BOUNCE_PROF_PINS; i++) {
+                if (changed & (1u << i)) {
+                    // Primeira descida depois de um silêncio: um novo toque
+                    if (!(state & (1u << i)) && now - last_change[i] > BOUNCE_PROF_GAP_US) {
+                        press_count[i]++;
+                        pressed_any = true;
+                    }
+                    last_change[i] = now;
+                }
+                done = done && press_count[i] >= BOUNCE_PROF_PRESSES;
+            }
+
+            last_in = in;
+            last_edge = now;
+            if (done) {
+                break;
+            }
+        } else if (pressed_any && now - last_edge > BOUNCE_PROF_IDLE_MS * 1000u) {
+            break;
+        }
+
+        if (now - start > BOUNCE_PROF_TIMEOUT_MS * 1000u) {
+            break;
+        }
+    }
+
+    return (time_us_32() - start) / 1000;
+}
+
+/**
+ * @brief Acrescenta uma rajada fechada ao conjunto do seu tipo.
+ */
+static void add_burst(burst_set_t *set, uint32_t us, uint edges) {
+    if (set->count < BOUNCE_PROF_MAX_BURSTS) {
+        set->us[set->count++] = us;
+    }
+    if (edges > set->max_edges) {
+        set->max_edges = edges;
+    }
+}
+
+/**
+ * @brief Agrupa as bordas de um pino em rajadas de aperto e de soltura.
+ *
+ * @param index Índice do pino em `pins`.
+ */
+static void collect_bursts(uint index) {
+    uint8_t bit = 1u << index;
+    uint8_t previous = edge_count > 0 ? edge_state[0] ^ bit : 0; // Anterior à primeira borda
+    bool open = false;
+    uint32_t first = 0, last = 0;
+    uint edges = 0;
+    bool level = false;
+
+    presses.count = releases.count = 0;
+    presses.max_edges = releases.max_edges = 0;
+
+    for (uint e = 0; e < edge_count; e++) {
+        if (!((edge_state[e] ^ previous) & bit)) {
+            previous = edge_state[e];
+            continue; // Borda de outro pino
+        }
+        previous = edge_state[e];
+
+        if (open && edge_time[e] - last > BOUNCE_PROF_GAP_US) {
+            add_burst(level ? &releases : &presses, last - first, edges);
+            open = false;
+        }
+        if (!open) {
+            open = true;
+            first = edge_time[e];
+            edges = 0;
+        }
+        edges++;
+        last = edge_time[e];
+        level = edge_state[e] & bit;
+    }
+    if (open) {
+        add_burst(level ? &releases : &presses, last - first, edges);
+    }
+}
+
+/**
+ * @brief Ordena as durações de um conjunto (inserção; no máximo `BOUNCE_PROF_MAX_BURSTS`).
+ */
+static void sort_bursts(burst_set_t *set) {
+    for (uint i = 1; i < set->count; i++) {
+        uint32_t value = set->us[i];
+        uint j = i;
+
+        while (j > 0 && set->us[j - 1] > value) {
+            set->us[j] = set->us[j - 1];
+            j--;
+        }
+        set->us[j] = value;
+    }
+}
+
+/**
+ * @brief Imprime a distribuição de um conjunto de rajadas.
+ *
+ * @return Maior repique do conjunto, em microssegundos.
+ */
+static uint32_t print_bursts(const char *pin, const char *kind, burst_set_t *set) {
+    if (set->count == 0) {
+        printf("%-4s %-8s %6d\n", pin, kind, 0);
+        return 0;
+    }
+
+    sort_bursts(set);
+    uint32_t max = set->us[set->count - 1];
+    printf("%-4s %-8s %6u %8lu %8lu %8lu %8lu %7u\n", pin, kind, set->count,
+           (unsigned long)set->us[0], (unsigned long)set->us[set->count / 2],
+           (unsigned long)set->us[(set->count * 9) / 10], (unsigned long)max, set->max_edges);
+    return max;
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Captura as bordas dos botões, imprime a distribuição do repique e sugere o debounce.
+ *
+ * @param apply true para aplicar a sugestão de cada pino ao `gpio_irq_manager`.
+ */
+void bounce_profiler_run(bool apply) {
+    uint16_t suggestion[BOUNCE_PROF_PINS] = {0};
+
+    printf("\n--- Repique das chaves ---\n");
+    printf("Aperte e solte cada botao (A, B, joystick) %d vezes, com toques curtos e longos.\n",
+           BOUNCE_PROF_PRESSES);
+    printf("A captura termina apos %d s sem toques. Os botoes nao acionam o instrumento ate la.\n",
+           BOUNCE_PROF_IDLE_MS / 1000);
+    fflush(stdout);
+
+    // Sem callbacks durante a captura; as bordas ficam só no registro
+    irq_set_enabled(IO_IRQ_BANK0, false);
+    uint32_t elapsed_ms = capture();
+    for (uint i = 0; i < BOUNCE_PROF_PINS; i++) {
+        gpio_acknowledge_irq(pins[i], GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL); // Bordas da captura
+    }
+    irq_set_enabled(IO_IRQ_BANK0, true);
+
+    printf("%u bordas em %lu ms%s\n", edge_count, (unsigned long)elapsed_ms,
+           edge_count == BOUNCE_PROF_MAX_EDGES ? " (registro cheio)" : "");
+    printf("%-4s %-8s %6s %8s %8s %8s %8s %7s\n", "pino", "rajada", "toques", "min_us", "med_us",
+           "p90_us", "max_us", "bordas");
+
+    for (uint i = 0; i < BOUNCE_PROF_PINS; i++) {
+        collect_bursts(i);
+        uint press_count = presses.count;
+        uint32_t worst = print_bursts(pin_names[i], "aperto", &presses);
+        uint32_t release_worst = print_bursts(pin_names[i], "soltura", &releases);
+
+        if (release_worst > worst) {
+            worst = release_worst;
+        }
+        if (press_count >= BOUNCE_PROF_MIN_PRESSES) {
+            uint32_t margin_us = worst * (100 + BOUNCE_PROF_MARGIN_PCT) / 100;
+            suggestion[i] = (margin_us + 999) / 1000 + 1; // + 1 tick da roda de temporizadores
+        }
+    }
+
+    printf("%-4s %10s %10s\n", "pino", "atual_ms", "sugerido_ms");
+    for (uint i = 0; i < BOUNCE_PROF_PINS; i++) {
+        uint16_t current = gpio_irq_manager_get_debounce(pins[i]);
+
+        if (suggestion[i] == 0) {
+            printf("%-4s %10u %10s (menos de %d toques)\n", pin_names[i], current, "-",
+                   BOUNCE_PROF_MIN_PRESSES);
+            continue;
+        }
+        printf("%-4s %10u %10u", pin_names[i], current, suggestion[i]);
+        if (apply && callbacks[pins[i]] != NULL) {
+            gpio_irq_manager_set_debounce(pins[i], suggestion[i]);
+            printf(" aplicado");
+        }
+        printf("\n");
+    }
+    if (!apply) {
+        printf("Use 'D' para medir de novo e aplicar as sugestoes\n");
+    }
+}
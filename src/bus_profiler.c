@@ -0,0 +1,264 @@
+#include "inc/bus_profiler.h"
+#include "hardware/structs/busctrl.h"
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file bus_profiler.c
+ * @brief Implementação da medição de contenção no barramento
+ *
+ * Este arquivo implementa as funções declaradas em `bus_profiler.h`. Cada janela zera os
+ * quatro contadores do BUSCTRL, aguarda o tempo configurado e copia os valores finais.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Valor máximo dos contadores (24 bits, saturantes).
+ */
+#define BUS_PROF_COUNTER_MAX 0xFFFFFFu
+
+/**
+ * @brief Eventos programados em cada contador para cada conjunto predefinido.
+ */
+static const bus_ctrl_perf_counter_t preset_events[BUS_PROF_PRESET_COUNT][BUS_PROF_COUNTERS] = {
+    [BUS_PROF_PRESET_SRAM_STRIPED] = {
+        arbiter_sram0_perf_event_access_contested,
+        arbiter_sram1_perf_event_access_contested,
+        arbiter_sram2_perf_event_access_contested,
+        arbiter_sram3_perf_event_access_contested,
+    },
+    [BUS_PROF_PRESET_SRAM_SCRATCH] = {
+        arbiter_sram4_perf_event_access,
+        arbiter_sram4_perf_event_access_contested,
+        arbiter_sram5_perf_event_access,
+        arbiter_sram5_perf_event_access_contested,
+    },
+    [BUS_PROF_PRESET_PERIPH] = {
+        arbiter_apb_perf_event_access,
+        arbiter_apb_perf_event_access_contested,
+        arbiter_xip_main_perf_event_access,
+        arbiter_xip_main_perf_event_access_contested,
+    },
+};
+
+/**
+ * @brief Nomes dos conjuntos e de cada contador, usados no relatório.
+ */
+static const char *preset_names[BUS_PROF_PRESET_COUNT] = {
+    "sram0-3", "scratch", "periph"
+};
+
+/**
+ * @brief Contadores de acessos disputados em cada conjunto (um bit por contador).
+ */
+static const uint8_t contested_mask[BUS_PROF_PRESET_COUNT] = { 0xF, 0xA, 0xA };
+
+static const char *counter_names[BUS_PROF_PRESET_COUNT][BUS_PROF_COUNTERS] = {
+    {"sram0_disp", "sram1_disp", "sram2_disp", "sram3_disp"},
+    {"sram4_acc", "sram4_disp", "sram5_acc", "sram5_disp"},
+    {"apb_acc", "apb_disp", "xip_acc", "xip_disp"},
+};
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static bus_prof_preset_t current_preset = BUS_PROF_PRESET_SRAM_STRIPED;
+static uint32_t window_len_ms = BUS_PROF_DEFAULT_WINDOW_MS;
+static uint32_t window_start_us;
+static absolute_time_t window_end;
+static bool running = false;
+static bus_prof_result_t last_result = {0};
+static bool dma_priority_high = false;
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Duração da última janela em milissegundos (no mínimo 1).
+ */
+static uint32_t window_ms_of(const bus_prof_result_t *r) {
+    return r->window_us / 1000 ? r->window_us / 1000 : 1;
+}
+
+/**
+ * @brief Zera os contadores e marca o início de uma nova janela.
+ */
+static void restart_window() {
+    for (int i = 0; i < BUS_PROF_COUNTERS; i++) {
+        busctrl_hw->counter[i].value = 0; // Qualquer escrita zera o contador
+    }
+    window_start_us = time_us_32();
+    window_end = make_timeout_time_ms(window_len_ms);
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Programa os contadores com um conjunto de eventos e inicia uma janela de medição.
+ *
+ * @param preset Conjunto de eventos a medir.
+ * @param window_ms Duração de cada janela em milissegundos.
+ */
+void bus_profiler_start(bus_prof_preset_t preset, uint32_t window_ms) {
+    if (preset >= BUS_PROF_PRESET_COUNT) {
+        preset = BUS_PROF_PRESET_SRAM_STRIPED;
+    }
+    current_preset = preset;
+    window_len_ms = window_ms ? window_ms : BUS_PROF_DEFAULT_WINDOW_MS;
+
+    for (int i = 0; i < BUS_PROF_COUNTERS; i++) {
+        busctrl_hw->counter[i].sel = preset_events[preset][i]; // Seleciona o evento de cada contador
+    }
+
+    last_result = (bus_prof_result_t){ .preset = preset };
+    running = true;
+    restart_window();
+}
+
+/**
+ * @brief Verifica se a janela atual terminou e, nesse caso, guarda o resultado e inicia outra.
+ */
+void bus_profiler_poll() {
+    if (!running || !time_reached(window_end)) {
+        return;
+    }
+
+    bool saturated = false;
+    for (int i = 0; i < BUS_PROF_COUNTERS; i++) {
+        last_result.counts[i] = busctrl_hw->counter[i].value;
+        saturated |= last_result.counts[i] >= BUS_PROF_COUNTER_MAX;
+    }
+    last_result.window_us = time_us_32() - window_start_us;
+    last_result.saturated = saturated;
+    last_result.windows++;
+
+    restart_window();
+}
+
+/**
+ * @brief Avança para o próximo conjunto de eventos, mantendo a duração da janela.
+ */
+void bus_profiler_next_preset() {
+    bus_profiler_start((current_preset + 1) % BUS_PROF_PRESET_COUNT, window_len_ms);
+    printf("\nBusctrl: medindo %s\n", preset_names[current_preset]);
+}
+
+/**
+ * @brief Obtém o resultado da última janela completa.
+ *
+ * @return Ponteiro para o resultado (somente leitura).
+ */
+const bus_prof_result_t *bus_profiler_result() {
+    return &last_result;
+}
+
+/**
+ * @brief Mede um trecho de código com um conjunto de eventos, fora das janelas periódicas.
+ *
+ * @param preset Conjunto de eventos a medir.
+ * @param work Função a ser medida.
+ * @param counts Vetor que recebe o valor final de cada contador.
+ */
+void bus_profiler_sample(bus_prof_preset_t preset, void (*work)(void), uint32_t counts[BUS_PROF_COUNTERS]) {
+    for (int i = 0; i < BUS_PROF_COUNTERS; i++) {
+        busctrl_hw->counter[i].sel = preset_events[preset][i];
+        busctrl_hw->counter[i].value = 0;
+    }
+
+    work();
+
+    for (int i = 0; i < BUS_PROF_COUNTERS; i++) {
+        counts[i] = busctrl_hw->counter[i].value;
+    }
+
+    if (running) {
+        for (int i = 0; i < BUS_PROF_COUNTERS; i++) {
+            busctrl_hw->counter[i].sel = preset_events[current_preset][i];
+        }
+        restart_window(); // A janela interrompida é descartada
+    }
+}
+
+/**
+ * @brief Obtém o nome curto de um conjunto de eventos.
+ *
+ * @param preset Conjunto de eventos.
+ * @return Nome usado no relatório e no status.
+ */
+const char *bus_profiler_preset_name(bus_prof_preset_t preset) {
+    return preset < BUS_PROF_PRESET_COUNT ? preset_names[preset] : "?";
+}
+
+/**
+ * @brief Soma dos contadores de acessos disputados da última janela, por milissegundo.
+ *
+ * @return Acessos disputados por milissegundo, ou 0 antes da primeira janela completa.
+ */
+uint32_t bus_profiler_contested_per_ms() {
+    const bus_prof_result_t *r = &last_result;
+    uint32_t sum = 0;
+
+    if (r->windows == 0) {
+        return 0;
+    }
+    for (int i = 0; i < BUS_PROF_COUNTERS; i++) {
+        if (contested_mask[r->preset] & (1u << i)) {
+            sum += r->counts[i];
+        }
+    }
+    return sum / window_ms_of(r);
+}
+
+/**
+ * @brief Imprime o resultado da última janela completa.
+ *
+ * Além dos valores brutos, exibe cada contador em eventos por milissegundo para que janelas de
+ * durações diferentes possam ser comparadas.
+ */
+void bus_profiler_report() {
+    const bus_prof_result_t *r = &last_result;
+
+    if (r->windows == 0) {
+        printf("\nBusctrl: nenhuma janela completa ainda\n");
+        return;
+    }
+
+    uint32_t window_ms = window_ms_of(r);
+    printf("\n--- Contencao no barramento (%s, janela %lu ms%s%s) ---\n",
+           preset_names[r->preset], (unsigned long)window_ms, r->saturated ? ", SATURADO" : "",
+           dma_priority_high ? ", DMA prioritaria" : "");
+    for (int i = 0; i < BUS_PROF_COUNTERS; i++) {
+        printf("%-11s %9lu  (%lu/ms)\n", counter_names[r->preset][i],
+               (unsigned long)r->counts[i], (unsigned long)(r->counts[i] / window_ms));
+    }
+}
+
+/**
+ * @brief Dá prioridade alta no barramento às leituras e escritas da DMA.
+ *
+ * @param high true para prioridade alta, false para a prioridade padrão.
+ */
+void bus_profiler_set_dma_priority(bool high) {
+    const uint32_t dma_bits = BUSCTRL_BUS_PRIORITY_DMA_R_BITS | BUSCTRL_BUS_PRIORITY_DMA_W_BITS;
+
+    if (high) {
+        hw_set_bits(&busctrl_hw->priority, dma_bits);
+    } else {
+        hw_clear_bits(&busctrl_hw->priority, dma_bits);
+    }
+    dma_priority_high = high;
+
+    while (busctrl_hw->priority_ack == 0) {
+        tight_loop_contents(); // Aguarda o árbitro aplicar a nova prioridade
+    }
+}
@@ -0,0 +1,199 @@
+#include "inc/control_latency.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file control_latency.c
+ * @brief Implementação da medição de latência de controle declarada em `control_latency.h`
+ *
+ * Todos os estágios são chamados por tarefas do escalonador (cooperativo), nunca por ISRs, então
+ * o estado não precisa de proteção contra interrupções.
+ */
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Intervalos entre estágios consecutivos de um evento de controle.
+ */
+typedef enum {
+    SPAN_WAIT = 0,  // Primeira leitura com movimento -> leitura do sequenciador
+    SPAN_FILTER,    // Leitura do sequenciador -> multiplicador
+    SPAN_APPLY,     // Multiplicador -> início da nota
+    SPAN_COMMIT,    // Início da nota -> registradores do PWM
+    SPAN_COUNT
+} control_span_t;
+
+static const char *span_names[SPAN_COUNT] = {
+    "espera pela nota", "adc -> filtro", "filtro -> sequenciador", "sequenciador -> pwm",
+};
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static struct {
+    uint64_t total_us;
+    uint32_t max_us;
+} spans[SPAN_COUNT];
+
+static uint32_t histogram[CONTROL_LATENCY_BINS];
+static uint32_t events;
+static uint64_t latency_total_us;
+static uint32_t latency_min_us = UINT32_MAX, latency_max_us;
+
+// Evento em andamento
+static bool has_reference, pending;
+static uint16_t reference_x, adc_x;
+static uint32_t seen_us, adc_us, filter_us, apply_us;
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Abre um evento de controle se a leitura se afastou da referência.
+ */
+static void check_movement(uint16_t x, uint32_t now) {
+    if (has_reference && !pending && abs((int)x - (int)reference_x) > CONTROL_LATENCY_THRESHOLD) {
+        pending = true;
+        seen_us = now;
+    }
+}
+
+static void add_span(control_span_t span, uint32_t us) {
+    spans[span].total_us += us;
+    if (us > spans[span].max_us) {
+        spans[span].max_us = us;
+    }
+}
+
+/**
+ * @brief Classe do histograma para uma latência em microssegundos.
+ */
+static uint bin_of(uint32_t us) {
+    uint32_t ms = us / 1000;
+    uint bin = 0;
+
+    while (ms > 0 && bin < CONTROL_LATENCY_BINS - 1) {
+        ms >>= 1;
+        bin++;
+    }
+    return bin;
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Registra uma leitura do eixo X feita fora do sequenciador (ex.: status).
+ *
+ * @param x Valor lido (0-4095).
+ */
+void control_latency_seen(uint16_t x) {
+    check_movement(x, time_us_32());
+}
+
+/**
+ * @brief Estágio 1: leitura do eixo X feita pelo sequenciador.
+ *
+ * @param x Valor lido (0-4095).
+ */
+void control_latency_adc(uint16_t x) {
+    adc_us = time_us_32();
+    adc_x = x;
+    check_movement(x, adc_us);
+}
+
+/**
+ * @brief Estágio 2: multiplicador calculado a partir da última leitura do sequenciador.
+ */
+void control_latency_filter() {
+    filter_us = time_us_32();
+}
+
+/**
+ * @brief Estágio 3: multiplicador aplicado à frequência da nota que vai começar.
+ */
+void control_latency_apply() {
+    apply_us = time_us_32();
+}
+
+/**
+ * @brief Estágio 4: registradores do PWM escritos; fecha o evento de controle pendente.
+ */
+void control_latency_commit() {
+    uint32_t now = time_us_32();
+
+    if (pending) {
+        uint32_t latency = now - seen_us;
+
+        add_span(SPAN_WAIT, adc_us - seen_us);
+        add_span(SPAN_FILTER, filter_us - adc_us);
+        add_span(SPAN_APPLY, apply_us - filter_us);
+        add_span(SPAN_COMMIT, now - apply_us);
+
+        histogram[bin_of(latency)]++;
+        events++;
+        latency_total_us += latency;
+        if (latency < latency_min_us) latency_min_us = latency;
+        if (latency > latency_max_us) latency_max_us = latency;
+        pending = false;
+    }
+
+    // A altura aplicada passa a ser a referência para o próximo movimento
+    reference_x = adc_x;
+    has_reference = true;
+}
+
+/**
+ * @brief Imprime a distribuição da latência e os tempos por estágio, e reinicia as estatísticas.
+ */
+void control_latency_report() {
+    printf("\n--- Latencia joystick -> altura (%lu eventos) ---\n", (unsigned long)events);
+    if (events == 0) {
+        printf("Nenhum movimento aplicado: mova o eixo X durante uma musica\n");
+        return;
+    }
+
+    printf("total: min %lu us | media %lu us | max %lu us\n", (unsigned long)latency_min_us,
+           (unsigned long)(latency_total_us / events), (unsigned long)latency_max_us);
+
+    printf("%-12s %8s\n", "classe_ms", "eventos");
+    for (uint bin = 0; bin < CONTROL_LATENCY_BINS; bin++) {
+        if (histogram[bin] == 0) {
+            continue;
+        }
+        if (bin == 0) {
+            printf("%-12s %8lu\n", "< 1", (unsigned long)histogram[bin]);
+        } else if (bin == CONTROL_LATENCY_BINS - 1) {
+            printf(">= %-9lu %8lu\n", 1ul << (bin - 1), (unsigned long)histogram[bin]);
+        } else {
+            printf("%5lu-%-6lu %8lu\n", 1ul << (bin - 1), (1ul << bin) - 1, (unsigned long)histogram[bin]);
+        }
+    }
+
+    printf("%-24s %10s %10s\n", "estagio", "media_us", "max_us");
+    for (int span = 0; span < SPAN_COUNT; span++) {
+        printf("%-24s %10lu %10lu\n", span_names[span], (unsigned long)(spans[span].total_us / events),
+               (unsigned long)spans[span].max_us);
+    }
+
+    for (int span = 0; span < SPAN_COUNT; span++) {
+        spans[span].total_us = 0;
+        spans[span].max_us = 0;
+    }
+    for (uint bin = 0; bin < CONTROL_LATENCY_BINS; bin++) {
+        histogram[bin] = 0;
+    }
+    events = 0;
+    latency_total_us = 0;
+    latency_min_us = UINT32_MAX;
+    latency_max_us = 0;
+}
@@ -1,5 +1,9 @@
 // gpio_irq_manager.c
 #include "inc/gpio_irq_manager.h"
+#include "inc/xip_profiler.h"
+#include "inc/irq_priority.h"
+#include "inc/timer_wheel.h"
+#include "inc/input_trace.h"
 
 /******************************
  * Documentação do Arquivo
@@ -17,7 +21,10 @@
  * Funcionalidades:
  * 1. Registro de callbacks para eventos GPIO.
  * 2. Remoção de callbacks registrados.
- * 3. Tratamento de debounce para evitar múltiplas interrupções causadas por ruídos.
+ * 3. Tratamento de debounce para evitar múltiplas interrupções causadas por ruídos, com um
+ *    temporizador de `timer_wheel.h` por pino (sem consultar o relógio a cada borda). Toda borda
+ *    do pino, inclusive a oposta à do callback, rearma o bloqueio: o repique ao soltar o botão
+ *    fica coberto mesmo depois de um toque longo.
  * 4. Inicialização do gerenciador de interrupções.
  */
 
@@ -28,9 +35,21 @@
 /**
  * @brief Tempo de debounce em milissegundos.
  * 
- * Define o intervalo mínimo entre duas interrupções consecutivas para evitar ruídos.
+ * Define o silêncio mínimo depois de qualquer borda do pino para aceitar a próxima. Como o
+ * bloqueio recomeça a cada borda, basta cobrir o maior intervalo entre bordas de uma mesma rajada
+ * de repique: `BOUNCE_PROF_GAP_US` (20 ms, o que separa rajadas em `bounce_profiler.h`) mais um tick
+ * da roda de temporizadores. Um valor maior soma-se ao tempo em que o botão fica apertado e
+ * descarta toques rápidos. Pode ser sobrescrito na compilação (o GENIUS_bench usa 1 ms para repetir
+ * o caminho aceito).
  */
-#define DEBOUNCE_DELAY_MS 200
+#ifndef DEBOUNCE_DELAY_MS
+#define DEBOUNCE_DELAY_MS 21
+#endif
+
+/**
+ * @brief Bordas que rearmam o bloqueio de debounce.
+ */
+#define DEBOUNCE_EDGES (GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL)
 
 /******************************
  * Variáveis Globais
@@ -45,12 +64,40 @@
 void (*callbacks[MAX_GPIO_PINS])(void) = {NULL};
 
 /**
- * @brief Array para armazenar o último tempo de interrupção para cada pino.
+ * @brief Temporizadores de bloqueio do debounce, um por pino.
+ * 
+ * Enquanto o temporizador de um pino estiver armado (`DEBOUNCE_DELAY_MS` após a última
+ * interrupção aceita), novas interrupções desse pino são ignoradas.
+ */
+static timer_wheel_timer_t debounce_timers[MAX_GPIO_PINS];
+
+/**
+ * @brief Tempo de debounce de cada pino em milissegundos (0 = sem debounce).
  * 
- * Usado para implementar o debounce, garantindo que interrupções consecutivas sejam ignoradas
- * se ocorrerem dentro do intervalo de tempo definido por `DEBOUNCE_DELAY_MS`.
+ * Volta a `DEBOUNCE_DELAY_MS` a cada `register_gpio_callback()`.
+ */
+static uint16_t debounce_ms[MAX_GPIO_PINS];
+
+/**
+ * @brief Bordas habilitadas só para rearmar o debounce (não chamam o callback), por pino.
  */
-absolute_time_t last_interrupt_time[MAX_GPIO_PINS];
+static uint32_t lockout_edges[MAX_GPIO_PINS];
+
+/**
+ * @brief Instante de entrada do `gpio_irq_handler` em atendimento.
+ */
+static volatile uint32_t edge_time_us;
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Fim do bloqueio de debounce: basta o temporizador deixar de estar armado.
+ */
+static void debounce_expired(timer_wheel_timer_t *timer) {
+    (void)timer;
+}
 
 /******************************
  * Funções
@@ -60,28 +107,37 @@ absolute_time_t last_interrupt_time[MAX_GPIO_PINS];
  * @brief Função de tratamento de interrupções GPIO.
  * 
  * Esta função é chamada automaticamente pelo hardware quando ocorre uma interrupção GPIO.
- * Ela verifica se o pino GPIO é válido, se há um callback registrado e se o tempo desde a última
- * interrupção é maior que o tempo de debounce. Se todas as condições forem atendidas, o callback
- * correspondente é chamado.
+ * Ela verifica se o pino GPIO é válido, se há um callback registrado e se o pino não está no
+ * bloqueio de debounce. Qualquer borda de um pino com debounce (re)arma o bloqueio; o callback só é
+ * chamado se o pino estava livre e a borda é uma das registradas.
+ * 
+ * Executa a partir da SRAM quando `GENIUS_HOT_IN_RAM` está habilitado.
  * 
  * @param gpio Pino GPIO que gerou a interrupção.
  * @param events Eventos que causaram a interrupção (borda de subida, descida, etc.).
  */
-void gpio_irq_handler(uint gpio, uint32_t events) {
+void GENIUS_HOT_FUNC(gpio_irq_handler)(uint gpio, uint32_t events) {
+    edge_time_us = time_us_32(); // Antes de qualquer processamento: referência dos callbacks
+    XIP_PROFILE_BEGIN(XIP_PROF_IRQ);
+    INPUT_TRACE_EDGE(gpio, events);
+
     // Verifica se o pino é válido e se há um callback registrado
     if (gpio < MAX_GPIO_PINS && callbacks[gpio] != NULL) {
-        // Obtém o tempo atual
-        absolute_time_t now = get_absolute_time();
+        bool accept = (events & ~lockout_edges[gpio]) != 0;
 
-        // Verifica se o tempo desde a última interrupção é maior que o tempo de debounce
-        if (absolute_time_diff_us(last_interrupt_time[gpio], now) > DEBOUNCE_DELAY_MS * 1000) {
-            // Atualiza o tempo da última interrupção
-            last_interrupt_time[gpio] = now;
+        if (debounce_ms[gpio] != 0) {
+            // Ignora a borda se o pino ainda estiver no bloqueio, que recomeça a cada borda
+            accept = accept && !timer_wheel_pending(&debounce_timers[gpio]);
+            timer_wheel_start(&debounce_timers[gpio], debounce_ms[gpio]);
+        }
 
+        if (accept) {
             // Chama a função de callback correspondente ao pino
             callbacks[gpio]();
         }
     }
+
+    XIP_PROFILE_END(XIP_PROF_IRQ);
 }
 
 /**
@@ -94,7 +150,10 @@ void gpio_irq_handler(uint gpio, uint32_t events) {
 void register_gpio_callback(uint gpio, void (*callback)(void), uint32_t event_mask) {
     if (gpio < MAX_GPIO_PINS) {
         callbacks[gpio] = callback; // Armazena a função no vetor de callbacks
-        gpio_set_irq_enabled(gpio, event_mask, true); // Habilita a interrupção para o evento especificado
+        debounce_ms[gpio] = DEBOUNCE_DELAY_MS; // Debounce padrão
+        // A borda oposta também é observada, só para rearmar o debounce
+        lockout_edges[gpio] = (event_mask & DEBOUNCE_EDGES) ? DEBOUNCE_EDGES & ~event_mask : 0;
+        gpio_set_irq_enabled(gpio, event_mask | lockout_edges[gpio], true); // Habilita a interrupção para o evento especificado
     }
 }
 
@@ -107,16 +166,61 @@ void register_gpio_callback(uint gpio, void (*callback)(void), uint32_t event_ma
 void remove_gpio_callback(uint gpio, uint32_t event_mask) {
     if (gpio < MAX_GPIO_PINS) {
         callbacks[gpio] = NULL; // Remove a função do vetor de callbacks
-        gpio_set_irq_enabled(gpio, event_mask, false); // Desabilita interrupção
+        gpio_set_irq_enabled(gpio, event_mask | lockout_edges[gpio], false); // Desabilita interrupção
+        lockout_edges[gpio] = 0;
     }
 }
 
+/**
+ * @brief Altera o tempo de debounce de um pino com callback registrado.
+ * 
+ * @param gpio Pino GPIO.
+ * @param ms Intervalo mínimo entre interrupções aceitas, em milissegundos (0 desabilita o debounce).
+ */
+void gpio_irq_manager_set_debounce(uint gpio, uint16_t ms) {
+    if (gpio < MAX_GPIO_PINS) {
+        debounce_ms[gpio] = ms;
+        if (ms == 0) {
+            timer_wheel_cancel(&debounce_timers[gpio]); // Libera um bloqueio em andamento
+        }
+    }
+}
+
+/**
+ * @brief Obtém o tempo de debounce de um pino.
+ * 
+ * @param gpio Pino GPIO.
+ * @return Intervalo de bloqueio em milissegundos (0 = sem debounce ou pino inválido).
+ */
+uint16_t gpio_irq_manager_get_debounce(uint gpio) {
+    return gpio < MAX_GPIO_PINS ? debounce_ms[gpio] : 0;
+}
+
+/**
+ * @brief Instante em que a borda atual chegou ao `gpio_irq_handler`.
+ * 
+ * Só é válido dentro de um callback: é a marca de tempo da borda, sem a latência do despacho.
+ * 
+ * @return Valor de `time_us_32()` na entrada da interrupção.
+ */
+uint32_t GENIUS_HOT_FUNC(gpio_irq_manager_edge_time_us)() {
+    return edge_time_us;
+}
+
 /**
  * @brief Inicializa o gerenciador de interrupções GPIO.
  * 
- * Configura a função de tratamento de interrupções global e habilita interrupções no banco de GPIOs.
+ * Prepara os temporizadores de debounce, configura a função de tratamento de interrupções global,
+ * aplica a prioridade do banco de GPIOs definida em `irq_priority.h` e habilita as interrupções do
+ * banco. Requer `timer_wheel_init()` já chamado.
  */
 void gpio_irq_manager_init() {
+    for (uint gpio = 0; gpio < MAX_GPIO_PINS; gpio++) {
+        if (!timer_wheel_pending(&debounce_timers[gpio])) { // Pode ser chamada a cada ButtonPi_init
+            timer_wheel_timer_init(&debounce_timers[gpio], debounce_expired, NULL);
+        }
+    }
     gpio_set_irq_callback(gpio_irq_handler); // Configura a função mestra como callback global
+    irq_set_priority(IO_IRQ_BANK0, IRQ_PRIORITY_INPUT); // Botões abaixo do áudio e do temporizador
     irq_set_enabled(IO_IRQ_BANK0, true); // Habilita interrupções no banco de GPIOs
 }
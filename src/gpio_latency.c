@@ -0,0 +1,297 @@
+#include "inc/gpio_latency.h"
+#include "inc/gpio_irq_manager.h"
+#include "inc/JoystickPi.h"
+#include "inc/irq_priority.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/irq.h"
+#include "hardware/structs/sio.h"
+#include "hardware/structs/systick.h"
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file gpio_latency.c
+ * @brief Implementação do benchmark de latência borda-callback das interrupções GPIO
+ *
+ * Este arquivo implementa a função declarada em `gpio_latency.h`. Como em `irq_latency.c`, o
+ * SysTick é usado como contador de ciclos de 24 bits (decrescente).
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define SYSTICK_MAX 0xFFFFFFu
+#define BENCH_EDGES (GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL)
+
+/**
+ * @brief Caminhos de despacho medidos.
+ */
+enum { PATH_SHARED, PATH_RAW, PATH_DEFERRED, PATH_COUNT };
+
+static const char *path_names[PATH_COUNT] = { "compartilhado", "bruto", "adiado" };
+
+/**
+ * @brief Cargas sintéticas aplicadas durante as medições.
+ */
+enum { LOAD_USB = 1 << 0, LOAD_ADC = 1 << 1 };
+
+static const char *load_names[] = { "nenhuma", "usb", "adc", "usb+adc" };
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static volatile uint32_t isr_stamp;
+static volatile bool isr_fired;
+static uint defer_irq;
+static uint16_t histogram[GPIO_BENCH_BINS];
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Registra o instante de entrada no código de tratamento.
+ */
+static inline void stamp(uint32_t cvr) {
+    isr_stamp = cvr;
+    isr_fired = true;
+}
+
+/**
+ * @brief Callback do caminho compartilhado (chamado por `gpio_irq_handler`).
+ */
+static void __not_in_flash_func(shared_callback)() {
+    stamp(systick_hw->cvr);
+}
+
+/**
+ * @brief Handler bruto: reconhece a borda do pino de teste e registra o instante.
+ */
+static void __not_in_flash_func(raw_handler)() {
+    uint32_t cvr = systick_hw->cvr;
+    uint32_t events = gpio_get_irq_event_mask(GPIO_BENCH_PIN);
+
+    if (events & BENCH_EDGES) {
+        gpio_acknowledge_irq(GPIO_BENCH_PIN, events);
+        stamp(cvr);
+    }
+}
+
+/**
+ * @brief Handler bruto do caminho adiado: reconhece a borda e pende a interrupção de fundo.
+ */
+static void __not_in_flash_func(defer_handler)() {
+    uint32_t events = gpio_get_irq_event_mask(GPIO_BENCH_PIN);
+
+    if (events & BENCH_EDGES) {
+        gpio_acknowledge_irq(GPIO_BENCH_PIN, events);
+        irq_set_pending(defer_irq);
+    }
+}
+
+/**
+ * @brief Interrupção de fundo do caminho adiado: executa o "callback".
+ */
+static void __not_in_flash_func(deferred_callback)() {
+    stamp(systick_hw->cvr);
+}
+
+/**
+ * @brief ISR da carga de ADC: descarta as conversões acumuladas na FIFO.
+ */
+static void __not_in_flash_func(adc_load_isr)() {
+    while (!adc_fifo_is_empty()) {
+        (void)adc_fifo_get();
+    }
+}
+
+/**
+ * @brief Liga ou desliga a conversão contínua do ADC com interrupção da FIFO.
+ *
+ * @param enable true para iniciar a carga, false para devolver o ADC às leituras do joystick.
+ */
+static void adc_load(bool enable) {
+    if (enable) {
+        adc_fifo_setup(true, false, 1, false, false); // Interrupção a cada conversão
+        adc_set_clkdiv(clock_get_hz(clk_adc) / GPIO_BENCH_ADC_HZ - 1); // clk_adc real, não os 48 MHz nominais
+        irq_set_exclusive_handler(ADC_IRQ_FIFO, adc_load_isr);
+        irq_set_priority(ADC_IRQ_FIFO, IRQ_PRIORITY_INPUT);
+        adc_irq_set_enabled(true);
+        irq_set_enabled(ADC_IRQ_FIFO, true);
+        adc_run(true);
+    } else {
+        adc_run(false);
+        irq_set_enabled(ADC_IRQ_FIFO, false);
+        adc_irq_set_enabled(false);
+        irq_remove_handler(ADC_IRQ_FIFO, adc_load_isr);
+        adc_fifo_setup(false, false, 0, false, false);
+        adc_fifo_drain();
+        adc_set_clkdiv(0);
+    }
+}
+
+/**
+ * @brief Conecta ou desconecta o pino de teste do caminho de despacho.
+ *
+ * @param path Caminho (`PATH_SHARED`, `PATH_RAW` ou `PATH_DEFERRED`).
+ * @param attach true para conectar, false para desconectar.
+ */
+static void attach_path(int path, bool attach) {
+    irq_handler_t raw = path == PATH_RAW ? raw_handler : defer_handler;
+
+    if (path == PATH_SHARED) {
+        if (attach) {
+            register_gpio_callback(GPIO_BENCH_PIN, shared_callback, BENCH_EDGES);
+            gpio_irq_manager_set_debounce(GPIO_BENCH_PIN, 0); // Cada borda deve chegar ao callback
+        } else {
+            remove_gpio_callback(GPIO_BENCH_PIN, BENCH_EDGES);
+        }
+    } else if (attach) {
+        gpio_add_raw_irq_handler(GPIO_BENCH_PIN, raw);
+        gpio_set_irq_enabled(GPIO_BENCH_PIN, BENCH_EDGES, true);
+    } else {
+        gpio_set_irq_enabled(GPIO_BENCH_PIN, BENCH_EDGES, false);
+        gpio_remove_raw_irq_handler(GPIO_BENCH_PIN, raw);
+    }
+}
+
+/**
+ * @brief Percorre o histograma até a fração acumulada pedida.
+ *
+ * @param count Número de amostras no histograma.
+ * @param permille Fração em milésimos (500 = mediana).
+ * @return Limite inferior da classe, em ciclos.
+ */
+static uint32_t percentile(uint32_t count, uint32_t permille) {
+    uint32_t target = (count * permille + 999) / 1000;
+    uint32_t seen = 0;
+
+    for (int bin = 0; bin < GPIO_BENCH_BINS; bin++) {
+        seen += histogram[bin];
+        if (seen >= target) {
+            return bin * GPIO_BENCH_BIN_CYCLES;
+        }
+    }
+    return (GPIO_BENCH_BINS - 1) * GPIO_BENCH_BIN_CYCLES;
+}
+
+/**
+ * @brief Mede a latência de um caminho sob uma combinação de cargas.
+ *
+ * @param path Caminho de despacho.
+ * @param load Máscara de cargas (`LOAD_USB`, `LOAD_ADC`).
+ */
+static void measure(int path, int load) {
+    uint32_t min = SYSTICK_MAX, max = 0, count = 0, lost = 0;
+
+    for (int bin = 0; bin < GPIO_BENCH_BINS; bin++) {
+        histogram[bin] = 0;
+    }
+
+    attach_path(path, true);
+    if (load & LOAD_ADC) {
+        adc_load(true);
+    }
+
+    for (int i = 0; i < GPIO_BENCH_SAMPLES; i++) {
+        if (load & LOAD_USB) {
+            printf("................................................................\r");
+        }
+
+        isr_fired = false;
+        uint32_t deadline = time_us_32() + GPIO_BENCH_TIMEOUT_US;
+        uint32_t start = systick_hw->cvr;
+        sio_hw->gpio_togl = BOARD_PIN_MASK(GPIO_BENCH_PIN); // A borda
+        while (!isr_fired && (int32_t)(time_us_32() - deadline) < 0) {
+            tight_loop_contents();
+        }
+        if (!isr_fired) {
+            lost++;
+            continue;
+        }
+
+        uint32_t cycles = (start - isr_stamp) & SYSTICK_MAX; // Contador decrescente
+        uint32_t bin = cycles / GPIO_BENCH_BIN_CYCLES;
+        histogram[bin < GPIO_BENCH_BINS ? bin : GPIO_BENCH_BINS - 1]++;
+        count++;
+        if (cycles < min) min = cycles;
+        if (cycles > max) max = cycles;
+    }
+
+    if (load & LOAD_ADC) {
+        adc_load(false);
+    }
+    attach_path(path, false);
+
+    if (count == 0) {
+        printf("%-13s %-8s sem bordas: o pino %d esta preso por um circuito externo?\n",
+               path_names[path], load_names[load], GPIO_BENCH_PIN);
+        return;
+    }
+
+    uint32_t mhz = clock_get_hz(clk_sys) / 1000000;
+    printf("%-13s %-8s %6lu %7lu %6lu %6lu %8lu %8lu\n", path_names[path], load_names[load],
+           (unsigned long)min, (unsigned long)percentile(count, 500),
+           (unsigned long)percentile(count, 990), (unsigned long)max,
+           (unsigned long)(max * 1000 / mhz), (unsigned long)lost);
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Executa o benchmark e imprime mínimo, mediana, p99 e máximo (ciclos) de cada caminho.
+ *
+ * A latência inclui os dois ciclos de sincronização da entrada do GPIO; a diferença entre os
+ * caminhos é o custo de despacho de cada um.
+ */
+void gpio_latency_benchmark() {
+    if (!joystickPi_adc_claim("latencia GPIO")) { // A carga de ADC muda a FIFO e o divisor
+        printf("\nLatencia GPIO: ADC ocupado (%s)\n", joystickPi_adc_owner());
+        return;
+    }
+
+    uint32_t saved_csr = systick_hw->csr;
+    uint32_t saved_rvr = systick_hw->rvr;
+
+    systick_hw->csr = 0;
+    systick_hw->rvr = SYSTICK_MAX;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5; // ENABLE | CLKSOURCE (clock do processador)
+
+    defer_irq = user_irq_claim_unused(true);
+    irq_set_exclusive_handler(defer_irq, deferred_callback);
+    irq_set_priority(defer_irq, IRQ_PRIORITY_BACKGROUND);
+    irq_set_enabled(defer_irq, true);
+
+    gpio_init(GPIO_BENCH_PIN);
+    gpio_put(GPIO_BENCH_PIN, 0);
+    gpio_set_dir(GPIO_BENCH_PIN, GPIO_OUT);
+
+    printf("\n--- Latencia borda-callback GPIO (ciclos, classes de %d) ---\n", GPIO_BENCH_BIN_CYCLES);
+    printf("%-13s %-8s %6s %7s %6s %6s %8s %8s\n", "caminho", "carga", "min", "mediana", "p99",
+           "max", "max_ns", "perdidas");
+    for (int path = 0; path < PATH_COUNT; path++) {
+        for (int load = 0; load < (int)count_of(load_names); load++) {
+            measure(path, load);
+        }
+    }
+
+    gpio_init(GPIO_BENCH_PIN); // Volta a ser entrada comum
+
+    irq_set_enabled(defer_irq, false);
+    irq_remove_handler(defer_irq, deferred_callback);
+    user_irq_unclaim(defer_irq);
+
+    systick_hw->csr = 0;
+    systick_hw->rvr = saved_rvr;
+    systick_hw->csr = saved_csr;
+    joystickPi_adc_release();
+}
@@ -0,0 +1,390 @@
+#include "inc/heap_tracker.h"
+#include "hardware/sync.h"
+#include <malloc.h>
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file heap_tracker.c
+ * @brief Implementação do rastreamento de alocações dinâmicas
+ *
+ * Este arquivo implementa as funções declaradas em `heap_tracker.h`. As funções `__wrap_*` só
+ * existem quando `GENIUS_HEAP_TRACK` está habilitado, junto com as opções `--wrap` do ligador
+ * adicionadas pelo CMakeLists.txt.
+ *
+ * As funções públicas (`malloc`, `calloc`, `realloc`) já são interceptadas pelo `pico_malloc` do
+ * SDK, que ocupa o `--wrap` desses símbolos; por isso a interceptação fica nas reentrantes, e o
+ * chamador de uma função pública é lido da pilha. O M0+ não mantém ponteiro de quadro, então a
+ * posição do endereço de retorno é calibrada na partida, com o próprio binário: duas funções de
+ * prova por função pública, em endereços diferentes, chamam a pública; a palavra da pilha (a
+ * partir de uma variável local da reentrante) que contém um retorno em Thumb para dentro da
+ * prova é a posição procurada. A calibração só vale se as duas provas concordarem na posição e
+ * no retorno recebido pela reentrante, o que descarta um valor antigo da pilha que por acaso
+ * caia dentro de uma prova.
+ *
+ * O caminho da pública até a reentrante é sempre o mesmo código compilado, então a posição não
+ * muda entre chamadas (mudanças de otimização mudam o binário e a calibração junto). Modos de
+ * falha:
+ * 1. Calibração recusada (as provas discordam ou o retorno não foi achado): o relatório avisa e
+ *    o endereço registrado é o da newlib, como nas alocações internas.
+ * 2. Uma chamada à reentrante por outro caminho que por acaso receba o mesmo retorno: o endereço
+ *    lido seria de outro quadro. Na prática só a pública chama a reentrante a partir daquele
+ *    ponto; a palavra lida ainda precisa ser um endereço Thumb, senão vale o da newlib.
+ * O GENIUS_bench confere o resultado no hardware (`heap_tracker_last_site()`).
+ */
+
+#if GENIUS_HEAP_TRACK
+
+#include <reent.h>
+#include <stdlib.h>
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define SCAN_WORDS 32    // Palavras da pilha examinadas na calibração
+#define PROBE_BYTES 32   // Tamanho máximo de uma função de prova
+#define PROBES 2         // Provas por função pública (precisam concordar)
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Funções públicas que chegam às reentrantes interceptadas.
+ */
+typedef enum {
+    ENTRY_MALLOC = 0,
+    ENTRY_CALLOC,
+    ENTRY_REALLOC,
+    ENTRY_COUNT
+} heap_entry_t;
+
+/**
+ * @brief Alocações acumuladas de um par (contexto, endereço de chamada).
+ */
+typedef struct {
+    const char *context;  // Subsistema ativo no momento da alocação
+    void *site;           // Quem chamou a função pública (ou a reentrante, nas internas da newlib)
+    uint32_t count;       // Número de alocações
+    uint32_t bytes;       // Total de bytes pedidos
+} heap_site_t;
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static heap_site_t sites[HEAP_TRACK_MAX_SITES];
+static uint32_t site_overflow = 0;     // Alocações que não couberam na tabela
+static uint32_t total_allocs = 0;
+static uint32_t total_bytes = 0;
+static uint32_t total_frees = 0;
+static uint32_t runtime_allocs = 0;    // Alocações após heap_tracker_lock()
+static const char *current_context = "init";
+static void *last_site = NULL;
+static bool locked = false;
+
+// Calibração do chamador das funções públicas
+static struct {
+    void *ret;            // Retorno recebido pela reentrante quando chamada pela pública
+    int slot;             // Palavras entre `marker` e o retorno para quem chamou (-1: não achado)
+} entries[ENTRY_COUNT];
+static int calibrating = -1;           // Entrada em calibração (registro suspenso), ou -1
+static uint probe_index;               // Prova em andamento
+static struct {
+    void *ret;
+    int slot;
+} probe_found[PROBES];
+static uint depth = 0;                 // Reentrantes aninhadas (ex.: `_calloc_r` -> `_malloc_r`)
+static void *volatile probe_ptr;
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Registra uma alocação e aplica o modo estrito.
+ *
+ * @param site Endereço de chamada.
+ * @param bytes Tamanho pedido.
+ */
+static void record_alloc(void *site, size_t bytes) {
+    uint32_t irq_state = save_and_disable_interrupts();
+
+    total_allocs++;
+    total_bytes += bytes;
+    last_site = site;
+    if (locked) {
+        runtime_allocs++;
+    }
+
+    heap_site_t *slot = NULL;
+    for (int i = 0; i < HEAP_TRACK_MAX_SITES; i++) {
+        if (sites[i].count == 0 || (sites[i].site == site && sites[i].context == current_context)) {
+            slot = &sites[i];
+            break;
+        }
+    }
+    if (slot) {
+        slot->context = current_context;
+        slot->site = site;
+        slot->count++;
+        slot->bytes += bytes;
+    } else {
+        site_overflow++;
+    }
+
+    restore_interrupts(irq_state);
+
+#if GENIUS_HEAP_STRICT
+    if (locked) {
+        locked = false; // O próprio panic() imprime e pode alocar
+        panic("alocacao de %u bytes apos a inicializacao (%s, %p)", (unsigned)bytes, current_context, site);
+    }
+#endif
+}
+
+static void __noinline probe_malloc() {
+    probe_ptr = malloc(1);
+}
+
+static void __noinline probe_malloc_b() {
+    probe_ptr = malloc(2);
+}
+
+static void __noinline probe_calloc() {
+    probe_ptr = calloc(1, 1);
+}
+
+static void __noinline probe_calloc_b() {
+    probe_ptr = calloc(1, 2);
+}
+
+static void __noinline probe_realloc() {
+    probe_ptr = realloc(NULL, 1);
+}
+
+static void __noinline probe_realloc_b() {
+    probe_ptr = realloc(NULL, 2);
+}
+
+static void (*const probes[ENTRY_COUNT][PROBES])(void) = {
+    { probe_malloc, probe_malloc_b },
+    { probe_calloc, probe_calloc_b },
+    { probe_realloc, probe_realloc_b },
+};
+
+/**
+ * @brief Endereço a registrar para uma alocação.
+ *
+ * @param entry Função pública correspondente à reentrante interceptada.
+ * @param ret Retorno recebido pela reentrante.
+ * @param marker Variável local da reentrante (referência na pilha).
+ * @return Quem chamou a função pública; `ret` se a reentrante foi chamada diretamente (internas da
+ * newlib) ou se a calibração falhou; NULL durante a calibração desta entrada.
+ */
+static void *__noinline call_site(heap_entry_t entry, void *ret, const volatile uint32_t *marker) {
+    if (calibrating == (int)entry) {
+        uintptr_t start = (uintptr_t)probes[entry][probe_index] & ~1u;
+        probe_found[probe_index].ret = ret;
+        for (int i = 0; i < SCAN_WORDS; i++) {
+            uintptr_t w = marker[i];
+            if ((w & 1u) && (w & ~1u) > start && (w & ~1u) < start + PROBE_BYTES) { // Retorno em Thumb
+                probe_found[probe_index].slot = i;
+                break;
+            }
+        }
+        return NULL;
+    }
+    if (entries[entry].slot >= 0 && ret == entries[entry].ret) {
+        uintptr_t w = marker[entries[entry].slot];
+        if (w & 1u) {
+            return (void *)(w & ~1u);
+        }
+    }
+    return ret;
+}
+
+/**
+ * @brief Calibra o chamador de cada função pública antes do `main()`.
+ */
+static void __attribute__((constructor)) calibrate() {
+    for (int e = 0; e < ENTRY_COUNT; e++) {
+        entries[e].slot = -1;
+        for (probe_index = 0; probe_index < PROBES; probe_index++) {
+            probe_found[probe_index].ret = NULL;
+            probe_found[probe_index].slot = -1;
+            calibrating = e;
+            probes[e][probe_index]();
+            calibrating = ENTRY_COUNT; // Nada é registrado, nem as liberações das provas
+            free(probe_ptr);
+        }
+        if (probe_found[0].slot >= 0 && probe_found[0].slot == probe_found[1].slot &&
+            probe_found[0].ret == probe_found[1].ret) {
+            entries[e].ret = probe_found[0].ret;
+            entries[e].slot = probe_found[0].slot;
+        }
+    }
+    calibrating = -1;
+}
+
+/******************************
+ * Funções Interceptadas
+ ******************************/
+
+void *__real__malloc_r(struct _reent *r, size_t size);
+void *__real__calloc_r(struct _reent *r, size_t n, size_t size);
+void *__real__realloc_r(struct _reent *r, void *ptr, size_t size);
+void __real__free_r(struct _reent *r, void *ptr);
+
+void *__wrap__malloc_r(struct _reent *r, size_t size) {
+    volatile uint32_t marker = 0;
+    void *site = call_site(ENTRY_MALLOC, __builtin_return_address(0), &marker);
+
+    if (depth++ == 0 && site && calibrating < 0) {
+        record_alloc(site, size);
+    }
+    void *p = __real__malloc_r(r, size);
+    depth--;
+    return p;
+}
+
+void *__wrap__calloc_r(struct _reent *r, size_t n, size_t size) {
+    volatile uint32_t marker = 0;
+    void *site = call_site(ENTRY_CALLOC, __builtin_return_address(0), &marker);
+
+    if (depth++ == 0 && site && calibrating < 0) {
+        record_alloc(site, n * size);
+    }
+    void *p = __real__calloc_r(r, n, size);
+    depth--;
+    return p;
+}
+
+/**
+ * @brief Conta uma alocação só quando devolve outro bloco (novo ou movido): crescer ou encolher no
+ * lugar não aloca. Um bloco movido ou liberado (tamanho 0) conta uma liberação.
+ */
+void *__wrap__realloc_r(struct _reent *r, void *ptr, size_t size) {
+    volatile uint32_t marker = 0;
+    void *site = call_site(ENTRY_REALLOC, __builtin_return_address(0), &marker);
+    bool outer = depth++ == 0 && site && calibrating < 0;
+
+    void *p = __real__realloc_r(r, ptr, size);
+    depth--;
+    if (outer && p != ptr) {
+        if (ptr && (p || size == 0)) {
+            total_frees++;
+        }
+        if (p) {
+            record_alloc(site, size);
+        }
+    }
+    return p;
+}
+
+void __wrap__free_r(struct _reent *r, void *ptr) {
+    if (ptr && depth == 0 && calibrating < 0) {
+        total_frees++;
+    }
+    __real__free_r(r, ptr);
+}
+
+#endif // GENIUS_HEAP_TRACK
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Define o subsistema ao qual as próximas alocações serão atribuídas.
+ *
+ * @param name Nome do subsistema (string estática).
+ */
+void heap_tracker_set_context(const char *name) {
+#if GENIUS_HEAP_TRACK
+    current_context = name;
+#else
+    (void)name;
+#endif
+}
+
+/**
+ * @brief Encerra a fase de inicialização.
+ */
+void heap_tracker_lock() {
+#if GENIUS_HEAP_TRACK
+    locked = true;
+#endif
+}
+
+/**
+ * @brief Obtém o número de alocações feitas após `heap_tracker_lock()`.
+ *
+ * @return Quantidade de alocações em regime permanente.
+ */
+uint32_t heap_tracker_runtime_allocs() {
+#if GENIUS_HEAP_TRACK
+    return runtime_allocs;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Endereço de chamada registrado na alocação mais recente.
+ *
+ * @return Endereço, ou NULL sem alocações ou sem `GENIUS_HEAP_TRACK`.
+ */
+void *heap_tracker_last_site() {
+#if GENIUS_HEAP_TRACK
+    return last_site;
+#else
+    return NULL;
+#endif
+}
+
+/**
+ * @brief Imprime as alocações agrupadas por subsistema e endereço de chamada.
+ *
+ * O relatório é impresso a partir de cópias locais: o próprio `printf` pode alocar e alterar
+ * a tabela durante a impressão.
+ */
+void heap_tracker_report() {
+#if GENIUS_HEAP_TRACK
+    heap_site_t copy[HEAP_TRACK_MAX_SITES];
+    uint32_t irq_state = save_and_disable_interrupts();
+    for (int i = 0; i < HEAP_TRACK_MAX_SITES; i++) {
+        copy[i] = sites[i];
+    }
+    uint32_t allocs = total_allocs, bytes = total_bytes, frees = total_frees;
+    uint32_t runtime = runtime_allocs, overflow = site_overflow;
+    restore_interrupts(irq_state);
+
+    struct mallinfo mi = mallinfo();
+
+    printf("\n--- Alocacoes dinamicas ---\n");
+    printf("total %lu (%lu bytes), liberacoes %lu, em uso %lu bytes, apos init %lu\n",
+           (unsigned long)allocs, (unsigned long)bytes, (unsigned long)frees,
+           (unsigned long)mi.uordblks, (unsigned long)runtime);
+    printf("%-10s %-10s %6s %8s\n", "contexto", "endereco", "qtd", "bytes");
+    for (int i = 0; i < HEAP_TRACK_MAX_SITES && copy[i].count; i++) {
+        printf("%-10s %-10p %6lu %8lu\n", copy[i].context, copy[i].site,
+               (unsigned long)copy[i].count, (unsigned long)copy[i].bytes);
+    }
+    if (overflow) {
+        printf("(%lu alocacoes fora da tabela)\n", (unsigned long)overflow);
+    }
+    for (int e = 0; e < ENTRY_COUNT; e++) {
+        if (entries[e].slot < 0) {
+            static const char *names[ENTRY_COUNT] = { "malloc", "calloc", "realloc" };
+            printf("(chamador de %s nao calibrado: endereco dentro da newlib)\n", names[e]);
+        }
+    }
+#else
+    printf("\nRastreamento de alocacoes requer GENIUS_HEAP_TRACK\n");
+#endif
+}
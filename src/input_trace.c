@@ -0,0 +1,355 @@
+#include "inc/input_trace.h"
+#include "inc/gpio_irq_manager.h"
+#include "inc/irq_priority.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file input_trace.c
+ * @brief Implementação da gravação e reprodução das entradas declarada em `input_trace.h`
+ *
+ * Cada evento tem o instante relativo e uma palavra de dados:
+ * - Borda: bits 31-30 = 0, bits 8-4 = pino, bits 3-0 = eventos `GPIO_IRQ_*`.
+ * - Joystick: bits 31-30 = 1, bit 24 = botão, bits 23-12 = X, bits 11-0 = Y.
+ *
+ * Na reprodução, o alarme entrega só as bordas; as leituras do joystick são buscadas pelo instante
+ * da própria leitura, em contexto de tarefa, sem depender da latência do alarme.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define TRACE_KIND_SHIFT 30
+#define TRACE_KIND_EDGE 0u
+#define TRACE_KIND_JOYSTICK 1u
+
+#define TRACE_KIND(data) ((data) >> TRACE_KIND_SHIFT)
+#define TRACE_EDGE(gpio, events) ((TRACE_KIND_EDGE << TRACE_KIND_SHIFT) | ((gpio) << 4) | ((events) & 0xfu))
+#define TRACE_EDGE_GPIO(data) (((data) >> 4) & 0x1fu)
+#define TRACE_EDGE_EVENTS(data) ((data) & 0xfu)
+#define TRACE_JOYSTICK(s) ((TRACE_KIND_JOYSTICK << TRACE_KIND_SHIFT) | ((uint32_t)(s)->button << 24) | \
+                           ((uint32_t)((s)->x & 0xfffu) << 12) | ((s)->y & 0xfffu))
+
+#define TRACE_END_MARGIN_MS 1000 // Fim do roteiro da simulação após o último evento
+
+/******************************
+ * Estruturas
+ ******************************/
+
+typedef struct {
+    uint32_t time_us;   // Desde o início da gravação
+    uint32_t data;      // Borda ou leitura do joystick (ver acima)
+} trace_event_t;
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static trace_event_t trace[INPUT_TRACE_CAPACITY];
+static volatile uint trace_count;
+static volatile input_trace_mode_t mode;
+static bool truncated;              // Gravação encerrada pela capacidade ou pela duração
+
+// Gravação
+static uint32_t record_start_us;
+static uint32_t last_joystick = UINT32_MAX;
+
+// Reprodução
+static int alarm_num = -1;
+static uint replay_speed;
+static uint64_t replay_start_us;
+static uint replay_next;            // Próximo evento do alarme
+static uint replay_joystick;        // Próxima leitura do joystick ainda não alcançada
+static uint32_t replay_joystick_data;
+static bool has_replay_joystick;
+static volatile bool replay_finished;
+static uint32_t delivered, late_max_us;
+static uint64_t late_total_us;
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Acrescenta um evento à gravação (IRQ ou tarefa).
+ */
+static void GENIUS_HOT_FUNC(append)(uint32_t data) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    uint32_t t = time_us_32() - record_start_us;
+
+    if (mode == INPUT_TRACE_RECORDING) {
+        if (trace_count == INPUT_TRACE_CAPACITY || t > INPUT_TRACE_MAX_US) {
+            mode = INPUT_TRACE_IDLE;
+            truncated = true;
+        } else {
+            trace[trace_count].time_us = t;
+            trace[trace_count].data = data;
+            trace_count++;
+        }
+    }
+    restore_interrupts(irq_state);
+}
+
+/**
+ * @brief Instante absoluto de um evento na reprodução.
+ */
+static inline uint64_t replay_due(uint index) {
+    return replay_start_us + trace[index].time_us / replay_speed;
+}
+
+/**
+ * @brief Alarme da reprodução: entrega as bordas vencidas e agenda a próxima.
+ */
+static void GENIUS_HOT_FUNC(replay_alarm)(uint alarm) {
+    for (;;) {
+        uint64_t now = time_us_64();
+
+        while (replay_next < trace_count) {
+            uint32_t data = trace[replay_next].data;
+            uint64_t due = replay_due(replay_next);
+
+            if (TRACE_KIND(data) != TRACE_KIND_EDGE) {
+                replay_next++;
+                continue;
+            }
+            if (due > now) {
+                break;
+            }
+            uint32_t late = (uint32_t)(now - due);
+            late_total_us += late;
+            if (late > late_max_us) {
+                late_max_us = late;
+            }
+            delivered++;
+            gpio_irq_handler(TRACE_EDGE_GPIO(data), TRACE_EDGE_EVENTS(data));
+            replay_next++;
+        }
+
+        // Depois da última borda, a reprodução segue até o último evento (leituras do joystick)
+        uint64_t target = replay_next < trace_count ? replay_due(replay_next) : replay_due(trace_count - 1);
+        if (replay_next == trace_count && target <= now) {
+            replay_finished = true;
+            return;
+        }
+        if (!hardware_alarm_set_target(alarm, from_us_since_boot(target))) {
+            return;
+        }
+        // Instante já passou: processa de novo
+    }
+}
+
+/**
+ * @brief Libera o alarme e devolve os botões ao hardware.
+ */
+static void replay_release() {
+    hardware_alarm_cancel(alarm_num);
+    hardware_alarm_set_callback(alarm_num, NULL);
+    hardware_alarm_unclaim(alarm_num);
+    alarm_num = -1;
+    for (uint gpio = 0; gpio < MAX_GPIO_PINS; gpio++) {
+        if (callbacks[gpio] != NULL) {
+            gpio_acknowledge_irq(gpio, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL); // Toques reais ignorados
+        }
+    }
+    irq_set_enabled(IO_IRQ_BANK0, true);
+    mode = INPUT_TRACE_IDLE;
+}
+
+static void print_replay_stats(const char *how) {
+    printf("\nReproducao %s (%ux): %lu bordas entregues | atraso medio %lu us | max %lu us\n", how,
+           replay_speed, (unsigned long)delivered,
+           (unsigned long)(delivered ? late_total_us / delivered : 0), (unsigned long)late_max_us);
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Descarta o registro anterior e começa a gravar.
+ *
+ * O chamador deve levar o instrumento ao estado inicial antes.
+ */
+void input_trace_record_start() {
+    if (mode != INPUT_TRACE_IDLE) {
+        return;
+    }
+    trace_count = 0;
+    truncated = false;
+    last_joystick = UINT32_MAX;
+    record_start_us = time_us_32();
+    mode = INPUT_TRACE_RECORDING;
+    printf("\nGravando entradas (ate %d eventos); 'r' encerra\n", INPUT_TRACE_CAPACITY);
+}
+
+/**
+ * @brief Para a gravação e imprime o tamanho do registro.
+ */
+void input_trace_record_stop() {
+    if (mode == INPUT_TRACE_RECORDING) {
+        mode = INPUT_TRACE_IDLE;
+    }
+    uint32_t length_ms = trace_count ? trace[trace_count - 1].time_us / 1000 : 0;
+    printf("\nGravacao encerrada: %u eventos em %lu ms%s\n", trace_count, (unsigned long)length_ms,
+           truncated ? " (limite atingido)" : "");
+}
+
+/**
+ * @brief Grava uma borda recebida pelo `gpio_irq_handler` (contexto de IRQ).
+ *
+ * @param gpio Pino.
+ * @param events Máscara de eventos `GPIO_IRQ_*`.
+ */
+void GENIUS_HOT_FUNC(input_trace_edge)(uint gpio, uint32_t events) {
+    if (mode == INPUT_TRACE_RECORDING) {
+        append(TRACE_EDGE(gpio, events));
+    }
+}
+
+/**
+ * @brief Grava uma leitura do joystick ou, durante a reprodução, a substitui pela gravada.
+ *
+ * @param state Leitura feita por `joystickPi_read()`.
+ */
+void GENIUS_HOT_FUNC(input_trace_joystick)(joystick_state_t *state) {
+    if (mode == INPUT_TRACE_RECORDING) {
+        uint32_t data = TRACE_JOYSTICK(state);
+        if (data != last_joystick) { // Só as mudanças
+            last_joystick = data;
+            append(data);
+        }
+    } else if (mode == INPUT_TRACE_REPLAYING) {
+        uint64_t now = time_us_64();
+
+        while (replay_joystick < trace_count && replay_due(replay_joystick) <= now) {
+            if (TRACE_KIND(trace[replay_joystick].data) == TRACE_KIND_JOYSTICK) {
+                replay_joystick_data = trace[replay_joystick].data;
+                has_replay_joystick = true;
+            }
+            replay_joystick++;
+        }
+        if (has_replay_joystick) { // Antes da primeira leitura gravada vale a leitura real
+            state->x = (replay_joystick_data >> 12) & 0xfffu;
+            state->y = replay_joystick_data & 0xfffu;
+            state->button = (replay_joystick_data >> 24) & 1u;
+        }
+    }
+}
+
+/**
+ * @brief Começa a reproduzir o registro.
+ *
+ * O chamador deve levar o instrumento ao estado inicial antes.
+ *
+ * @param speed Multiplicador da velocidade (1 = tempo original).
+ * @return false se o registro estiver vazio ou não houver alarme de hardware livre.
+ */
+bool input_trace_replay_start(uint speed) {
+    if (mode == INPUT_TRACE_RECORDING) {
+        input_trace_record_stop();
+    }
+    if (mode != INPUT_TRACE_IDLE || trace_count == 0) {
+        printf("\nNada para reproduzir: grave com 'r'\n");
+        return false;
+    }
+    alarm_num = hardware_alarm_claim_unused(false);
+    if (alarm_num < 0) {
+        printf("\nNenhum alarme de hardware livre para a reproducao\n");
+        return false;
+    }
+
+    replay_speed = speed ? speed : 1;
+    replay_next = replay_joystick = 0;
+    has_replay_joystick = false;
+    replay_finished = false;
+    delivered = late_max_us = 0;
+    late_total_us = 0;
+    printf("\nReproduzindo %u eventos (%ux); 'x' interrompe\n", trace_count, replay_speed);
+
+    irq_set_enabled(IO_IRQ_BANK0, false); // Só as bordas gravadas chegam ao gpio_irq_handler
+    hardware_alarm_set_callback(alarm_num, replay_alarm);
+    irq_set_priority(TIMER_IRQ_0 + alarm_num, IRQ_PRIORITY_INPUT);
+    mode = INPUT_TRACE_REPLAYING;
+    replay_start_us = time_us_64();
+    hardware_alarm_force_irq(alarm_num);
+    return true;
+}
+
+/**
+ * @brief Interrompe a reprodução e devolve os botões ao hardware.
+ */
+void input_trace_replay_stop() {
+    if (mode == INPUT_TRACE_REPLAYING) {
+        replay_release();
+        print_replay_stats("interrompida");
+    }
+}
+
+/**
+ * @brief Estado atual do registro.
+ */
+input_trace_mode_t input_trace_mode() {
+    return mode;
+}
+
+/**
+ * @brief Imprime o resumo de uma reprodução que terminou desde a última chamada.
+ *
+ * Chamada periodicamente por uma tarefa (a reprodução termina no contexto de IRQ).
+ */
+void input_trace_poll() {
+    if (mode == INPUT_TRACE_REPLAYING && replay_finished) {
+        replay_release();
+        print_replay_stats("concluida");
+    }
+}
+
+/**
+ * @brief Imprime o registro como um roteiro do `GENIUS_sim`.
+ */
+void input_trace_dump() {
+    if (mode == INPUT_TRACE_RECORDING) {
+        input_trace_record_stop();
+    }
+
+    uint32_t end_ms = INPUT_TRACE_SIM_OFFSET_MS + TRACE_END_MARGIN_MS +
+                      (trace_count ? trace[trace_count - 1].time_us / 1000 : 0);
+
+    printf("\n# Registro de entradas: %u eventos%s\n", trace_count, truncated ? " (limite atingido)" : "");
+    printf("# Salve a partir desta linha e execute: GENIUS_sim <arquivo>\n");
+    uint32_t axes = UINT32_MAX; // Eixos e botão da leitura anterior (o botão começa solto)
+    bool button = false;
+    for (uint i = 0; i < trace_count; i++) {
+        uint32_t data = trace[i].data;
+        uint64_t us = (uint64_t)INPUT_TRACE_SIM_OFFSET_MS * 1000 + trace[i].time_us;
+        unsigned long ms = (unsigned long)(us / 1000), frac = (unsigned long)(us % 1000);
+
+        if (TRACE_KIND(data) == TRACE_KIND_JOYSTICK) {
+            if ((data & 0xffffffu) != axes) {
+                axes = data & 0xffffffu;
+                printf("%lu.%03lu joy %lu %lu\n", ms, frac, (unsigned long)((data >> 12) & 0xfffu),
+                       (unsigned long)(data & 0xfffu));
+            }
+            if (((data >> 24) & 1u) != button) {
+                button = !button;
+                printf("%lu.%03lu %s joy\n", ms, frac, button ? "press" : "release");
+            }
+            continue;
+        }
+        // Descida e subida na mesma interrupção: o repique mais curto que a latência da IRQ
+        if (TRACE_EDGE_EVENTS(data) & GPIO_IRQ_EDGE_FALL) {
+            printf("%lu.%03lu press %lu\n", ms, frac, (unsigned long)TRACE_EDGE_GPIO(data));
+        }
+        if (TRACE_EDGE_EVENTS(data) & GPIO_IRQ_EDGE_RISE) {
+            printf("%lu.%03lu release %lu\n", ms, frac, (unsigned long)TRACE_EDGE_GPIO(data));
+        }
+    }
+    printf("%lu end\n", (unsigned long)end_ms);
+}
@@ -0,0 +1,251 @@
+#include "inc/irq_latency.h"
+#include "inc/irq_priority.h"
+#include "inc/gpio_irq_manager.h"
+#include "hardware/clocks.h"
+#include "hardware/pwm.h"
+#include "hardware/structs/systick.h"
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file irq_latency.c
+ * @brief Implementação do benchmark de latência de entrada das interrupções
+ *
+ * Este arquivo implementa a função declarada em `irq_latency.h`. O SysTick é usado como
+ * contador de ciclos de 24 bits (decrescente), suficiente para latências de até ~130 ms. Na
+ * carga GPIO o PWM conta com divisor 1, então o contador da fatia é o número de ciclos desde o
+ * wrap: lido no callback, dá o atraso desde a borda sem outro relógio.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define SYSTICK_MAX 0xFFFFFFu
+
+/**
+ * @brief Níveis do plano de prioridades medidos.
+ */
+static const struct {
+    const char *name;
+    uint8_t priority;
+} levels[] = {
+    {"audio", IRQ_PRIORITY_AUDIO},
+    {"tempo", IRQ_PRIORITY_TIMING},
+    {"entrada", IRQ_PRIORITY_INPUT},
+    {"fundo", IRQ_PRIORITY_BACKGROUND},
+};
+
+/**
+ * @brief Cargas sintéticas aplicadas durante as medições.
+ */
+enum { LOAD_USB = 1 << 0, LOAD_GPIO = 1 << 1 };
+
+static const char *load_names[] = { "nenhuma", "usb", "gpio", "usb+gpio" };
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Atraso borda -> callback do pino de carga, em ciclos.
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t min, max;
+    uint64_t sum;
+    uint32_t unmatched;     // Nível do pino incoerente com o contador: atraso acima de meio período
+} edge_stats_t;
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static volatile uint32_t isr_stamp;
+static volatile bool isr_fired;
+
+static edge_stats_t edge_stats[count_of(load_names)];
+static edge_stats_t *volatile edge_current;     // Estatística da carga em andamento
+static uint load_slice;
+static uint32_t load_level;                     // Contador em que a saída desce (sobe no wrap)
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief ISR de prova: registra o valor do SysTick na entrada.
+ */
+static void __not_in_flash_func(probe_isr)() {
+    isr_stamp = systick_hw->cvr;
+    isr_fired = true;
+}
+
+/**
+ * @brief Callback do pino de carga: atraso desde a borda pelo contador do PWM.
+ *
+ * A saída fica alta de 0 a `load_level` - 1: com o pino alto a borda foi a subida (no wrap),
+ * com o pino baixo foi a descida (em `load_level`).
+ */
+static void __not_in_flash_func(load_callback)() {
+    uint32_t ctr = pwm_hw->slice[load_slice].ctr;
+    bool high = gpio_get(IRQ_BENCH_LOAD_PIN);
+    edge_stats_t *stats = edge_current;
+
+    if (stats == NULL) {
+        return;
+    }
+    if (high != (ctr < load_level)) {
+        stats->unmatched++;
+        return;
+    }
+    uint32_t cycles = high ? ctr : ctr - load_level;
+    stats->count++;
+    stats->sum += cycles;
+    if (cycles < stats->min) stats->min = cycles;
+    if (cycles > stats->max) stats->max = cycles;
+}
+
+/**
+ * @brief Liga ou desliga a geração de bordas no pino de carga.
+ *
+ * @param enable true para iniciar a carga, false para restaurar o pino como entrada.
+ */
+static void gpio_load(bool enable) {
+    load_slice = pwm_gpio_to_slice_num(IRQ_BENCH_LOAD_PIN);
+
+    if (enable) {
+        uint16_t wrap = clock_get_hz(clk_sys) / IRQ_BENCH_LOAD_HZ - 1;
+        load_level = wrap / 2;
+        gpio_set_function(IRQ_BENCH_LOAD_PIN, GPIO_FUNC_PWM);
+        pwm_set_clkdiv(load_slice, 1.0f); // Um tique por ciclo
+        pwm_set_wrap(load_slice, wrap);
+        pwm_set_gpio_level(IRQ_BENCH_LOAD_PIN, load_level);
+        register_gpio_callback(IRQ_BENCH_LOAD_PIN, load_callback, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL);
+        gpio_irq_manager_set_debounce(IRQ_BENCH_LOAD_PIN, 0); // Toda borda chega ao callback
+        pwm_set_enabled(load_slice, true);
+    } else {
+        pwm_set_enabled(load_slice, false);
+        remove_gpio_callback(IRQ_BENCH_LOAD_PIN, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL);
+        gpio_init(IRQ_BENCH_LOAD_PIN); // Volta a ser entrada comum
+    }
+}
+
+/**
+ * @brief Mede a latência de um nível sob uma combinação de cargas.
+ *
+ * @param irq Interrupção de usuário usada como prova.
+ * @param level Índice do nível em `levels`.
+ * @param load Máscara de cargas (`LOAD_USB`, `LOAD_GPIO`).
+ */
+static void measure(uint irq, int level, int load) {
+    uint32_t min = SYSTICK_MAX, max = 0;
+    uint64_t sum = 0;
+
+    irq_set_priority(irq, levels[level].priority);
+    if (load & LOAD_GPIO) {
+        edge_current = &edge_stats[load];
+        gpio_load(true);
+    }
+
+    for (int i = 0; i < IRQ_BENCH_SAMPLES; i++) {
+        if (load & LOAD_USB) {
+            printf("................................................................\r");
+        }
+
+        isr_fired = false;
+        uint32_t start = systick_hw->cvr;
+        irq_set_pending(irq);
+        while (!isr_fired) {
+            tight_loop_contents();
+        }
+
+        uint32_t cycles = (start - isr_stamp) & SYSTICK_MAX; // Contador decrescente
+        sum += cycles;
+        if (cycles < min) min = cycles;
+        if (cycles > max) max = cycles;
+    }
+
+    if (load & LOAD_GPIO) {
+        gpio_load(false);
+        edge_current = NULL;
+    }
+
+    uint32_t mhz = clock_get_hz(clk_sys) / 1000000;
+    printf("%-8s 0x%02x %-9s %6lu %6lu %6lu %8lu\n", levels[level].name, levels[level].priority,
+           load_names[load], (unsigned long)min, (unsigned long)(sum / IRQ_BENCH_SAMPLES),
+           (unsigned long)max, (unsigned long)(max * 1000 / mhz));
+}
+
+/**
+ * @brief Imprime o atraso borda -> callback medido no pino de carga, por combinação de cargas.
+ */
+static void print_edge_stats() {
+    uint32_t mhz = clock_get_hz(clk_sys) / 1000000;
+
+    printf("\n--- Borda no pino de carga -> callback do gpio_irq_manager (ciclos) ---\n");
+    printf("Tratador real: IO_IRQ_BANK0 em 0x%02x, despacho do SDK e gpio_irq_handler\n", IRQ_PRIORITY_INPUT);
+    printf("%-9s %7s %6s %6s %6s %8s %6s\n", "carga", "bordas", "min", "media", "max", "max_ns", "fora");
+    for (int load = 0; load < (int)count_of(load_names); load++) {
+        const edge_stats_t *stats = &edge_stats[load];
+        if (!(load & LOAD_GPIO) || stats->count == 0) {
+            continue;
+        }
+        printf("%-9s %7lu %6lu %6lu %6lu %8lu %6lu\n", load_names[load], (unsigned long)stats->count,
+               (unsigned long)stats->min, (unsigned long)(stats->sum / stats->count), (unsigned long)stats->max,
+               (unsigned long)(stats->max * 1000 / mhz), (unsigned long)stats->unmatched);
+    }
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Executa o benchmark e imprime mínimo, média e máximo (ciclos e ns) de cada nível.
+ *
+ * A latência mínima sem carga corresponde ao custo fixo de entrada no NVIC somado à leitura do
+ * SysTick; os demais valores devem ser comparados com ela. Em seguida imprime o atraso medido no
+ * tratador real do GPIO durante as cargas GPIO.
+ */
+void irq_latency_benchmark() {
+    uint32_t saved_csr = systick_hw->csr;
+    uint32_t saved_rvr = systick_hw->rvr;
+
+    systick_hw->csr = 0;
+    systick_hw->rvr = SYSTICK_MAX;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5; // ENABLE | CLKSOURCE (clock do processador)
+
+    uint irq = user_irq_claim_unused(true);
+    irq_set_exclusive_handler(irq, probe_isr);
+    irq_set_enabled(irq, true);
+
+    for (int load = 0; load < (int)count_of(load_names); load++) {
+        edge_stats[load] = (edge_stats_t){ .min = UINT32_MAX };
+    }
+
+    printf("\n--- Latencia de entrada das IRQs (ciclos) ---\n");
+    printf("Prova: IRQ %u pendente por software em cada nivel. Mede a entrada no NVIC e a espera por\n"
+           "ISRs de prioridade igual ou maior, nao o despacho dos tratadores reais; a carga usb e\n"
+           "gerada antes de cada disparo, no mesmo nucleo (nao e o pior caso da USB)\n", irq);
+    printf("%-8s %-4s %-9s %6s %6s %6s %8s\n", "nivel", "prio", "carga", "min", "media", "max", "max_ns");
+    for (int level = 0; level < (int)count_of(levels); level++) {
+        for (int load = 0; load < (int)count_of(load_names); load++) {
+            measure(irq, level, load);
+        }
+    }
+
+    print_edge_stats();
+
+    irq_set_enabled(irq, false);
+    irq_remove_handler(irq, probe_isr);
+    user_irq_unclaim(irq);
+
+    systick_hw->csr = 0;
+    systick_hw->rvr = saved_rvr;
+    systick_hw->csr = saved_csr;
+}
@@ -0,0 +1,535 @@
+#include "inc/looper.h"
+#include "inc/BuzzerPi.h"
+#include "inc/board.h"
+#include "inc/scheduler.h"
+#include "inc/timer_wheel.h"
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file looper.c
+ * @brief Implementação do looper declarado em `looper.h`
+ *
+ * Posições no anel são absolutas (crescem sem voltar); o índice no vetor é a posição módulo
+ * `LOOPER_CAPACITY`. As camadas ficam em ordem de gravação em `layers`, a mais antiga primeiro.
+ */
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Uma nota gravada (8 bytes).
+ */
+typedef struct {
+    uint32_t offset_ms;     // Início em relação ao começo da volta
+    uint16_t freq_hz;
+    uint16_t duration_ms;
+} looper_note_t;
+
+/**
+ * @brief Uma camada: trecho contíguo do anel, em ordem de tempo.
+ */
+typedef struct {
+    uint32_t first;         // Posição da primeira nota
+    uint32_t count;
+    uint32_t cursor;        // Próxima nota a tocar na volta em andamento
+    uint32_t pass;          // Volta em que foi gravada (não toca nela)
+} looper_layer_t;
+
+/**
+ * @brief Dono da voz (o canal PWM do buzzer).
+ */
+enum { VOICE_FREE = 0, VOICE_LIVE, VOICE_LOOP };
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static looper_note_t notes[LOOPER_CAPACITY];
+static uint32_t next_pos;                       // Posição da próxima nota gravada
+static looper_layer_t layers[LOOPER_MAX_LAYERS];
+static uint layer_count;
+static bool layer_open;                         // A camada mais recente ainda recebe notas
+
+static volatile looper_state_t state;
+static uint64_t anchor_us;                      // Início da volta 0
+static uint32_t loop_us;                        // Comprimento do loop
+static uint32_t play_pass;                      // Volta sendo tocada
+
+static volatile uint8_t voice;
+static volatile bool live_active;               // A nota ao vivo mais recente ainda soa
+static uint32_t live_onset_us;                  // Início da nota ao vivo mais recente
+static bool live_recorded;                      // Ela é a última nota gravada (`next_pos - 1`)
+static uint32_t stolen, muted, truncated;
+
+static scheduler_task_t looper_task;
+static timer_wheel_timer_t onset_timer;         // Próximo início
+static timer_wheel_timer_t release_timer;       // Fim da nota do loop que está soando
+static timer_wheel_timer_t live_timer;          // Fim da nota ao vivo mais recente
+
+static int export_melody[LOOPER_EXPORT_MAX];
+static int export_durations[LOOPER_EXPORT_MAX];
+static Melody exported = { export_melody, export_durations, 0, "Loop" };
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+static inline looper_note_t *note_at(uint32_t pos) {
+    return &notes[pos % LOOPER_CAPACITY];
+}
+
+static inline uint64_t pass_start_us(uint32_t pass) {
+    return anchor_us + (uint64_t)pass * loop_us;
+}
+
+static void onset_timer_callback(timer_wheel_timer_t *timer) {
+    (void)timer;
+    scheduler_signal(&looper_task);
+}
+
+static void release_timer_callback(timer_wheel_timer_t *timer) {
+    (void)timer;
+    if (voice == VOICE_LOOP) {
+        stop_tone(BUZZER_PIN);
+        voice = VOICE_FREE;
+    }
+}
+
+static void live_timer_callback(timer_wheel_timer_t *timer) {
+    (void)timer;
+    live_active = false;
+}
+
+/**
+ * @brief Para o agendamento e libera a voz se ela estiver com o loop.
+ */
+static void release_voice() {
+    timer_wheel_cancel(&onset_timer);
+    timer_wheel_cancel(&release_timer);
+    if (voice == VOICE_LOOP) {
+        stop_tone(BUZZER_PIN);
+        voice = VOICE_FREE;
+    }
+}
+
+static void drop_oldest_layer() {
+    for (uint i = 1; i < layer_count; i++) {
+        layers[i - 1] = layers[i];
+    }
+    layer_count--;
+}
+
+static void clear() {
+    live_recorded = false;
+    layer_count = 0;
+    layer_open = false;
+    next_pos = 0;
+    loop_us = 0;
+    stolen = muted = truncated = 0;
+}
+
+/**
+ * @brief Grava uma nota ao vivo na camada da volta em que ela começou.
+ */
+static bool record(uint32_t onset_us, uint32_t freq, uint32_t duration_ms) {
+    uint64_t onset = time_us_64() + (int32_t)(onset_us - time_us_32());
+    uint64_t rel = onset > anchor_us ? onset - anchor_us : 0;
+    uint32_t pass = 0;
+
+    if (state == LOOPER_OVERDUBBING) {
+        pass = (uint32_t)(rel / loop_us);
+        rel %= loop_us;
+    } else if (rel >= (uint64_t)LOOPER_MAX_LOOP_MS * 1000u) {
+        return false;
+    }
+
+    if (!layer_open || layers[layer_count - 1].pass != pass) {
+        if (layer_count == LOOPER_MAX_LAYERS) {
+            drop_oldest_layer();
+        }
+        layers[layer_count++] = (looper_layer_t){ .first = next_pos, .pass = pass };
+        layer_open = true;
+    }
+    if (next_pos - layers[0].first == LOOPER_CAPACITY) {
+        if (layer_count == 1) {
+            truncated++; // A camada sozinha ocupa o anel
+            return false;
+        }
+        drop_oldest_layer();
+    }
+
+    *note_at(next_pos++) = (looper_note_t){
+        .offset_ms = (uint32_t)(rel / 1000),
+        .freq_hz = freq > UINT16_MAX ? UINT16_MAX : freq,
+        .duration_ms = duration_ms > UINT16_MAX ? UINT16_MAX : duration_ms,
+    };
+    layers[layer_count - 1].count++;
+    return true;
+}
+
+/**
+ * @brief Próxima nota da intercalação das camadas; esgotada a volta, passa para a seguinte.
+ *
+ * @param when Recebe o instante da nota ou, se não houver nota antes disso, o início da próxima
+ *             volta.
+ * @return Camada da nota, ou NULL se a próxima volta ainda não começou.
+ */
+static looper_layer_t *next_note(uint64_t *when) {
+    for (;;) {
+        looper_layer_t *best = NULL;
+        uint32_t best_offset = 0;
+
+        for (uint i = 0; i < layer_count; i++) {
+            looper_layer_t *layer = &layers[i];
+            if (layer->pass >= play_pass || layer->cursor >= layer->count) {
+                continue;
+            }
+            uint32_t offset = note_at(layer->first + layer->cursor)->offset_ms;
+            if (best == NULL || offset < best_offset) {
+                best = layer;
+                best_offset = offset;
+            }
+        }
+        if (best) {
+            *when = pass_start_us(play_pass) + (uint64_t)best_offset * 1000u;
+            return best;
+        }
+
+        *when = pass_start_us(play_pass + 1);
+        if (*when > time_us_64()) {
+            return NULL;
+        }
+        play_pass++;
+        for (uint i = 0; i < layer_count; i++) {
+            layers[i].cursor = 0;
+        }
+    }
+}
+
+/**
+ * @brief Toca uma nota do loop, se a voz não estiver com uma nota ao vivo.
+ */
+static void play(const looper_note_t *note) {
+    if (live_active) {
+        muted++;
+        return;
+    }
+    timer_wheel_cancel(&release_timer); // Antes de ligar: o fim da nota anterior não corta esta
+    if (voice == VOICE_LOOP) {
+        stolen++;
+    }
+    start_tone(BUZZER_PIN, note->freq_hz);
+    voice = VOICE_LOOP;
+    timer_wheel_start(&release_timer, note->duration_ms);
+}
+
+/**
+ * @brief Tarefa do looper: toca os inícios vencidos e agenda o próximo.
+ */
+static void looper_run() {
+    if (state != LOOPER_PLAYING && state != LOOPER_OVERDUBBING) {
+        return;
+    }
+
+    uint64_t now = time_us_64();
+    uint64_t when;
+    looper_layer_t *layer;
+
+    while ((layer = next_note(&when)) != NULL && when <= now) {
+        play(note_at(layer->first + layer->cursor));
+        layer->cursor++;
+    }
+    timer_wheel_start(&onset_timer, (uint32_t)((when - now + 999) / 1000));
+}
+
+static void print_status(const char *event) {
+    uint32_t total = 0;
+
+    for (uint i = 0; i < layer_count; i++) {
+        total += layers[i].count;
+    }
+    printf("\nLooper: %s | loop %lu ms | camadas %u | notas %lu de %u | roubadas %lu | mudas %lu",
+           event, (unsigned long)(loop_us / 1000), layer_count, (unsigned long)total, LOOPER_CAPACITY,
+           (unsigned long)stolen, (unsigned long)muted);
+    if (truncated) {
+        printf(" | truncadas %lu", (unsigned long)truncated);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief Começa a tocar com a volta 1 em `start`.
+ */
+static void start_playing(uint64_t start) {
+    anchor_us = start - loop_us;
+    play_pass = 1;
+    for (uint i = 0; i < layer_count; i++) {
+        layers[i].pass = 0;
+        layers[i].cursor = 0;
+    }
+    layer_open = false;
+    state = LOOPER_PLAYING;
+    scheduler_signal(&looper_task);
+}
+
+/**
+ * @brief Próxima nota da intercalação de todas as camadas, sem filtro de volta (exportação).
+ */
+static const looper_note_t *merged_next(uint32_t *cursors) {
+    const looper_note_t *best = NULL;
+    uint best_layer = 0;
+
+    for (uint i = 0; i < layer_count; i++) {
+        if (cursors[i] < layers[i].count) {
+            const looper_note_t *note = note_at(layers[i].first + cursors[i]);
+            if (best == NULL || note->offset_ms < best->offset_ms) {
+                best = note;
+                best_layer = i;
+            }
+        }
+    }
+    if (best) {
+        cursors[best_layer]++;
+    }
+    return best;
+}
+
+static bool emit(uint *n, int freq, uint32_t duration_ms) {
+    if (*n >= LOOPER_EXPORT_MAX) {
+        return false;
+    }
+    export_melody[*n] = freq;
+    export_durations[*n] = (int)duration_ms;
+    (*n)++;
+    return true;
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Prepara os temporizadores e registra a tarefa do looper. Requer `timer_wheel_init()`.
+ */
+void looper_init() {
+    timer_wheel_timer_init(&onset_timer, onset_timer_callback, NULL);
+    timer_wheel_timer_init(&release_timer, release_timer_callback, NULL);
+    timer_wheel_timer_init(&live_timer, live_timer_callback, NULL);
+    scheduler_task_init(&looper_task, "looper", looper_run, 0, 0); // Áudio, como o reprodutor
+    scheduler_add(&looper_task);
+}
+
+/**
+ * @brief Avança o ciclo gravar -> tocar -> sobrepor -> tocar (comando 'e').
+ */
+void looper_advance() {
+    uint64_t now = time_us_64();
+
+    switch (state) {
+        case LOOPER_EMPTY:
+            clear();
+            anchor_us = now;
+            state = LOOPER_RECORDING;
+            print_status("gravando");
+            break;
+        case LOOPER_RECORDING:
+            if (layer_count == 0) {
+                state = LOOPER_EMPTY;
+                print_status("nada gravado");
+                break;
+            }
+            loop_us = (uint32_t)(now - anchor_us);
+            if (loop_us < LOOPER_MIN_LOOP_MS * 1000u) loop_us = LOOPER_MIN_LOOP_MS * 1000u;
+            if (loop_us > LOOPER_MAX_LOOP_MS * 1000u) loop_us = LOOPER_MAX_LOOP_MS * 1000u;
+            start_playing(now);
+            print_status("tocando");
+            break;
+        case LOOPER_PLAYING:
+            layer_open = false;
+            state = LOOPER_OVERDUBBING;
+            print_status("sobrepondo");
+            break;
+        case LOOPER_OVERDUBBING:
+            layer_open = false;
+            state = LOOPER_PLAYING;
+            print_status("tocando");
+            break;
+        case LOOPER_STOPPED:
+            start_playing(now);
+            print_status("tocando");
+            break;
+    }
+}
+
+/**
+ * @brief Descarta a camada mais recente (comando 'u').
+ */
+void looper_undo() {
+    if (layer_count == 0 || state == LOOPER_RECORDING) {
+        return;
+    }
+    layer_count--;
+    next_pos = layers[layer_count].first;
+    layer_open = false;
+    live_recorded = false;
+    if (layer_count == 0) {
+        release_voice();
+        clear();
+        state = LOOPER_EMPTY;
+    }
+    print_status("camada descartada");
+}
+
+/**
+ * @brief Para o loop e libera o buzzer, mantendo as camadas. Uma gravação em andamento é descartada.
+ */
+void looper_stop() {
+    if (state == LOOPER_PLAYING || state == LOOPER_OVERDUBBING) {
+        release_voice();
+        layer_open = false;
+        state = LOOPER_STOPPED;
+        print_status("parado");
+    } else if (state == LOOPER_RECORDING) {
+        looper_clear();
+    }
+}
+
+/**
+ * @brief Para o loop e apaga todas as camadas.
+ */
+void looper_clear() {
+    release_voice();
+    clear();
+    state = LOOPER_EMPTY;
+    print_status("apagado");
+}
+
+/**
+ * @brief Estado atual.
+ */
+looper_state_t looper_state() {
+    return state;
+}
+
+/**
+ * @brief Registra uma nota tocada ao vivo pelo reprodutor.
+ *
+ * Deve ser chamada com as interrupções desligadas junto com o início do tom, para que o fim de uma
+ * nota do loop não desligue a nota ao vivo entre os dois.
+ *
+ * @param onset_us Instante de início (`start_tone_timed()`).
+ * @param freq Frequência tocada, em Hz.
+ * @param duration_ms Duração programada do som.
+ */
+void looper_note(uint32_t onset_us, uint32_t freq, uint32_t duration_ms) {
+    if (voice == VOICE_LOOP) {
+        timer_wheel_cancel(&release_timer);
+        stolen++;
+    }
+    voice = VOICE_LIVE;
+    live_onset_us = onset_us;
+    // O fim vira um temporizador, não um instante: um instante antigo comparado com
+    // `time_us_32()` volta a parecer futuro depois de 2^31 us (~36 min). O início pode estar
+    // no próximo wrap do PWM, então a diferença é com sinal.
+    int32_t left_us = (int32_t)(duration_ms * 1000u) - (int32_t)(time_us_32() - onset_us);
+    live_active = true;
+    timer_wheel_start(&live_timer, left_us > 0 ? ((uint32_t)left_us + 999) / 1000 : 0);
+    live_recorded = (state == LOOPER_RECORDING || state == LOOPER_OVERDUBBING) &&
+                    record(onset_us, freq, duration_ms);
+}
+
+/**
+ * @brief Indica que a nota ao vivo foi cortada antes da duração programada (pausa do reprodutor).
+ *
+ * Devolve a voz ao loop imediatamente e, se a nota foi gravada, grava a duração que ela soou.
+ */
+void looper_note_off() {
+    uint32_t now = time_us_32();
+
+    if (!live_active) {
+        return; // Já tinha terminado
+    }
+    timer_wheel_cancel(&live_timer);
+    live_active = false;
+    if (voice == VOICE_LIVE) {
+        voice = VOICE_FREE;
+    }
+    if (live_recorded && layer_count > 0 && next_pos != layers[0].first) {
+        int32_t played_us = (int32_t)(now - live_onset_us);
+        note_at(next_pos - 1)->duration_ms = played_us > 0 ? (played_us + 500) / 1000 : 0;
+    }
+    live_recorded = false;
+}
+
+/**
+ * @brief Converte o loop em uma música no formato de `songs.h`.
+ *
+ * Cada nota soa por no máximo metade do intervalo até a próxima (a outra metade é o silêncio do
+ * formato) e pausas cobrem o resto; o instante de cada início é preservado com erro de até 1 ms.
+ * Notas roubadas no próprio início (mesmo instante de outra) não são exportadas.
+ *
+ * @return Música com os vetores do looper, ou NULL se o loop estiver vazio.
+ */
+const Melody *looper_export() {
+    uint32_t cursors[LOOPER_MAX_LAYERS] = { 0 };
+    uint32_t len_ms = loop_us / 1000;
+    uint32_t t = 0;
+    uint n = 0;
+
+    if (layer_count == 0 || loop_us == 0) {
+        return NULL;
+    }
+
+    const looper_note_t *note = merged_next(cursors);
+    while (note) {
+        const looper_note_t *next = merged_next(cursors);
+        uint32_t end = next ? next->offset_ms : len_ms;
+
+        if (note->offset_ms >= t + 2) {
+            uint32_t rest = (note->offset_ms - t) / 2; // Pausa de `2 * rest` ms
+            if (!emit(&n, 0, rest)) break;
+            t += 2 * rest;
+        }
+        if (end >= t + 2) {
+            uint32_t sound = (end - t) / 2;
+            if (sound > note->duration_ms) sound = note->duration_ms;
+            if (!emit(&n, note->freq_hz, sound)) break;
+            t += 2 * sound;
+        }
+        note = next;
+    }
+    if (len_ms >= t + 2) {
+        emit(&n, 0, (len_ms - t) / 2);
+    }
+
+    exported.length = (int)n;
+    return &exported;
+}
+
+/**
+ * @brief Exporta e imprime o loop como declarações de `melody.h`.
+ */
+void looper_print_export() {
+    const Melody *song = looper_export();
+
+    if (song == NULL) {
+        printf("\nLooper: nada para exportar\n");
+        return;
+    }
+
+    printf("\n// Looper: %d entradas, %lu ms\nint LoopMelody[] = { ", song->length,
+           (unsigned long)(loop_us / 1000));
+    for (int i = 0; i < song->length; i++) {
+        printf("%d%s", song->melody[i], i + 1 < song->length ? ", " : "");
+    }
+    printf(" };\nint LoopDurations[] = { ");
+    for (int i = 0; i < song->length; i++) {
+        printf("%d%s", song->durations[i], i + 1 < song->length ? ", " : "");
+    }
+    printf(" };\n// {LoopMelody, LoopDurations, sizeof(LoopMelody)/sizeof(int), \"Loop\"},\n");
+}
@@ -0,0 +1,143 @@
+#include "inc/mem_layout.h"
+#include "inc/bus_profiler.h"
+#include "hardware/dma.h"
+#include "hardware/regs/addressmap.h"
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file mem_layout.c
+ * @brief Relatório do mapa de memória e benchmark de contenção nos bancos de SRAM
+ *
+ * Este arquivo implementa as funções declaradas em `mem_layout.h`. O benchmark reproduz o
+ * cenário do caminho de áudio: a DMA lê continuamente a memória principal enquanto o processador
+ * lê e escreve um buffer de áudio e uma fila de eventos. Com `GENIUS_MEM_LAYOUT=1` esses dois
+ * buffers ficam nos bancos de rascunho e a disputa com a DMA deve ser praticamente nula.
+ */
+
+/******************************
+ * Símbolos do Script de Ligação
+ ******************************/
+
+extern char __StackBottom, __StackTop;       // Pilha do núcleo 0 (SCRATCH_Y)
+extern char __StackOneBottom, __StackOneTop; // Pilha do núcleo 1 (SCRATCH_X)
+
+#if GENIUS_BUS_PROFILE
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define BENCH_WORDS 64                  // Tamanho de cada buffer (palavras de 32 bits)
+#define BENCH_RING_BITS 8               // Anel de leitura da DMA: 2^8 bytes = BENCH_WORDS * 4
+#define BENCH_DMA_TRANSFERS (1u << 20)  // Transferências da DMA (dura mais que o laço do processador)
+#define BENCH_LOOPS 2000                // Repetições do laço de mistura
+
+static_assert((1u << BENCH_RING_BITS) == BENCH_WORDS * sizeof(uint32_t), "anel da DMA deve cobrir o buffer");
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static uint32_t GENIUS_DMA_DATA("bench") dma_src[BENCH_WORDS] __attribute__((aligned(1u << BENCH_RING_BITS)));
+static uint32_t GENIUS_DMA_DATA("bench") dma_dst;
+static uint32_t GENIUS_AUDIO_DATA("bench") audio_buf[BENCH_WORDS];
+static uint32_t GENIUS_RING_DATA("bench") ring_buf[BENCH_WORDS];
+static volatile uint32_t loop_us;
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Trecho medido: DMA na memória principal e laço de mistura no processador.
+ */
+static void bench_work() {
+    int ch = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(ch);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_ring(&c, false, BENCH_RING_BITS); // Lê o buffer de origem em anel
+    dma_channel_configure(ch, &c, &dma_dst, dma_src, BENCH_DMA_TRANSFERS, true);
+
+    uint32_t start = time_us_32();
+    for (int n = 0; n < BENCH_LOOPS; n++) {
+        for (int i = 0; i < BENCH_WORDS; i++) {
+            audio_buf[i] = audio_buf[i] * 3u + ring_buf[i]; // Acesso típico do mixer de áudio
+        }
+        __asm volatile("" ::: "memory"); // Impede que o compilador funda as iterações
+    }
+    loop_us = time_us_32() - start;
+
+    dma_channel_abort(ch);
+    dma_channel_unclaim(ch);
+}
+
+#endif // GENIUS_BUS_PROFILE
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Identifica o banco de SRAM de um endereço.
+ *
+ * @param addr Endereço a classificar.
+ * @return Nome do banco.
+ */
+const char *mem_layout_bank_name(const void *addr) {
+    uintptr_t a = (uintptr_t)addr;
+
+    if (a >= SRAM_STRIPED_BASE && a < SRAM_STRIPED_END) return "sram0-3";
+    if (a >= SRAM4_BASE && a < SRAM5_BASE) return "scratch_x";
+    if (a >= SRAM5_BASE && a < SRAM_END) return "scratch_y";
+    return "flash/outro";
+}
+
+/**
+ * @brief Imprime a região e o banco de cada grupo de dados do mapa de memória.
+ */
+void mem_layout_report() {
+    printf("\n--- Mapa de memoria (mem_layout=%d) ---\n", GENIUS_MEM_LAYOUT);
+    printf("pilha nucleo 0   %p-%p  %s\n", (void *)&__StackBottom, (void *)&__StackTop,
+           mem_layout_bank_name(&__StackBottom));
+    printf("pilha nucleo 1   %p-%p  %s\n", (void *)&__StackOneBottom, (void *)&__StackOneTop,
+           mem_layout_bank_name(&__StackOneBottom));
+#if GENIUS_BUS_PROFILE
+    printf("bench dma        %p  %s\n", (void *)dma_src, mem_layout_bank_name(dma_src));
+    printf("bench audio      %p  %s\n", (void *)audio_buf, mem_layout_bank_name(audio_buf));
+    printf("bench fila       %p  %s\n", (void *)ring_buf, mem_layout_bank_name(ring_buf));
+#endif
+}
+
+/**
+ * @brief Mede a contenção do caminho de áudio com a DMA ativa na memória principal.
+ *
+ * O trecho é executado duas vezes: uma contando as disputas em SRAM0-3 e outra contando os
+ * acessos e disputas nos bancos de rascunho.
+ */
+void mem_layout_benchmark() {
+#if GENIUS_BUS_PROFILE
+    uint32_t striped[BUS_PROF_COUNTERS];
+    uint32_t scratch[BUS_PROF_COUNTERS];
+
+    bus_profiler_sample(BUS_PROF_PRESET_SRAM_STRIPED, bench_work, striped);
+    uint32_t striped_us = loop_us;
+    bus_profiler_sample(BUS_PROF_PRESET_SRAM_SCRATCH, bench_work, scratch);
+    uint32_t scratch_us = loop_us;
+
+    printf("\n--- Benchmark de bancos (mem_layout=%d) ---\n", GENIUS_MEM_LAYOUT);
+    printf("laco de audio: %lu us / %lu us\n", (unsigned long)striped_us, (unsigned long)scratch_us);
+    printf("disputas sram0-3: %lu %lu %lu %lu\n", (unsigned long)striped[0], (unsigned long)striped[1],
+           (unsigned long)striped[2], (unsigned long)striped[3]);
+    printf("scratch_x acessos %lu disputas %lu | scratch_y acessos %lu disputas %lu\n",
+           (unsigned long)scratch[0], (unsigned long)scratch[1], (unsigned long)scratch[2],
+           (unsigned long)scratch[3]);
+#else
+    printf("\nBenchmark de bancos requer GENIUS_BUS_PROFILE\n");
+#endif
+}
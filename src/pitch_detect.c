@@ -0,0 +1,217 @@
+#include "inc/pitch_detect.h"
+#include "inc/genius_config.h"
+#include "inc/mem_layout.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file pitch_detect.c
+ * @brief Implementação do detector de altura declarado em `pitch_detect.h`
+ *
+ * Os vetores de trabalho são estáticos (sem heap e sem pilha grande): o detector não é
+ * reentrante e é chamado por uma única tarefa.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define NORM_PEAK 1024 // Pico normalizado abaixo deste valor (e ao menos metade dele)
+
+/**
+ * @brief Dó 4 a si 4 em Hz (Q12) e o limite superior de cada nota (meio semitom acima).
+ */
+static const uint32_t note_ref_q12[12] = {
+    1071618, 1135340, 1202851, 1274376, 1350154, 1430439,
+    1515497, 1605613, 1701088, 1802240, 1909407, 2022946,
+};
+static const uint32_t note_upper_q12[12] = {
+    1103019, 1168608, 1238097, 1311718, 1389717, 1472354,
+    1559905, 1652661, 1750934, 1855050, 1965357, 2082223,
+};
+#define NOTE_LOWER_Q12 1041111 // Meio semitom abaixo do dó 4
+
+/**
+ * @brief 1200 * 2 / ln(2): centésimos de semitom por (f - r) / (f + r).
+ */
+#define CENTS_PER_RATIO 3462
+
+static const char *note_names[12] = { "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B" };
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static int16_t GENIUS_AUDIO_DATA("pitch") x[PITCH_FRAME]; // Quadro sem a média, normalizado (laço interno)
+static uint32_t diff[PITCH_TAU_MAX + 2];    // d(tau)
+static uint64_t cumulative[PITCH_TAU_MAX + 2]; // soma(d(1..tau))
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Remove a média e normaliza o pico. Devolve o pico original (sem a média).
+ */
+static uint16_t prepare(const uint16_t *frame) {
+    uint32_t sum = 0;
+    for (uint i = 0; i < PITCH_FRAME; i++) {
+        sum += frame[i];
+    }
+    int32_t mean = (int32_t)((sum + PITCH_FRAME / 2) / PITCH_FRAME);
+
+    uint32_t peak = 0;
+    for (uint i = 0; i < PITCH_FRAME; i++) {
+        int32_t v = (int32_t)frame[i] - mean;
+        uint32_t mag = v < 0 ? (uint32_t)-v : (uint32_t)v;
+        x[i] = (int16_t)v;
+        if (mag > peak) peak = mag;
+    }
+    if (peak == 0) {
+        return 0;
+    }
+
+    uint up = 0, down = 0;
+    while ((peak << up) < NORM_PEAK / 2) up++;
+    while ((peak >> down) >= NORM_PEAK) down++;
+    for (uint i = 0; i < PITCH_FRAME; i++) {
+        x[i] = (int16_t)(up ? x[i] * (1 << up) : x[i] >> down);
+    }
+    return (uint16_t)peak;
+}
+
+/**
+ * @brief Função diferença: o laço que domina o custo do bloco.
+ */
+static void GENIUS_HOT_FUNC(difference)() {
+    for (uint tau = 1; tau <= PITCH_TAU_MAX + 1; tau++) {
+        const int16_t *a = x;
+        const int16_t *b = x + tau;
+        uint32_t acc = 0;
+        for (uint j = 0; j < PITCH_WINDOW; j++) {
+            int32_t delta = a[j] - b[j];
+            acc += (uint32_t)(delta * delta);
+        }
+        diff[tau] = acc;
+    }
+
+    uint64_t running = 0;
+    for (uint tau = 1; tau <= PITCH_TAU_MAX + 1; tau++) {
+        running += diff[tau];
+        cumulative[tau] = running;
+    }
+}
+
+/**
+ * @brief d'(tau) em Q15.
+ */
+static uint32_t normalized(uint tau) {
+    if (cumulative[tau] == 0) {
+        return 1u << 15;
+    }
+    return (uint32_t)((((uint64_t)diff[tau] * tau) << 15) / cumulative[tau]);
+}
+
+/**
+ * @brief d'(tau) abaixo do limiar, sem divisão.
+ */
+static inline bool below_threshold(uint tau) {
+    return (((uint64_t)diff[tau] * tau) << 15) < (uint64_t)PITCH_THRESHOLD_Q15 * cumulative[tau];
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Analisa um quadro.
+ *
+ * @param frame `PITCH_FRAME` conversões do ADC, da mais antiga para a mais recente.
+ * @param result Recebe o resultado.
+ * @return `result->voiced`.
+ */
+bool pitch_detect(const uint16_t *frame, pitch_result_t *result) {
+    *result = (pitch_result_t){ 0 };
+    result->peak = prepare(frame);
+    if (result->peak < PITCH_MIN_LEVEL) {
+        return false;
+    }
+
+    difference();
+
+    uint tau = PITCH_TAU_MIN;
+    while (tau <= PITCH_TAU_MAX && !below_threshold(tau)) {
+        tau++;
+    }
+    if (tau > PITCH_TAU_MAX) {
+        return false;
+    }
+
+    // Segue até o mínimo local
+    uint32_t best = normalized(tau);
+    while (tau < PITCH_TAU_MAX) {
+        uint32_t next = normalized(tau + 1);
+        if (next >= best) {
+            break;
+        }
+        best = next;
+        tau++;
+    }
+
+    // Interpolação parabólica de d (a de d' desloca o mínimo para tau maiores), em Q8 de amostra
+    int32_t offset_q8 = 0;
+    int64_t a = diff[tau - 1];
+    int64_t b = diff[tau];
+    int64_t c = diff[tau + 1];
+    int64_t den = a - 2 * b + c;
+    if (den > 0) {
+        offset_q8 = (int32_t)((a - c) * 128 / den);
+        if (offset_q8 > 128) offset_q8 = 128;
+        if (offset_q8 < -128) offset_q8 = -128;
+    }
+    uint32_t tau_q8 = (uint32_t)((int32_t)(tau << 8) + offset_q8);
+
+    result->voiced = true;
+    result->freq_q4 = ((uint32_t)PITCH_SAMPLE_RATE_HZ << 12) / tau_q8;
+    result->aperiodicity_q15 = best > UINT16_MAX ? UINT16_MAX : (uint16_t)best;
+    return true;
+}
+
+/**
+ * @brief Nota temperada mais próxima de uma frequência (lá 4 = 440 Hz).
+ *
+ * @param freq_q4 Frequência em Hz (Q4), maior que 0.
+ * @param cents Recebe o desvio em centésimos de semitom (-50 a +50; positivo = acima).
+ * @return Número MIDI da nota (69 = lá 4).
+ */
+int pitch_nearest_note(uint32_t freq_q4, int *cents) {
+    uint64_t f = (uint64_t)freq_q4 << 8; // Q12
+    int octave = 4;
+
+    while (f < NOTE_LOWER_Q12) {
+        f <<= 1;
+        octave--;
+    }
+    while (f >= note_upper_q12[11]) {
+        f >>= 1;
+        octave++;
+    }
+
+    uint n = 0;
+    while (f >= note_upper_q12[n]) {
+        n++;
+    }
+
+    int64_t ref = note_ref_q12[n];
+    *cents = (int)(CENTS_PER_RATIO * ((int64_t)f - ref) / ((int64_t)f + ref));
+    return 12 * (octave + 1) + (int)n;
+}
+
+/**
+ * @brief Nome de uma nota MIDI sem a oitava ("C", "C#", ..., "B").
+ */
+const char *pitch_note_name(int midi) {
+    return note_names[((midi % 12) + 12) % 12];
+}
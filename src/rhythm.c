@@ -0,0 +1,289 @@
+#include "inc/rhythm.h"
+#include "inc/mem_layout.h"
+#include "inc/scheduler.h"
+#include "inc/timer_wheel.h"
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file rhythm.c
+ * @brief Implementação do modo de acompanhamento declarado em `rhythm.h`
+ *
+ * As notas chegam do sequenciador (tarefa de som) e os toques da ISR do GPIO, cada um em sua fila
+ * de produtor único. A tarefa do modo consome as duas em ordem de tempo.
+ */
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Resultado de uma rodada.
+ */
+typedef struct {
+    uint notes;         // Notas já decididas (acertadas ou perdidas)
+    uint perfect;
+    uint good;
+    uint ok;
+    uint missed;
+    uint extra;
+    int64_t delta_sum_us;
+    uint64_t abs_sum_us;
+} rhythm_stats_t;
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static volatile bool active;
+static bool ending;
+static uint32_t end_us;
+
+static uint32_t GENIUS_RING_DATA("rhythm") onsets[RHYTHM_QUEUE_SIZE];  // Produtor: tarefa de som
+static uint onset_head, onset_tail;
+static uint32_t GENIUS_RING_DATA("rhythm") presses[RHYTHM_QUEUE_SIZE]; // Produtor: ISR do GPIO
+static volatile uint press_head, press_tail;
+
+static rhythm_stats_t stats;
+
+static int32_t input_offset_us;                 // Da borda no pino à marca de tempo
+static int32_t output_offset_us;                // Da previsão de `start_tone_timed()` ao pino
+static bool calibrated;                         // `rhythm_set_compensation()` já foi chamada
+
+static scheduler_task_t rhythm_task;
+static timer_wheel_timer_t poll_timer;
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+static inline bool time_before(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+static void print_ms(uint32_t us) {
+    printf("%lu.%03lu ms", (unsigned long)(us / 1000), (unsigned long)(us % 1000));
+}
+
+static void print_signed_ms(int32_t us) {
+    printf("%c", us < 0 ? '-' : '+');
+    print_ms(us < 0 ? (uint32_t)-us : (uint32_t)us);
+}
+
+static void poll_timer_callback(timer_wheel_timer_t *timer) {
+    scheduler_signal(&rhythm_task);
+    timer_wheel_start(timer, RHYTHM_POLL_MS);
+}
+
+/**
+ * @brief Pontua um toque casado com uma nota.
+ *
+ * @param delta_us Toque menos nota, já compensados.
+ */
+static void score(int32_t delta_us) {
+    uint32_t mag = delta_us < 0 ? (uint32_t)-delta_us : (uint32_t)delta_us;
+    const char *grade;
+
+    if (mag <= RHYTHM_PERFECT_US) {
+        stats.perfect++;
+        grade = "perfeito";
+    } else if (mag <= RHYTHM_GOOD_US) {
+        stats.good++;
+        grade = "bom";
+    } else {
+        stats.ok++;
+        grade = "ok";
+    }
+    stats.notes++;
+    stats.delta_sum_us += delta_us;
+    stats.abs_sum_us += mag;
+
+    printf("\nNota %u: ", stats.notes);
+    print_signed_ms(delta_us);
+    printf(" %s\n", grade);
+}
+
+/**
+ * @brief Casa toques e notas cujas janelas já se fecharam.
+ *
+ * Cada nota aceita no máximo um toque, o mais próximo dentro de `RHYTHM_WINDOW_US`; um toque
+ * depois de uma nota só é decidido quando se sabe que a nota seguinte não está mais perto.
+ *
+ * @param now Instante atual.
+ * @param flush true no fim da rodada: decide tudo o que restar.
+ */
+static void settle(uint32_t now, bool flush) {
+    for (;;) {
+        bool have_onset = onset_head != onset_tail;
+        bool have_press = press_head != press_tail;
+        if (!have_onset && !have_press) {
+            return;
+        }
+
+        uint32_t onset = onsets[onset_head] + output_offset_us;
+        uint32_t press = presses[press_head] - input_offset_us;
+
+        if (have_press && (!have_onset || time_before(press, onset - RHYTHM_WINDOW_US))) {
+            if (!have_onset && !flush && time_before(now, press + RHYTHM_WINDOW_US)) {
+                return; // Uma nota ainda pode começar dentro da janela
+            }
+            stats.extra++;
+            press_head = (press_head + 1) % RHYTHM_QUEUE_SIZE;
+            continue;
+        }
+        if (!have_press || time_before(onset + RHYTHM_WINDOW_US, press)) {
+            if (!have_press && !flush && time_before(now, onset + RHYTHM_WINDOW_US)) {
+                return; // O toque ainda pode chegar
+            }
+            stats.notes++;
+            stats.missed++;
+            printf("\nNota %u: perdida\n", stats.notes);
+            onset_head = (onset_head + 1) % RHYTHM_QUEUE_SIZE;
+            continue;
+        }
+
+        int32_t delta = (int32_t)(press - onset);
+        if (delta > 0) {
+            uint next = (onset_head + 1) % RHYTHM_QUEUE_SIZE;
+            if (next != onset_tail) {
+                int32_t to_next = (int32_t)(onsets[next] + output_offset_us - press);
+                if (to_next < delta) {
+                    stats.notes++; // O toque é da nota seguinte
+                    stats.missed++;
+                    printf("\nNota %u: perdida\n", stats.notes);
+                    onset_head = next;
+                    continue;
+                }
+            } else if (!flush && time_before(now, press + (uint32_t)delta)) {
+                return; // A próxima nota ainda pode começar mais perto
+            }
+        }
+
+        score(delta);
+        onset_head = (onset_head + 1) % RHYTHM_QUEUE_SIZE;
+        press_head = (press_head + 1) % RHYTHM_QUEUE_SIZE;
+    }
+}
+
+static void print_summary() {
+    uint hits = stats.perfect + stats.good + stats.ok;
+
+    printf("\n--- Acompanhamento: %u notas ---\n", stats.notes);
+    printf("Acertos: %u (perfeito %u | bom %u | ok %u) | perdidas %u | extras %u\n", hits,
+           stats.perfect, stats.good, stats.ok, stats.missed, stats.extra);
+    if (hits > 0) {
+        printf("Diferenca media: ");
+        print_signed_ms((int32_t)(stats.delta_sum_us / (int64_t)hits));
+        printf(" (positiva = atrasado) | media absoluta: ");
+        print_ms((uint32_t)(stats.abs_sum_us / hits));
+        printf("\n");
+    }
+    printf("Pontos: %u de %u%s\n", 3 * stats.perfect + 2 * stats.good + stats.ok, 3 * stats.notes,
+           calibrated ? "" : " (sem calibracao: 'A')");
+}
+
+/**
+ * @brief Tarefa do modo: casa os eventos e encerra a rodada depois da última janela.
+ */
+static void rhythm_run() {
+    if (!active) {
+        return;
+    }
+
+    uint32_t now = time_us_32();
+    bool flush = ending && !time_before(now, end_us + RHYTHM_WINDOW_US);
+
+    settle(now, flush);
+    if (flush) {
+        active = false;
+        timer_wheel_cancel(&poll_timer);
+        print_summary();
+    }
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Registra a tarefa do modo. Requer `timer_wheel_init()`.
+ */
+void rhythm_init() {
+    timer_wheel_timer_init(&poll_timer, poll_timer_callback, NULL);
+    scheduler_task_init(&rhythm_task, "rhythm", rhythm_run, 2, 0); // Pontuação não é urgente
+    scheduler_add(&rhythm_task);
+}
+
+/**
+ * @brief Começa uma rodada. O chamador inicia a música logo em seguida.
+ */
+void rhythm_start() {
+    onset_head = onset_tail = 0;
+    press_head = press_tail = 0;
+    stats = (rhythm_stats_t){ 0 };
+    ending = false;
+    active = true;
+    timer_wheel_start(&poll_timer, RHYTHM_POLL_MS);
+    printf("\nAcompanhamento: toque A no inicio de cada nota; B encerra\n");
+}
+
+/**
+ * @brief Indica o fim da música (ou a pausa). A rodada é pontuada depois da última janela e o
+ * modo termina.
+ */
+void rhythm_song_end() {
+    if (active && !ending) {
+        ending = true;
+        end_us = time_us_32();
+    }
+}
+
+/**
+ * @brief Indica se há uma rodada em andamento (o botão A pertence ao modo).
+ */
+bool rhythm_active() {
+    return active;
+}
+
+/**
+ * @brief Registra o início de uma nota.
+ *
+ * @param onset_us Instante devolvido por `start_tone_timed()`.
+ */
+void rhythm_onset(uint32_t onset_us) {
+    uint next = (onset_tail + 1) % RHYTHM_QUEUE_SIZE;
+
+    if (active && !ending && next != onset_head) {
+        onsets[onset_tail] = onset_us;
+        onset_tail = next;
+    }
+}
+
+/**
+ * @brief Registra um toque no botão A. Pode ser chamada de ISRs.
+ *
+ * @param time_us Instante da borda (`gpio_irq_manager_edge_time_us()`).
+ */
+void rhythm_press(uint32_t time_us) {
+    uint next = (press_tail + 1) % RHYTHM_QUEUE_SIZE;
+
+    if (active && next != press_head) {
+        presses[press_tail] = time_us;
+        press_tail = next;
+    }
+}
+
+/**
+ * @brief Passa a descontar as latências medidas por `rhythm_calibrate()`.
+ *
+ * @param input_us Da borda no pino à marca de tempo do `gpio_irq_handler`.
+ * @param output_us Da previsão de `start_tone_timed()` ao primeiro pulso no pino.
+ */
+void rhythm_set_compensation(int32_t input_us, int32_t output_us) {
+    input_offset_us = input_us;
+    output_offset_us = output_us;
+    calibrated = true;
+}
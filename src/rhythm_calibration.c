@@ -0,0 +1,174 @@
+#include "inc/rhythm.h"
+#include "inc/BuzzerPi.h"
+#include "inc/board.h"
+#include "inc/gpio_irq_manager.h"
+#include "hardware/structs/sio.h"
+#include "hardware/sync.h"
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file rhythm_calibration.c
+ * @brief Calibração das latências do modo de acompanhamento (`rhythm_calibrate()` de `rhythm.h`)
+ *
+ * Fica num arquivo separado porque mede o hardware real (SIO, PWM e o pino de teste); a
+ * simulação no host o exclui e responde ao comando em `sim_diagnostics.c`.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define CAL_EDGES (GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL)
+
+/**
+ * @brief Frequências da calibração de saída, alternadas para variar o período em andamento.
+ */
+static const uint16_t cal_tones[] = { 42, 392, 131, 880, 262, 1319, 523, 2093 };
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static volatile bool cal_fired;
+static volatile uint32_t cal_stamp;
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Callback do pino de calibração (chamado por `gpio_irq_handler`).
+ */
+static void cal_callback() {
+    cal_stamp = gpio_irq_manager_edge_time_us();
+    cal_fired = true;
+}
+
+/**
+ * @brief Latência da borda no pino até a marca de tempo do `gpio_irq_handler`.
+ *
+ * @param offset_us Recebe a média arredondada; não é alterado se nenhuma borda chegar.
+ */
+static void calibrate_input(int32_t *offset_us) {
+    uint32_t count = 0, max = 0;
+    uint64_t sum = 0;
+
+    gpio_init(RHYTHM_CAL_PIN);
+    gpio_put(RHYTHM_CAL_PIN, 0);
+    gpio_set_dir(RHYTHM_CAL_PIN, GPIO_OUT);
+    register_gpio_callback(RHYTHM_CAL_PIN, cal_callback, CAL_EDGES);
+    gpio_irq_manager_set_debounce(RHYTHM_CAL_PIN, 0); // Cada borda deve chegar ao callback
+
+    for (int i = 0; i < RHYTHM_CAL_EDGES; i++) {
+        cal_fired = false;
+
+        uint32_t irq_state = save_and_disable_interrupts();
+        uint32_t start = time_us_32();
+        sio_hw->gpio_togl = BOARD_PIN_MASK(RHYTHM_CAL_PIN); // A borda
+        restore_interrupts(irq_state);
+
+        while (!cal_fired && time_us_32() - start < RHYTHM_CAL_TIMEOUT_US) {
+            tight_loop_contents();
+        }
+        if (!cal_fired) {
+            continue;
+        }
+        uint32_t latency = cal_stamp - start;
+        sum += latency;
+        count++;
+        if (latency > max) max = latency;
+    }
+
+    remove_gpio_callback(RHYTHM_CAL_PIN, CAL_EDGES);
+    gpio_init(RHYTHM_CAL_PIN); // Volta a ser entrada comum
+
+    if (count == 0) {
+        printf("Entrada: sem bordas (o pino %d esta preso por um circuito externo?)\n", RHYTHM_CAL_PIN);
+        return;
+    }
+    uint32_t mean_x1000 = (uint32_t)(sum * 1000 / count);
+    printf("Entrada (borda -> marca de tempo): media %lu.%03lu us | max %lu us | %lu bordas\n",
+           (unsigned long)(mean_x1000 / 1000), (unsigned long)(mean_x1000 % 1000),
+           (unsigned long)max, (unsigned long)count);
+    *offset_us = (int32_t)((sum + count / 2) / count);
+}
+
+/**
+ * @brief Erro da previsão de `start_tone_timed()` medido no próprio pino do buzzer.
+ *
+ * @param offset_us Recebe o erro médio; não é alterado se nenhum pulso for lido.
+ */
+static void calibrate_output(int32_t *offset_us) {
+    pwm_slice_hw_t *slice = &pwm_hw->slice[BUZZER_PWM_SLICE];
+    uint32_t count = 0, raw_max = 0;
+    uint64_t raw_sum = 0;
+    int64_t error_sum = 0;
+    int32_t error_min = INT32_MAX, error_max = INT32_MIN;
+
+    for (int i = 0; i < RHYTHM_CAL_TONES; i++) {
+        uint32_t period_us = slice->top + 1; // Tiques de 1 us (`CLK_DIV_DEFAULT`)
+
+        stop_tone(BUZZER_PIN);
+        sleep_us(period_us + 100);                 // Nível 0 vale a partir do próximo wrap
+        sleep_us((uint32_t)i * 7919u % period_us); // Fase variada dentro do período
+        if (gpio_get(BUZZER_PIN)) {
+            continue;
+        }
+
+        uint32_t irq_state = save_and_disable_interrupts();
+        uint32_t called = time_us_32();
+        uint32_t predicted = start_tone_timed(BUZZER_PIN, cal_tones[i % count_of(cal_tones)]);
+        while (!(sio_hw->gpio_in & BOARD_PIN_MASK(BUZZER_PIN)) &&
+               time_us_32() - called < RHYTHM_CAL_TIMEOUT_US) {
+            tight_loop_contents();
+        }
+        uint32_t seen = time_us_32();
+        restore_interrupts(irq_state);
+
+        if (seen - called >= RHYTHM_CAL_TIMEOUT_US) {
+            continue;
+        }
+        int32_t error = (int32_t)(seen - predicted);
+        raw_sum += seen - called;
+        if (seen - called > raw_max) raw_max = seen - called;
+        error_sum += error;
+        if (error < error_min) error_min = error;
+        if (error > error_max) error_max = error;
+        count++;
+    }
+    stop_tone(BUZZER_PIN);
+
+    if (count == 0) {
+        printf("Saida: nenhum pulso lido em BUZZER_PIN\n");
+        return;
+    }
+    printf("Saida sem previsao (escrita -> pino): media %lu us | max %lu us\n",
+           (unsigned long)(raw_sum / count), (unsigned long)raw_max);
+    printf("Saida com previsao (erro): media %ld us | min %ld us | max %ld us | %lu tons\n",
+           (long)(error_sum / count), (long)error_min, (long)error_max, (unsigned long)count);
+    *offset_us = (int32_t)(error_sum / (int64_t)count);
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Mede as latências de entrada e de saída, imprime o resultado e passa a descontá-las.
+ *
+ * Bloqueia por cerca de 1 s e usa o buzzer: o reprodutor deve estar parado. Nada deve estar
+ * conectado a `RHYTHM_CAL_PIN`.
+ */
+void rhythm_calibrate() {
+    int32_t input_us = 0, output_us = 0;
+
+    printf("\n--- Calibracao do acompanhamento ---\n");
+    calibrate_input(&input_us);
+    calibrate_output(&output_us);
+    rhythm_set_compensation(input_us, output_us);
+    printf("Compensacao: entrada %ld us | saida %ld us\n", (long)input_us, (long)output_us);
+}
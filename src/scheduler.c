@@ -0,0 +1,207 @@
+#include "inc/scheduler.h"
+#include "inc/heap_tracker.h"
+#include "inc/genius_config.h"
+#include "hardware/sync.h"
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file scheduler.c
+ * @brief Implementação do escalonador cooperativo de tarefas
+ *
+ * Este arquivo implementa as funções declaradas em `scheduler.h`. As tarefas ficam em uma tabela
+ * estática ordenada por prioridade; a escolha da próxima tarefa percorre a tabela e para na
+ * primeira pronta.
+ */
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static scheduler_task_t *tasks[SCHED_MAX_TASKS]; // Ordenadas por prioridade
+static uint task_count;
+static uint64_t idle_us;       // Tempo dormindo sem tarefas prontas
+static uint64_t started_us;    // Início de scheduler_run()
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Ativação periódica: marca a tarefa como pronta e arma o próximo período.
+ */
+static void GENIUS_HOT_FUNC(period_callback)(timer_wheel_timer_t *timer) {
+    scheduler_task_t *task = timer->user_data;
+
+    scheduler_signal(task);
+    timer_wheel_start(timer, task->period_ms);
+}
+
+/**
+ * @brief Retira da fila a tarefa pronta de maior prioridade.
+ *
+ * A liberação é copiada junto com a retirada: um sinal recebido durante a execução regrava
+ * `release_us` para a próxima ativação, e o tempo de resposta desta deve partir da anterior.
+ *
+ * @param release_us Recebe o instante de liberação da ativação retirada.
+ * @return Tarefa a executar, ou NULL se nenhuma estiver pronta.
+ */
+static scheduler_task_t *GENIUS_HOT_FUNC(pick_ready)(uint32_t *release_us) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    scheduler_task_t *picked = NULL;
+
+    for (uint i = 0; i < task_count; i++) {
+        if (tasks[i]->ready) {
+            tasks[i]->ready = false; // Sinais recebidos durante a execução geram nova ativação
+            *release_us = tasks[i]->release_us;
+            picked = tasks[i];
+            break;
+        }
+    }
+
+    restore_interrupts(irq_state);
+    return picked;
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Prepara uma tarefa.
+ *
+ * @param task Tarefa a inicializar.
+ * @param name Nome da tarefa.
+ * @param run Função executada a cada ativação.
+ * @param priority Prioridade (0 = maior).
+ * @param period_ms Período em milissegundos, ou 0 para tarefas só por evento.
+ */
+void scheduler_task_init(scheduler_task_t *task, const char *name, void (*run)(void),
+                         uint8_t priority, uint32_t period_ms) {
+    *task = (scheduler_task_t){ .name = name, .run = run, .priority = priority, .period_ms = period_ms };
+    timer_wheel_timer_init(&task->timer, period_callback, task);
+}
+
+/**
+ * @brief Registra uma tarefa e, se for periódica, arma sua primeira ativação.
+ *
+ * Com a tabela cheia causa `panic()`: uma tarefa que não entra nunca executaria, sem aviso.
+ *
+ * @param task Tarefa inicializada.
+ */
+void scheduler_add(scheduler_task_t *task) {
+    if (task_count >= SCHED_MAX_TASKS) {
+        panic("tabela de tarefas cheia (%s): aumente SCHED_MAX_TASKS", task->name);
+    }
+
+    // Inserção ordenada: tarefas de mesma prioridade mantêm a ordem de registro
+    uint i = task_count;
+    while (i > 0 && tasks[i - 1]->priority > task->priority) {
+        tasks[i] = tasks[i - 1];
+        i--;
+    }
+    tasks[i] = task;
+    task_count++;
+
+    if (task->period_ms > 0) {
+        timer_wheel_start(&task->timer, task->period_ms);
+    }
+}
+
+/**
+ * @brief Torna uma tarefa pronta. Pode ser chamada de ISRs.
+ *
+ * O instante de liberação só é registrado na primeira sinalização, para que o tempo de resposta
+ * inclua toda a espera.
+ *
+ * @param task Tarefa a ativar.
+ */
+void GENIUS_HOT_FUNC(scheduler_signal)(scheduler_task_t *task) {
+    uint32_t irq_state = save_and_disable_interrupts();
+
+    if (!task->ready) {
+        task->release_us = time_us_32();
+        task->ready = true;
+    }
+
+    restore_interrupts(irq_state);
+}
+
+/**
+ * @brief Executa as tarefas prontas para sempre.
+ *
+ * Sem tarefas prontas o núcleo aguarda em `__wfe()`: qualquer interrupção atendida o acorda, e
+ * uma sinalização feita entre a verificação e o `__wfe()` não se perde, pois a entrada na
+ * interrupção também marca o evento.
+ */
+void scheduler_run() {
+    started_us = time_us_64();
+
+    while (true) {
+        uint32_t release_us;
+        scheduler_task_t *task = pick_ready(&release_us);
+
+        if (task == NULL) {
+            uint64_t sleep_start = time_us_64();
+            __wfe();
+            idle_us += time_us_64() - sleep_start;
+            continue;
+        }
+
+        HEAP_CONTEXT(task->name);
+        uint32_t start = time_us_32();
+        task->run();
+        uint32_t end = time_us_32();
+
+        uint32_t exec = end - start;
+        uint32_t response = end - release_us;
+        task->runs++;
+        task->total_us += exec;
+        if (exec > task->max_exec_us) task->max_exec_us = exec;
+        if (response > task->wcrt_us) task->wcrt_us = response;
+    }
+}
+
+/**
+ * @brief Obtém uma tarefa registrada, em ordem de prioridade.
+ *
+ * @param index Posição na tabela (0 = maior prioridade).
+ * @return Tarefa, ou NULL se `index` passar do número de tarefas registradas.
+ */
+const scheduler_task_t *scheduler_task_at(uint index) {
+    return index < task_count ? tasks[index] : NULL;
+}
+
+/**
+ * @brief Imprime execuções, tempos de execução, WCRT e ocupação da CPU de cada tarefa.
+ */
+void scheduler_report() {
+    uint64_t elapsed = time_us_64() - started_us;
+
+    if (elapsed == 0) {
+        elapsed = 1;
+    }
+
+    printf("\n--- Tarefas ---\n");
+    printf("%-10s %4s %8s %9s %8s %8s %8s %6s\n",
+           "tarefa", "prio", "periodo", "execucoes", "media_us", "max_us", "wcrt_us", "cpu%");
+    for (uint i = 0; i < task_count; i++) {
+        scheduler_task_t *t = tasks[i];
+        uint32_t load = t->total_us * 1000 / elapsed; // Décimos de porcento
+        char period[24] = "evento";
+
+        if (t->period_ms > 0) {
+            snprintf(period, sizeof(period), "%lums", (unsigned long)t->period_ms);
+        }
+        printf("%-10s %4u %8s %9lu %8lu %8lu %8lu %4lu.%lu\n", t->name, t->priority, period,
+               (unsigned long)t->runs, (unsigned long)(t->runs ? t->total_us / t->runs : 0),
+               (unsigned long)t->max_exec_us, (unsigned long)t->wcrt_us,
+               (unsigned long)(load / 10), (unsigned long)(load % 10));
+    }
+
+    uint32_t idle = idle_us * 1000 / elapsed;
+    printf("ocioso: %lu.%lu%% do tempo\n", (unsigned long)(idle / 10), (unsigned long)(idle % 10));
+}
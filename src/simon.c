@@ -0,0 +1,429 @@
+#include "inc/simon.h"
+#include "inc/BuzzerPi.h"
+#include "inc/JoystickPi.h"
+#include "inc/board.h"
+#include "inc/mem_layout.h"
+#include "inc/scheduler.h"
+#include "inc/timer_wheel.h"
+#include "hardware/sync.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file simon.c
+ * @brief Implementação do modo de jogo declarado em `simon.h`
+ *
+ * Os callbacks dos temporizadores (contexto de IRQ) só desligam tons e sinalizam a tarefa do
+ * jogo; todas as transições de estado acontecem na tarefa.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define SIMON_QUEUE_SIZE 8   // Toques aguardando validação
+#define SIMON_SLOW_ROUNDS 5
+#define SIMON_MEDIUM_ROUNDS 13
+
+static const uint16_t symbol_tones[4] = { 415, 310, 252, 209 };
+static const char *symbol_names[4] = { "A", "B", "esquerda", "direita" };
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Fase do jogo.
+ */
+typedef enum {
+    PHASE_OFF = 0,  // Fora do modo de jogo
+    PHASE_PAUSE,    // Antes da deixa da rodada
+    PHASE_CUE,      // Tocando a deixa
+    PHASE_INPUT,    // Esperando o jogador
+    PHASE_OVER,     // Fim de jogo; o próximo toque recomeça
+} simon_phase_t;
+
+/**
+ * @brief Mínimo, soma e máximo de tempos de reação.
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t total_us;
+} reaction_stats_t;
+
+/**
+ * @brief Toque aguardando validação.
+ */
+typedef struct {
+    uint8_t symbol;
+    uint32_t time_us;
+} simon_press_t;
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static uint8_t sequence[SIMON_MAX_STEPS / 4];   // 2 bits por passo
+static uint length;                             // Passos da rodada atual
+static uint cue_pos;                            // Próximo passo da deixa
+static uint input_pos;                          // Próximo passo esperado do jogador
+static volatile simon_phase_t phase;
+static uint32_t rng_state;
+
+static scheduler_task_t simon_task;
+static timer_wheel_timer_t step_timer;          // Deixa, pausa entre rodadas e prazo de resposta
+static timer_wheel_timer_t tone_timer;          // Fim do tom de confirmação e do fim de jogo
+static timer_wheel_timer_t poll_timer;          // Amostragem do joystick
+
+static volatile bool cue_tone_on;
+static volatile bool step_due;
+static volatile bool poll_due;
+static volatile uint32_t cue_off_us;            // Fim do último tom da deixa
+
+static simon_press_t GENIUS_RING_DATA("simon") queue[SIMON_QUEUE_SIZE]; // Produtor: ISR do GPIO
+static volatile uint queue_head, queue_tail;
+
+static uint32_t reference_us;                   // Início da contagem da próxima reação
+static volatile bool over_done;                 // O tom de fim de jogo terminou
+static bool joystick_centered = true;
+static reaction_stats_t round_stats, game_stats;
+static uint best_rounds;
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+static inline simon_symbol_t sequence_get(uint step) {
+    return (sequence[step >> 2] >> ((step & 3) * 2)) & 3u;
+}
+
+static inline void sequence_set(uint step, simon_symbol_t symbol) {
+    uint shift = (step & 3) * 2;
+    sequence[step >> 2] = (sequence[step >> 2] & ~(3u << shift)) | ((uint)symbol << shift);
+}
+
+/**
+ * @brief Gerador xorshift32 para os passos da sequência.
+ */
+static uint32_t rng_next() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static uint cue_ms() {
+    if (length <= SIMON_SLOW_ROUNDS) return SIMON_CUE_SLOW_MS;
+    if (length <= SIMON_MEDIUM_ROUNDS) return SIMON_CUE_MEDIUM_MS;
+    return SIMON_CUE_FAST_MS;
+}
+
+static void stats_reset(reaction_stats_t *stats) {
+    *stats = (reaction_stats_t){ .min_us = UINT32_MAX };
+}
+
+static void stats_add(reaction_stats_t *stats, uint32_t us) {
+    stats->count++;
+    stats->total_us += us;
+    if (us < stats->min_us) stats->min_us = us;
+    if (us > stats->max_us) stats->max_us = us;
+}
+
+static void print_ms(uint32_t us) {
+    printf("%lu.%03lu ms", (unsigned long)(us / 1000), (unsigned long)(us % 1000));
+}
+
+static void print_stats(const reaction_stats_t *stats) {
+    if (stats->count == 0) {
+        printf("sem toques\n");
+        return;
+    }
+    printf("reacao min ");
+    print_ms(stats->min_us);
+    printf(" | media ");
+    print_ms((uint32_t)(stats->total_us / stats->count));
+    printf(" | max ");
+    print_ms(stats->max_us);
+    printf("\n");
+}
+
+/**
+ * @brief Fim de um passo: desliga o tom da deixa e espera o silêncio, ou sinaliza a tarefa.
+ */
+static void step_timer_callback(timer_wheel_timer_t *timer) {
+    if (cue_tone_on) {
+        stop_tone(BUZZER_PIN);
+        cue_tone_on = false;
+        cue_off_us = time_us_32();
+        if (cue_pos < length) {
+            timer_wheel_start(timer, SIMON_CUE_GAP_MS);
+            return;
+        }
+    }
+    step_due = true;
+    scheduler_signal(&simon_task);
+}
+
+static void tone_timer_callback(timer_wheel_timer_t *timer) {
+    (void)timer;
+    stop_tone(BUZZER_PIN);
+    if (phase == PHASE_OVER) {
+        over_done = true; // Um instante guardado voltaria a parecer futuro após 2^31 us
+    }
+}
+
+static void poll_timer_callback(timer_wheel_timer_t *timer) {
+    poll_due = true;
+    scheduler_signal(&simon_task);
+    timer_wheel_start(timer, SIMON_POLL_MS);
+}
+
+/**
+ * @brief Liga um tom por `ms` milissegundos sem bloquear.
+ */
+static void play_feedback(uint32_t freq, uint ms) {
+    start_tone(BUZZER_PIN, freq);
+    timer_wheel_start(&tone_timer, ms);
+}
+
+/**
+ * @brief Acrescenta um passo e agenda a deixa da rodada.
+ */
+static void next_round() {
+    sequence_set(length, (simon_symbol_t)(rng_next() & 3u));
+    length++;
+    phase = PHASE_PAUSE;
+    timer_wheel_start(&step_timer, SIMON_ROUND_PAUSE_MS);
+}
+
+static void new_game() {
+    rng_state ^= time_us_32() | 1u; // Instante do toque que começou o jogo
+    length = 0;
+    stats_reset(&game_stats);
+    printf("\n--- Genius: novo jogo ---\n");
+    next_round();
+}
+
+static void game_over(const char *reason) {
+    uint rounds = length - 1;
+
+    timer_wheel_cancel(&step_timer);
+    over_done = false;
+    phase = PHASE_OVER;
+    play_feedback(SIMON_FAIL_HZ, SIMON_FAIL_MS);
+
+    if (rounds > best_rounds) {
+        best_rounds = rounds;
+    }
+    printf("\nFim de jogo (%s): %u rodadas | recorde %u\n", reason, rounds, best_rounds);
+    printf("Jogo: ");
+    print_stats(&game_stats);
+    printf("Toque qualquer entrada para jogar de novo\n");
+}
+
+/**
+ * @brief Passa a esperar o jogador, a partir do fim do último tom da deixa.
+ */
+static void begin_input() {
+    phase = PHASE_INPUT;
+    input_pos = 0;
+    reference_us = cue_off_us;
+    stats_reset(&round_stats);
+    timer_wheel_start(&step_timer, SIMON_TIMEOUT_MS);
+}
+
+/**
+ * @brief Valida um toque contra o próximo passo esperado.
+ */
+static void handle_press(simon_symbol_t symbol, uint32_t time_us) {
+    if (phase == PHASE_OVER) {
+        if (over_done) {
+            new_game();
+        }
+        return;
+    }
+    if ((int32_t)(time_us - reference_us) < 0) {
+        return; // Durante a deixa
+    }
+
+    uint32_t reaction = time_us - reference_us;
+    reference_us = time_us;
+
+    if (reaction > SIMON_TIMEOUT_MS * 1000u) {
+        game_over("tempo esgotado");
+        return;
+    }
+    if (symbol != sequence_get(input_pos)) {
+        printf("\nEsperado %s, tocado %s\n", symbol_names[sequence_get(input_pos)], symbol_names[symbol]);
+        game_over("erro");
+        return;
+    }
+
+    play_feedback(symbol_tones[symbol], SIMON_FEEDBACK_MS);
+    stats_add(&round_stats, reaction);
+    stats_add(&game_stats, reaction);
+    input_pos++;
+
+    if (input_pos < length) {
+        timer_wheel_start(&step_timer, SIMON_TIMEOUT_MS);
+        return;
+    }
+
+    printf("\nRodada %u: ", length);
+    print_stats(&round_stats);
+    if (length == SIMON_MAX_STEPS) {
+        length++; // Todas as rodadas completas
+        game_over("sequencia maxima");
+        return;
+    }
+    next_round();
+}
+
+/**
+ * @brief Amostra o eixo X e converte um movimento a partir do centro em um toque.
+ */
+static void poll_joystick() {
+    uint32_t now = time_us_32();
+    joystick_state_t js = joystickPi_read();
+
+    if (joystick_centered) {
+        if (js.x < SIMON_JOY_LEFT) {
+            joystick_centered = false;
+            simon_press(SIMON_LEFT, now);
+        } else if (js.x > SIMON_JOY_RIGHT) {
+            joystick_centered = false;
+            simon_press(SIMON_RIGHT, now);
+        }
+    } else if (abs((int)js.x - JOYSTICK_CENTER) < SIMON_JOY_CENTER_BAND) {
+        joystick_centered = true;
+    }
+}
+
+/**
+ * @brief Tarefa do jogo: joystick, deixa, prazos e validação dos toques.
+ */
+static void simon_run() {
+    if (phase == PHASE_OFF) {
+        return;
+    }
+    if (poll_due) {
+        poll_due = false;
+        poll_joystick();
+    }
+
+    // Toques primeiro: um toque dentro do prazo rearma o temporizador antes do prazo ser tratado
+    while ((phase == PHASE_INPUT || phase == PHASE_OVER) && queue_head != queue_tail) {
+        simon_symbol_t symbol = queue[queue_head].symbol;
+        uint32_t time_us = queue[queue_head].time_us;
+        queue_head = (queue_head + 1) % SIMON_QUEUE_SIZE;
+        handle_press(symbol, time_us);
+    }
+
+    if (step_due) {
+        step_due = false;
+        switch (phase) {
+            case PHASE_PAUSE:
+                timer_wheel_cancel(&tone_timer);
+                phase = PHASE_CUE;
+                cue_pos = 0;
+                // fallthrough
+            case PHASE_CUE:
+                if (cue_pos < length) {
+                    cue_tone_on = true;
+                    start_tone(BUZZER_PIN, symbol_tones[sequence_get(cue_pos)]);
+                    cue_pos++;
+                    timer_wheel_start(&step_timer, cue_ms());
+                } else {
+                    begin_input();
+                    scheduler_signal(&simon_task); // Toques feitos no fim da deixa
+                }
+                break;
+            case PHASE_INPUT:
+                if (!timer_wheel_pending(&step_timer)) {
+                    game_over("tempo esgotado");
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Prepara os temporizadores e registra a tarefa do jogo. Requer `timer_wheel_init()`.
+ */
+void simon_init() {
+    timer_wheel_timer_init(&step_timer, step_timer_callback, NULL);
+    timer_wheel_timer_init(&tone_timer, tone_timer_callback, NULL);
+    timer_wheel_timer_init(&poll_timer, poll_timer_callback, NULL);
+    scheduler_task_init(&simon_task, "simon", simon_run, 1, 0); // Mesma prioridade da entrada
+    scheduler_add(&simon_task);
+    rng_state = 0x9E3779B9u;
+}
+
+/**
+ * @brief Entra no modo de jogo e começa um jogo. O buzzer deve estar livre.
+ */
+void simon_start() {
+    if (phase != PHASE_OFF) {
+        return;
+    }
+    queue_head = queue_tail = 0;
+    joystick_centered = true;
+    best_rounds = 0;
+    printf("\nModo Genius: repita a sequencia com A, B e o joystick (esquerda/direita); 's' sai\n");
+    new_game();
+    timer_wheel_start(&poll_timer, SIMON_POLL_MS);
+}
+
+/**
+ * @brief Sai do modo de jogo e libera o buzzer.
+ */
+void simon_stop() {
+    if (phase == PHASE_OFF) {
+        return;
+    }
+    phase = PHASE_OFF;
+    timer_wheel_cancel(&poll_timer);
+    timer_wheel_cancel(&step_timer);
+    timer_wheel_cancel(&tone_timer);
+    cue_tone_on = false;
+    stop_tone(BUZZER_PIN);
+    printf("\nModo Genius encerrado (recorde %u rodadas)\n", best_rounds);
+}
+
+/**
+ * @brief Indica se o modo de jogo está ativo (os botões pertencem ao jogo).
+ */
+bool simon_active() {
+    return phase != PHASE_OFF;
+}
+
+/**
+ * @brief Entrega um toque do jogador. Pode ser chamada de ISRs.
+ *
+ * @param symbol Símbolo tocado.
+ * @param time_us Instante do toque (`time_us_32()`).
+ */
+void simon_press(simon_symbol_t symbol, uint32_t time_us) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    uint next = (queue_tail + 1) % SIMON_QUEUE_SIZE;
+
+    if (phase != PHASE_OFF && next != queue_head) { // Fila cheia: o toque é descartado
+        queue[queue_tail].symbol = symbol;
+        queue[queue_tail].time_us = time_us;
+        queue_tail = next;
+    }
+    restore_interrupts(irq_state);
+    scheduler_signal(&simon_task);
+}
@@ -0,0 +1,21 @@
+#include "inc/songs.h"
+#include "inc/melody.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file songs.c
+ * @brief Tabela das músicas declarada em `songs.h`
+ */
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+const Melody melodies[SONG_COUNT] = {
+    {AsaBrancaMelody, AsaBrancaDurations, sizeof(AsaBrancaMelody)/sizeof(int), "Asa Branca"},
+    {ForEliseMelody, ForEliseDurations, sizeof(ForEliseMelody)/sizeof(int), "Für Elise"},
+    {CanoninDMelody, CanoninDurations, sizeof(CanoninDMelody)/sizeof(int), "Canon in D"}
+};
@@ -0,0 +1,102 @@
+#include "inc/stack_monitor.h"
+#include "inc/mem_layout.h"
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file stack_monitor.c
+ * @brief Implementação da marca d'água das pilhas
+ *
+ * Este arquivo implementa as funções declaradas em `stack_monitor.h`. Os limites de cada pilha
+ * vêm dos símbolos definidos pelo script de ligação do SDK.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Margem preservada abaixo do ponteiro de pilha atual durante a pintura.
+ */
+#define STACK_PAINT_MARGIN 64
+
+/******************************
+ * Símbolos do Script de Ligação
+ ******************************/
+
+extern uint32_t __StackBottom, __StackTop;       // Pilha do núcleo 0 (SCRATCH_Y)
+extern uint32_t __StackOneBottom, __StackOneTop; // Pilha do núcleo 1 (SCRATCH_X)
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static uint32_t *const stack_bottom[STACK_COUNT] = { &__StackBottom, &__StackOneBottom };
+static uint32_t *const stack_top[STACK_COUNT] = { &__StackTop, &__StackOneTop };
+static const char *stack_names[STACK_COUNT] = { "nucleo0+irq", "nucleo1" };
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Pinta as regiões de pilha livres.
+ *
+ * A pilha do núcleo 0 está em uso durante a chamada: apenas a região abaixo do ponteiro de pilha
+ * atual (menos uma margem) é pintada. A pilha do núcleo 1 é pintada por inteiro.
+ */
+void __attribute__((noinline)) stack_monitor_init() {
+    uintptr_t sp;
+    __asm volatile ("mov %0, sp" : "=r" (sp));
+
+    for (uint32_t *p = stack_bottom[STACK_CORE0]; (uintptr_t)p < sp - STACK_PAINT_MARGIN; p++) {
+        *p = STACK_PAINT_PATTERN;
+    }
+    for (uint32_t *p = stack_bottom[STACK_CORE1]; p < stack_top[STACK_CORE1]; p++) {
+        *p = STACK_PAINT_PATTERN;
+    }
+}
+
+/**
+ * @brief Obtém o tamanho total de uma pilha.
+ *
+ * @param id Pilha desejada.
+ * @return Tamanho em bytes.
+ */
+uint32_t stack_monitor_size(stack_id_t id) {
+    return (uint32_t)((uintptr_t)stack_top[id] - (uintptr_t)stack_bottom[id]);
+}
+
+/**
+ * @brief Obtém a marca d'água máxima de uso de uma pilha.
+ *
+ * Percorre a pilha a partir do fundo até a primeira palavra que não contém o padrão.
+ *
+ * @param id Pilha desejada.
+ * @return Maior quantidade de bytes já usada desde a pintura.
+ */
+uint32_t stack_monitor_high_water(stack_id_t id) {
+    const uint32_t *p = stack_bottom[id];
+
+    while (p < stack_top[id] && *p == STACK_PAINT_PATTERN) {
+        p++;
+    }
+    return (uint32_t)((uintptr_t)stack_top[id] - (uintptr_t)p);
+}
+
+/**
+ * @brief Imprime tamanho, uso máximo e folga de cada pilha.
+ */
+void stack_monitor_report() {
+    printf("\n--- Pilhas (marca d'agua) ---\n");
+    for (int i = 0; i < STACK_COUNT; i++) {
+        uint32_t size = stack_monitor_size(i);
+        uint32_t used = stack_monitor_high_water(i);
+        printf("%-12s %-9s %5lu B  usado %5lu B  folga %5lu B\n", stack_names[i],
+               mem_layout_bank_name(stack_bottom[i]), (unsigned long)size,
+               (unsigned long)used, (unsigned long)(size - used));
+    }
+}
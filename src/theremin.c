@@ -0,0 +1,393 @@
+#include "inc/theremin.h"
+#include "inc/BuzzerPi.h"
+#include "inc/JoystickPi.h"
+#include "inc/board.h"
+#include "inc/genius_config.h"
+#include "inc/scheduler.h"
+#include "inc/timer_wheel.h"
+#include "hardware/clocks.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file theremin.c
+ * @brief Implementação do modo teremim declarado em `theremin.h`
+ *
+ * A tarefa faz todo o cálculo; a ISR de wrap só copia os dois valores publicados para os
+ * registradores e fecha o evento de latência que eles carregam. A publicação é feita com as
+ * interrupções desligadas, então a ISR nunca vê um TOP de uma publicação e o CC de outra.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief 2^(-i/16) em Q16, i de 0 a 16: fração de oitava -> fator do período.
+ */
+static const uint32_t exp2_neg_q16[17] = {
+    65536, 62757, 60097, 57549, 55109, 52773, 50535, 48393, 46341,
+    44376, 42495, 40693, 38968, 37316, 35734, 34219, 32768,
+};
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Estágios de um evento de latência.
+ */
+typedef enum {
+    STAGE_FILTER = 0,   // Leitura com movimento -> leitura com o filtro além da metade
+    STAGE_WRAP,         // -> escrita pela ISR (cálculo, publicação e espera pelo wrap)
+    STAGE_LATCH,        // -> wrap em que os registradores passam a valer
+    STAGE_COUNT
+} theremin_stage_t;
+
+static const char *stage_names[STAGE_COUNT] = { "filtro", "espera do wrap", "registrador -> pino" };
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static volatile bool active;
+static scheduler_task_t theremin_task;
+static timer_wheel_timer_t tick_timer;
+
+static uint32_t tick_hz;                // Tiques do contador do PWM por segundo
+static uint32_t us_per_tick_q16;
+static uint32_t base_period_q8;         // Período de `THEREMIN_LOW_HZ`, em tiques (Q8)
+
+// Laço de controle (tarefa)
+static bool primed;
+static int32_t filtered_q4;             // Eixo X filtrado (Q4)
+static bool gate;
+static uint gate_count;
+static uint32_t freq_hz;
+static uint16_t published_top, published_level;
+
+// Evento de latência em andamento (tarefa)
+static bool event_open;
+static uint16_t ref_x, target_x;
+static uint32_t event_start_us;
+
+// Tarefa -> ISR
+static volatile struct {
+    uint16_t top;
+    uint16_t level;
+    bool close;             // Os valores fecham um evento de latência
+    uint32_t start_us;
+    uint32_t cross_us;
+} pending;
+
+// Estatísticas (ISR e tarefa; lidas com o modo parado)
+static uint32_t events;
+static uint64_t latency_total_us;
+static uint32_t latency_min_us, latency_max_us;
+static struct {
+    uint64_t total_us;
+    uint32_t max_us;
+} stages[STAGE_COUNT];
+static uint32_t straddled;              // Escritas com um wrap entre TOP e CC
+static uint32_t samples;
+static uint32_t last_sample_us;
+static uint64_t interval_total_us;
+static uint32_t interval_max_us;
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+static void tick_timer_callback(timer_wheel_timer_t *timer) {
+    scheduler_signal(&theremin_task);
+    timer_wheel_start(timer, THEREMIN_PERIOD_MS);
+}
+
+static void GENIUS_HOT_FUNC(add_stage)(theremin_stage_t stage, uint32_t us) {
+    stages[stage].total_us += us;
+    if (us > stages[stage].max_us) {
+        stages[stage].max_us = us;
+    }
+}
+
+/**
+ * @brief ISR de wrap do PWM: escreve TOP e CC publicados logo depois de um wrap.
+ */
+static void GENIUS_HOT_FUNC(wrap_irq_handler)() {
+    pwm_slice_hw_t *slice = &pwm_hw->slice[BUZZER_PWM_SLICE];
+
+    pwm_clear_irq(BUZZER_PWM_SLICE);
+    pwm_set_irq_enabled(BUZZER_PWM_SLICE, false); // Até a próxima publicação
+
+    uint32_t now = time_us_32();
+    uint32_t ctr = slice->ctr;
+    uint32_t ticks = slice->top - ctr + 1; // Até o wrap em que os valores novos passam a valer
+
+    slice->top = pending.top;
+    hw_write_masked(&slice->cc, (uint32_t)pending.level << BOARD_PWM_CC_SHIFT(BUZZER_PIN),
+                    BOARD_PWM_CC_MASK(BUZZER_PIN));
+    if (slice->ctr < ctr) {
+        straddled++;
+    }
+
+    if (pending.close) {
+        uint32_t latch_us = now + (uint32_t)(((uint64_t)ticks * us_per_tick_q16) >> 16);
+        uint32_t latency = latch_us - pending.start_us;
+
+        add_stage(STAGE_FILTER, pending.cross_us - pending.start_us);
+        add_stage(STAGE_WRAP, now - pending.cross_us);
+        add_stage(STAGE_LATCH, latch_us - now);
+        events++;
+        latency_total_us += latency;
+        if (latency < latency_min_us) latency_min_us = latency;
+        if (latency > latency_max_us) latency_max_us = latency;
+        pending.close = false;
+    }
+}
+
+/**
+ * @brief Período do PWM, em tiques, para o eixo X filtrado.
+ *
+ * @param x_q4 Eixo X filtrado (Q4, de 0 a 4095 * 16).
+ */
+static uint32_t period_ticks(int32_t x_q4) {
+    uint32_t e = (uint32_t)x_q4 * THEREMIN_OCTAVES; // Oitavas acima da base em Q16
+    uint32_t octave = e >> 16;
+    uint32_t index = (e >> 12) & 0xfu;
+    uint32_t weight = e & 0xfffu;
+    uint32_t step = exp2_neg_q16[index] - exp2_neg_q16[index + 1];
+    uint32_t scale = exp2_neg_q16[index] - ((step * weight) >> 12);
+    uint32_t period = (uint32_t)(((uint64_t)(base_period_q8 >> octave) * scale + (1u << 23)) >> 24);
+
+    if (period < 2) period = 2;
+    if (period > 65536) period = 65536;
+    return period;
+}
+
+/**
+ * @brief Publica TOP e CC para a ISR e habilita a IRQ de wrap.
+ *
+ * @param close Os valores fecham o evento de latência aberto em `start_us`.
+ */
+static void publish(uint16_t top, uint16_t level, bool close, uint32_t start_us, uint32_t cross_us) {
+    if (top == published_top && level == published_level && !close) {
+        return;
+    }
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    pending.top = top;
+    pending.level = level;
+    if (close && !pending.close) { // Um evento ainda não escrito fica com os seus instantes
+        pending.close = true;
+        pending.start_us = start_us;
+        pending.cross_us = cross_us;
+    }
+    if (!(pwm_hw->inte & (1u << BUZZER_PWM_SLICE))) {
+        pwm_clear_irq(BUZZER_PWM_SLICE); // A ISR só deve vir depois de um wrap novo
+        pwm_set_irq_enabled(BUZZER_PWM_SLICE, true);
+    }
+    restore_interrupts(irq_state);
+
+    published_top = top;
+    published_level = level;
+}
+
+/**
+ * @brief Leituras para o filtro passar da metade de um degrau.
+ */
+static uint filter_half_samples() {
+    uint32_t remaining = 1u << 16;
+    uint n = 0;
+
+    while (remaining > (1u << 15)) {
+        remaining -= remaining >> THEREMIN_FILTER_SHIFT;
+        n++;
+    }
+    return n;
+}
+
+static void print_report() {
+    uint32_t max_period_us = (uint32_t)(((uint64_t)(base_period_q8 >> 8) * us_per_tick_q16) >> 16);
+    uint n = filter_half_samples();
+
+    printf("\n--- Teremim: latencia movimento -> som (%lu eventos) ---\n", (unsigned long)events);
+    if (events > 0) {
+        printf("total: min %lu us | media %lu us | max %lu us\n", (unsigned long)latency_min_us,
+               (unsigned long)(latency_total_us / events), (unsigned long)latency_max_us);
+        printf("%-24s %10s %10s\n", "estagio", "media_us", "max_us");
+        for (int stage = 0; stage < STAGE_COUNT; stage++) {
+            printf("%-24s %10lu %10lu\n", stage_names[stage],
+                   (unsigned long)(stages[stage].total_us / events), (unsigned long)stages[stage].max_us);
+        }
+    } else {
+        printf("Nenhum movimento medido: mova o eixo X com o botao do joystick pressionado\n");
+    }
+    if (samples > 1) {
+        printf("Leituras: %lu | intervalo medio %lu us | max %lu us\n", (unsigned long)samples,
+               (unsigned long)(interval_total_us / (samples - 1)), (unsigned long)interval_max_us);
+        printf("Limite: %u leituras (%lu us) + 2 periodos de %d Hz (%lu us) = %lu us\n", n,
+               (unsigned long)(n * interval_max_us), THEREMIN_LOW_HZ, (unsigned long)(2 * max_period_us),
+               (unsigned long)(n * interval_max_us + 2 * max_period_us));
+    }
+    printf("Escritas cruzando um wrap: %lu\n", (unsigned long)straddled);
+}
+
+/**
+ * @brief Tarefa do modo: lê o joystick, filtra e publica o período e o nível.
+ */
+static void theremin_run() {
+    if (!active) {
+        return;
+    }
+
+    uint32_t now = time_us_32();
+    if (samples > 0) {
+        uint32_t interval = now - last_sample_us;
+        interval_total_us += interval;
+        if (interval > interval_max_us) interval_max_us = interval;
+    }
+    last_sample_us = now;
+    samples++;
+
+    joystick_state_t js = joystickPi_read();
+
+    // Botão: muda depois de leituras iguais seguidas
+    if (js.button != gate) {
+        if (++gate_count >= THEREMIN_GATE_DEBOUNCE_MS / THEREMIN_PERIOD_MS) {
+            gate = js.button;
+            gate_count = 0;
+            event_open = false; // Não há som a medir através do silêncio
+            ref_x = js.x;
+        }
+    } else {
+        gate_count = 0;
+    }
+
+    // Filtro
+    if (!primed) {
+        filtered_q4 = (int32_t)js.x << 4;
+        ref_x = js.x;
+        primed = true;
+    } else {
+        filtered_q4 += (((int32_t)js.x << 4) - filtered_q4) >> THEREMIN_FILTER_SHIFT;
+    }
+
+    uint32_t period = period_ticks(filtered_q4);
+    freq_hz = tick_hz / period;
+
+    // Latência: abre no movimento, fecha quando o filtro passa da metade do degrau
+    bool close = false;
+    if (gate && !event_open && abs((int)js.x - (int)ref_x) > THEREMIN_MOTION_THRESHOLD) {
+        event_open = true;
+        event_start_us = now;
+        target_x = js.x;
+    }
+    if (event_open) {
+        int32_t half_q4 = ((int32_t)target_x - (int32_t)ref_x) * 8;
+        int32_t moved_q4 = filtered_q4 - ((int32_t)ref_x << 4);
+        if (half_q4 > 0 ? moved_q4 >= half_q4 : moved_q4 <= half_q4) {
+            close = true;
+            event_open = false;
+            ref_x = js.x;
+        }
+    }
+
+    publish((uint16_t)(period - 1), gate ? (uint16_t)(period / 2) : 0, close, event_start_us, now);
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Prepara o temporizador e a ISR de wrap e registra a tarefa do modo. Requer
+ * `timer_wheel_init()`.
+ */
+void theremin_init() {
+    timer_wheel_timer_init(&tick_timer, tick_timer_callback, NULL);
+    irq_set_exclusive_handler(PWM_IRQ_WRAP, wrap_irq_handler);
+    irq_set_enabled(PWM_IRQ_WRAP, true); // Cada slice só interrompe com a sua IRQ habilitada
+    scheduler_task_init(&theremin_task, "theremin", theremin_run, 0, 0); // Áudio, como o reprodutor
+    scheduler_add(&theremin_task);
+}
+
+/**
+ * @brief Entra no modo. O buzzer deve estar livre (reprodutor, looper e jogos parados).
+ */
+void theremin_start() {
+    if (active) {
+        return;
+    }
+
+    tick_hz = clock_get_hz(clk_sys) / CLK_DIV_DEFAULT_REG * 16;
+    us_per_tick_q16 = (uint32_t)((1000000ull << 16) / tick_hz);
+    base_period_q8 = (uint32_t)(((uint64_t)tick_hz << 8) / THEREMIN_LOW_HZ);
+
+    primed = false;
+    gate = false;
+    gate_count = 0;
+    event_open = false;
+    freq_hz = 0;
+    pending.close = false;
+    events = 0;
+    latency_total_us = 0;
+    latency_min_us = UINT32_MAX;
+    latency_max_us = 0;
+    for (int stage = 0; stage < STAGE_COUNT; stage++) {
+        stages[stage].total_us = 0;
+        stages[stage].max_us = 0;
+    }
+    straddled = 0;
+    samples = 0;
+    interval_total_us = 0;
+    interval_max_us = 0;
+
+    // Slice rodando em silêncio: a IRQ de wrap só existe com o contador ligado
+    start_tone(BUZZER_PIN, THEREMIN_LOW_HZ);
+    stop_tone(BUZZER_PIN);
+    published_top = pwm_hw->slice[BUZZER_PWM_SLICE].top;
+    published_level = 0;
+
+    active = true;
+    timer_wheel_start(&tick_timer, THEREMIN_PERIOD_MS);
+    printf("\nTeremim: segure o botao do joystick para tocar; o eixo X muda a altura ('T' sai)\n");
+}
+
+/**
+ * @brief Sai do modo, silencia o buzzer e imprime o relatório de latência.
+ */
+void theremin_stop() {
+    if (!active) {
+        return;
+    }
+
+    active = false;
+    timer_wheel_cancel(&tick_timer);
+    uint32_t irq_state = save_and_disable_interrupts();
+    pwm_set_irq_enabled(BUZZER_PWM_SLICE, false);
+    pending.close = false;
+    restore_interrupts(irq_state);
+    stop_tone(BUZZER_PIN);
+    freq_hz = 0;
+    print_report();
+}
+
+/**
+ * @brief Indica se o modo está ativo (o buzzer e o joystick pertencem a ele).
+ */
+bool theremin_active() {
+    return active;
+}
+
+/**
+ * @brief Frequência atual do tom, em Hz (0 com o som desligado).
+ */
+uint32_t theremin_freq_hz() {
+    return active && gate ? freq_hz : 0;
+}
@@ -0,0 +1,336 @@
+#include "inc/timer_wheel.h"
+#include "inc/irq_priority.h"
+#include "inc/genius_config.h"
+#include "hardware/timer.h"
+#include "hardware/sync.h"
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file timer_wheel.c
+ * @brief Implementação da roda de temporização hierárquica
+ *
+ * Este arquivo implementa as funções declaradas em `timer_wheel.h`. `wheel_tick` é o último tick
+ * já processado; as posições de cada nível são calculadas a partir do tick de expiração e um
+ * mapa de bits por nível indica as posições ocupadas, o que permite encontrar o próximo evento
+ * sem percorrer posições vazias.
+ *
+ * Todas as alterações da roda acontecem com as interrupções desabilitadas (seções curtas e de
+ * tamanho constante); os callbacks são chamados com as interrupções habilitadas.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define TW_LEVELS 4
+#define TW_BITS 6
+#define TW_SLOTS (1u << TW_BITS)
+#define TW_MASK (TW_SLOTS - 1)
+#define TW_MAX_DELAY ((1u << (TW_BITS * TW_LEVELS)) - 1) // ~4,7 horas
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static timer_wheel_timer_t *wheel[TW_LEVELS][TW_SLOTS];
+static uint64_t occupied[TW_LEVELS];    // Bit n = posição n do nível não vazia
+static uint32_t wheel_tick;             // Último tick processado
+static uint32_t active_count;           // Temporizadores armados
+static int alarm_num = -1;              // Alarme de hardware reservado
+static uint32_t wakeups;                // Execuções da interrupção do alarme
+static uint32_t expirations;            // Callbacks executados
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Tick atual em milissegundos (aritmética modular de 32 bits).
+ */
+static inline uint32_t current_tick() {
+    return (uint32_t)(time_us_64() / 1000);
+}
+
+/**
+ * @brief Insere um temporizador na posição correspondente ao seu prazo. Chamar com IRQs desabilitadas.
+ *
+ * Um prazo igual a `wheel_tick` só ocorre na cascata, antes de a posição atual ser processada;
+ * prazos além do alcance da roda ficam na última posição alcançável e são reposicionados nas
+ * cascatas seguintes.
+ */
+static void link_timer(timer_wheel_timer_t *t) {
+    uint32_t expires = t->expires;
+
+    if ((int32_t)(expires - wheel_tick) < 0) {
+        expires = wheel_tick;
+    }
+    uint32_t delta = expires - wheel_tick;
+    if (delta > TW_MAX_DELAY) {
+        delta = TW_MAX_DELAY;
+        expires = wheel_tick + TW_MAX_DELAY;
+    }
+
+    uint level = 0;
+    while (level < TW_LEVELS - 1 && delta >= (1u << (TW_BITS * (level + 1)))) {
+        level++;
+    }
+    uint slot = (expires >> (TW_BITS * level)) & TW_MASK;
+
+    t->level = level;
+    t->slot = slot;
+    t->prev = NULL;
+    t->next = wheel[level][slot];
+    if (t->next) {
+        t->next->prev = t;
+    }
+    wheel[level][slot] = t;
+    occupied[level] |= 1ull << slot;
+}
+
+/**
+ * @brief Remove um temporizador da sua posição. Chamar com IRQs desabilitadas.
+ */
+static void unlink_timer(timer_wheel_timer_t *t) {
+    if (t->prev) {
+        t->prev->next = t->next;
+    } else {
+        wheel[t->level][t->slot] = t->next;
+        if (t->next == NULL) {
+            occupied[t->level] &= ~(1ull << t->slot);
+        }
+    }
+    if (t->next) {
+        t->next->prev = t->prev;
+    }
+    t->next = t->prev = NULL;
+}
+
+/**
+ * @brief Calcula o próximo tick em que há algo a fazer. Chamar com IRQs desabilitadas.
+ *
+ * Para o nível 0 é o tick da próxima posição ocupada; para os níveis superiores é o tick em que a
+ * próxima posição ocupada desce em cascata.
+ *
+ * @param next Recebe o tick do próximo evento.
+ * @return false se a roda estiver vazia.
+ */
+static bool next_event_tick(uint32_t *next) {
+    bool found = false;
+
+    for (uint level = 0; level < TW_LEVELS; level++) {
+        uint64_t occ = occupied[level];
+        if (occ == 0) {
+            continue;
+        }
+
+        uint shift = TW_BITS * level;
+        uint32_t base = wheel_tick >> shift;
+        uint r = (base + 1) & TW_MASK;
+        uint64_t rotated = (occ >> r) | (occ << ((TW_SLOTS - r) & TW_MASK)); // Bit 0 = posição seguinte
+        uint32_t candidate = (base + __builtin_ctzll(rotated) + 1) << shift;
+
+        if (!found || (int32_t)(candidate - wheel_tick) < (int32_t)(*next - wheel_tick)) {
+            *next = candidate;
+            found = true;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Desce para os níveis inferiores os temporizadores da posição atual de cada nível superior.
+ */
+static void cascade() {
+    for (uint level = 1; level < TW_LEVELS; level++) {
+        uint slot = (wheel_tick >> (TW_BITS * level)) & TW_MASK;
+        timer_wheel_timer_t *t = wheel[level][slot];
+
+        wheel[level][slot] = NULL;
+        occupied[level] &= ~(1ull << slot);
+        while (t) {
+            timer_wheel_timer_t *next = t->next;
+            link_timer(t);
+            t = next;
+        }
+
+        if (slot != 0) {
+            break; // Só o nível cujo índice voltou a 0 propaga a cascata
+        }
+    }
+}
+
+/**
+ * @brief Processa todos os eventos até o tick `target`, executando os callbacks vencidos.
+ */
+static void __not_in_flash_func(advance)(uint32_t target) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    uint32_t next;
+
+    while (next_event_tick(&next) && (int32_t)(target - next) >= 0) {
+        wheel_tick = next;
+        if ((wheel_tick & TW_MASK) == 0) {
+            cascade();
+        }
+
+        uint slot = wheel_tick & TW_MASK;
+        timer_wheel_timer_t *t;
+        while ((t = wheel[0][slot]) != NULL) {
+            unlink_timer(t);
+            t->pending = false;
+            active_count--;
+            expirations++;
+
+            restore_interrupts(irq_state);
+            t->callback(t); // Pode rearmar ou cancelar qualquer temporizador
+            irq_state = save_and_disable_interrupts();
+        }
+    }
+    wheel_tick = target;
+
+    restore_interrupts(irq_state);
+}
+
+/**
+ * @brief Programa o alarme para o próximo evento, ou o desliga se a roda estiver vazia.
+ *
+ * @return true se o instante programado já passou e a roda precisa ser processada de novo.
+ */
+static bool program_alarm() {
+    uint32_t irq_state = save_and_disable_interrupts();
+    uint32_t next;
+    bool missed = false;
+
+    if (next_event_tick(&next)) {
+        uint64_t now_ms = time_us_64() / 1000;
+        int32_t ahead = (int32_t)(next - (uint32_t)now_ms);
+        uint64_t target_ms = ahead > 0 ? now_ms + ahead : now_ms;
+        missed = hardware_alarm_set_target(alarm_num, from_us_since_boot(target_ms * 1000));
+    } else {
+        hardware_alarm_cancel(alarm_num);
+    }
+
+    restore_interrupts(irq_state);
+    return missed;
+}
+
+/**
+ * @brief Interrupção do alarme: processa a roda até o tick atual e reprograma o alarme.
+ */
+static void __not_in_flash_func(alarm_callback)(uint alarm) {
+    (void)alarm;
+    wakeups++;
+    do {
+        advance(current_tick());
+    } while (program_alarm());
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Inicializa a roda e reserva um alarme de hardware livre.
+ */
+void timer_wheel_init() {
+    wheel_tick = current_tick();
+    alarm_num = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(alarm_num, alarm_callback);
+    irq_set_priority(TIMER_IRQ_0 + alarm_num, IRQ_PRIORITY_TIMING);
+}
+
+/**
+ * @brief Prepara um temporizador para uso.
+ *
+ * @param timer Temporizador a inicializar.
+ * @param callback Função chamada na expiração.
+ * @param user_data Dado livre disponível no callback.
+ */
+void timer_wheel_timer_init(timer_wheel_timer_t *timer, timer_wheel_callback_t callback, void *user_data) {
+    *timer = (timer_wheel_timer_t){ .callback = callback, .user_data = user_data };
+}
+
+/**
+ * @brief Arma (ou rearma) um temporizador para expirar após `delay_ms`.
+ *
+ * O alarme só é reprogramado quando o novo prazo antecede o próximo evento já programado.
+ *
+ * @param timer Temporizador.
+ * @param delay_ms Atraso em milissegundos.
+ */
+void GENIUS_HOT_FUNC(timer_wheel_start)(timer_wheel_timer_t *timer, uint32_t delay_ms) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    uint32_t before;
+    bool had_event = next_event_tick(&before);
+
+    if (timer->pending) {
+        unlink_timer(timer);
+        active_count--;
+    }
+    if (active_count == 0) {
+        wheel_tick = current_tick(); // Roda ociosa: ressincroniza sem percorrer o intervalo parado
+    }
+
+    timer->expires = current_tick() + (delay_ms ? delay_ms : 1);
+    timer->pending = true;
+    active_count++;
+    link_timer(timer);
+
+    uint32_t after;
+    next_event_tick(&after);
+    bool reprogram = !had_event || (int32_t)(after - before) < 0;
+    restore_interrupts(irq_state);
+
+    if (reprogram && program_alarm()) {
+        hardware_alarm_force_irq(alarm_num); // Prazo já vencido: processa na interrupção
+    }
+}
+
+/**
+ * @brief Desarma um temporizador. Não faz nada se ele não estiver armado.
+ *
+ * O alarme não é reprogramado: se ele disparar sem eventos vencidos, apenas agenda o próximo.
+ *
+ * @param timer Temporizador.
+ */
+void GENIUS_HOT_FUNC(timer_wheel_cancel)(timer_wheel_timer_t *timer) {
+    uint32_t irq_state = save_and_disable_interrupts();
+
+    if (timer->pending) {
+        unlink_timer(timer);
+        timer->pending = false;
+        active_count--;
+    }
+
+    restore_interrupts(irq_state);
+}
+
+/**
+ * @brief Obtém o tick atual (milissegundos desde a partida do temporizador).
+ *
+ * @return Tick atual.
+ */
+uint32_t timer_wheel_now() {
+    return current_tick();
+}
+
+/**
+ * @brief Obtém os contadores da roda.
+ *
+ * @return Temporizadores ativos, despertares do alarme e expirações.
+ */
+timer_wheel_stats_t timer_wheel_stats() {
+    return (timer_wheel_stats_t){ .active = active_count, .wakeups = wakeups, .expirations = expirations };
+}
+
+/**
+ * @brief Imprime temporizadores ativos, despertares do alarme e expirações.
+ */
+void timer_wheel_report() {
+    printf("\n--- Roda de temporizadores ---\n");
+    printf("ativos %lu | despertares %lu | expiracoes %lu | alarme %d\n",
+           (unsigned long)active_count, (unsigned long)wakeups, (unsigned long)expirations, alarm_num);
+}
@@ -0,0 +1,182 @@
+#include "inc/tone_selftest.h"
+#include "inc/BuzzerPi.h"
+#include "inc/board.h"
+#include "hardware/clocks.h"
+#include "hardware/pwm.h"
+#include "hardware/sync.h"
+#include <math.h>
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file tone_selftest.c
+ * @brief Implementação do autoteste de frequência declarado em `tone_selftest.h`
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define COUNT_SLICE BOARD_PWM_SLICE(FREQ_COUNT_PIN)
+#define MAX_EDGES 30000 // Diferenças do contador de 16 bits tratadas como int16_t
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Espera o contador de bordas alcançar `target` e registra o instante exato.
+ *
+ * A aproximação é feita com as interrupções habilitadas; apenas a última borda é aguardada com
+ * elas desabilitadas, para que nenhuma ISR atrase o registro do instante.
+ *
+ * @param target Valor do contador (módulo 2^16) a aguardar.
+ * @param stamp Recebe o instante da borda em microssegundos.
+ * @return false se nenhuma borda chegar em `TONE_SELFTEST_TIMEOUT_MS`.
+ */
+static bool wait_count(uint16_t target, uint64_t *stamp) {
+    uint64_t deadline = time_us_64() + TONE_SELFTEST_TIMEOUT_MS * 1000u;
+    uint16_t last = pwm_get_counter(COUNT_SLICE);
+
+    while ((int16_t)(pwm_get_counter(COUNT_SLICE) - (uint16_t)(target - 1)) < 0) {
+        uint16_t now = pwm_get_counter(COUNT_SLICE);
+        if (now != last) {
+            last = now;
+            deadline = time_us_64() + TONE_SELFTEST_TIMEOUT_MS * 1000u; // Ainda há sinal
+        } else if (time_us_64() > deadline) {
+            return false;
+        }
+    }
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    while ((int16_t)(pwm_get_counter(COUNT_SLICE) - target) < 0) {
+        if (time_us_64() > deadline) {
+            restore_interrupts(irq_state);
+            return false;
+        }
+    }
+    *stamp = time_us_64();
+    restore_interrupts(irq_state);
+    return true;
+}
+
+/**
+ * @brief Configura o slice do contador para contar bordas de subida no canal B.
+ *
+ * @param enable true para iniciar a contagem, false para liberar o slice e o pino.
+ */
+static void counter_enable(bool enable) {
+    if (enable) {
+        pwm_config config = pwm_get_default_config();
+        pwm_config_set_clkdiv_mode(&config, PWM_DIV_B_RISING);
+        pwm_config_set_clkdiv(&config, 1.0f);
+        pwm_init(COUNT_SLICE, &config, false);
+        gpio_set_function(FREQ_COUNT_PIN, GPIO_FUNC_PWM);
+        pwm_set_enabled(COUNT_SLICE, true);
+    } else {
+        pwm_set_enabled(COUNT_SLICE, false);
+        gpio_init(FREQ_COUNT_PIN); // Volta a ser entrada comum
+    }
+}
+
+/**
+ * @brief Imprime um erro em cents com duas casas decimais e sinal.
+ */
+static void print_cents(float cents) {
+    long hundredths = lroundf(cents * 100.0f);
+    unsigned long magnitude = hundredths < 0 ? -hundredths : hundredths;
+
+    printf(" %c%3lu.%02lu", hundredths < 0 ? '-' : '+', magnitude / 100, magnitude % 100);
+}
+
+/**
+ * @brief Erro em cents entre duas frequências em mHz.
+ */
+static float cents_between(uint64_t actual_mhz, uint64_t target_mhz) {
+    return 1200.0f * log2f((float)actual_mhz / (float)target_mhz);
+}
+
+/**
+ * @brief Mede uma nota e imprime sua linha.
+ *
+ * @param freq Frequência pedida em Hz.
+ * @param worst Maior erro medido até aqui, em cents (atualizado).
+ * @return false se nenhuma borda foi contada.
+ */
+static bool measure_note(uint32_t freq, float *worst) {
+    uint16_t wrap = calculate_wrap(freq, CLK_DIV_DEFAULT);
+    uint64_t target_mhz = (uint64_t)freq * 1000u;
+    uint64_t ideal_mhz = (uint64_t)clock_get_hz(clk_sys) * 16u * 1000u / (CLK_DIV_DEFAULT_REG * (wrap + 1u));
+    uint32_t edges = freq * TONE_SELFTEST_GATE_MS / 1000u;
+    uint64_t start, end;
+
+    edges = edges < 1 ? 1 : (edges > MAX_EDGES ? MAX_EDGES : edges);
+
+    start_tone(BUZZER_PIN, freq);
+    sleep_ms(TONE_SELFTEST_SETTLE_MS);
+
+    uint16_t first = pwm_get_counter(COUNT_SLICE) + 1;
+    bool ok = wait_count(first, &start) && wait_count(first + edges, &end);
+    stop_tone(BUZZER_PIN);
+
+    printf("%6lu %6u %7lu.%03lu", (unsigned long)freq, wrap,
+           (unsigned long)(ideal_mhz / 1000), (unsigned long)(ideal_mhz % 1000));
+    print_cents(cents_between(ideal_mhz, target_mhz));
+    if (!ok) {
+        printf("  sem sinal\n");
+        return false;
+    }
+
+    uint64_t measured_mhz = (uint64_t)edges * 1000000000u / (end - start);
+    float cents = cents_between(measured_mhz, target_mhz);
+    printf(" %7lu.%03lu", (unsigned long)(measured_mhz / 1000), (unsigned long)(measured_mhz % 1000));
+    print_cents(cents);
+    printf("\n");
+
+    if (fabsf(cents) > fabsf(*worst)) {
+        *worst = cents;
+    }
+    return true;
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Mede cada frequência da tabela no buzzer e imprime o erro em cents.
+ *
+ * @param freqs Frequências das notas em Hz (valores 0 são ignorados).
+ * @param count Número de frequências.
+ */
+void tone_selftest_run(const uint32_t *freqs, uint count) {
+    float worst = 0.0f;
+    uint measured = 0;
+
+    counter_enable(true);
+
+    printf("\n--- Autoteste de frequencia (janela de %d ms) ---\n", TONE_SELFTEST_GATE_MS);
+    printf("%6s %6s %11s %7s %11s %7s\n", "nota", "wrap", "teorica_hz", "cents", "medida_hz", "cents");
+    for (uint i = 0; i < count; i++) {
+        if (freqs[i] == 0) {
+            continue;
+        }
+        if (!measure_note(freqs[i], &worst)) {
+            printf("Nenhuma borda no pino %d: ligue-o ao pino %d (buzzer) com um fio\n",
+                   FREQ_COUNT_PIN, BUZZER_PIN);
+            break;
+        }
+        measured++;
+    }
+
+    counter_enable(false);
+
+    if (measured > 0) {
+        printf("%u notas, maior erro medido:", measured);
+        print_cents(worst);
+        printf(" cents\n");
+    }
+}
@@ -0,0 +1,312 @@
+#include "inc/tuner.h"
+#include "inc/JoystickPi.h"
+#include "inc/board.h"
+#include "inc/genius_config.h"
+#include "inc/mem_layout.h"
+#include "inc/scheduler.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/structs/systick.h"
+#include "hardware/sync.h"
+#include <stdio.h>
+#include <string.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file tuner.c
+ * @brief Implementação do afinador declarado em `tuner.h`
+ *
+ * A ISR só rearma o canal que terminou e conta o bloco; a tarefa copia as amostras do bloco
+ * pronto antes de qualquer cálculo, então o tempo em que o bloco precisa ficar intacto é só o da
+ * cópia, e o detector pode usar quase todo o orçamento.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define ADC_MASK ((1u << JOYSTICK_X_ADC) | (1u << JOYSTICK_Y_ADC) | (1u << MIC_ADC))
+#define BLOCK_WORDS (TUNER_CHANNELS * TUNER_HOP)
+#define SYSTICK_MAX 0xFFFFFFu
+
+static_assert(JOYSTICK_X_ADC != MIC_ADC && JOYSTICK_Y_ADC != MIC_ADC, "microfone no canal de um eixo");
+static_assert(TUNER_JOYSTICK_AVG <= TUNER_HOP, "TUNER_JOYSTICK_AVG maior que o bloco");
+static_assert(TUNER_HOP <= PITCH_FRAME, "TUNER_HOP maior que o quadro do detector");
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static uint16_t GENIUS_DMA_DATA("tuner") blocks[2][BLOCK_WORDS];
+static uint16_t GENIUS_AUDIO_DATA("tuner") frame[PITCH_FRAME];
+static uint frame_fill;                 // Amostras válidas no fim de `frame`
+
+static volatile bool active;
+static scheduler_task_t tuner_task;
+static int dma_chan[2];
+
+// ISR -> tarefa
+static volatile uint32_t block_seq;     // Blocos completados pela DMA
+static volatile uint ready;             // Último bloco completado
+
+static uint32_t handled_seq;
+static pitch_result_t result;
+
+// Estatísticas (tarefa; lidas com o afinador parado)
+static uint32_t budget_cycles;
+static uint32_t blocks_done;
+static uint32_t blocks_lost;
+static uint32_t voiced_blocks;
+static uint64_t cycles_total;
+static uint32_t cycles_min, cycles_max;
+static uint32_t saved_csr, saved_rvr;
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Posição de um canal na alternância do ADC (ordem crescente a partir do primeiro).
+ */
+static inline uint slot(uint channel) {
+    return (uint)__builtin_popcount(ADC_MASK & ((1u << channel) - 1));
+}
+
+/**
+ * @brief ISR da DMA: rearma o canal que completou o seu bloco e sinaliza a tarefa.
+ */
+static void GENIUS_HOT_FUNC(dma_irq_handler)() {
+    for (uint i = 0; i < 2; i++) {
+        uint32_t mask = 1u << dma_chan[i];
+        if (!(dma_hw->ints0 & mask)) {
+            continue;
+        }
+        dma_hw->ints0 = mask;
+        // O outro canal já está escrevendo; este recomeça do início quando for encadeado
+        dma_channel_set_write_addr(dma_chan[i], blocks[i], false);
+        ready = i;
+        block_seq++;
+        scheduler_signal(&tuner_task);
+    }
+}
+
+/**
+ * @brief Configura um canal para encher o seu bloco e encadear o outro.
+ */
+static void configure_channel(uint i, bool start) {
+    dma_channel_config cfg = dma_channel_get_default_config(dma_chan[i]);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_dreq(&cfg, DREQ_ADC);
+    channel_config_set_chain_to(&cfg, dma_chan[i ^ 1]);
+    dma_channel_configure(dma_chan[i], &cfg, blocks[i], &adc_hw->fifo, BLOCK_WORDS, start);
+}
+
+/**
+ * @brief Copia o bloco pronto: microfone para o quadro, média dos eixos para o joystick.
+ */
+static void consume_block(const uint16_t *block) {
+    const uint mic = slot(MIC_ADC), x = slot(JOYSTICK_X_ADC), y = slot(JOYSTICK_Y_ADC);
+
+    memmove(frame, frame + TUNER_HOP, (PITCH_FRAME - TUNER_HOP) * sizeof(frame[0]));
+    uint16_t *dst = frame + PITCH_FRAME - TUNER_HOP;
+    for (uint i = 0; i < TUNER_HOP; i++) {
+        dst[i] = block[TUNER_CHANNELS * i + mic];
+    }
+    frame_fill = frame_fill + TUNER_HOP < PITCH_FRAME ? frame_fill + TUNER_HOP : PITCH_FRAME;
+
+    uint32_t sum_x = 0, sum_y = 0;
+    for (uint i = TUNER_HOP - TUNER_JOYSTICK_AVG; i < TUNER_HOP; i++) {
+        sum_x += block[TUNER_CHANNELS * i + x];
+        sum_y += block[TUNER_CHANNELS * i + y];
+    }
+    joystickPi_stream_push((uint16_t)(sum_x / TUNER_JOYSTICK_AVG), (uint16_t)(sum_y / TUNER_JOYSTICK_AVG));
+}
+
+/**
+ * @brief Imprime um número de ciclos e a sua fração do orçamento (uma casa decimal).
+ */
+static void print_cycles(const char *label, uint32_t cycles) {
+    uint32_t permille = (uint32_t)((uint64_t)cycles * 1000 / budget_cycles);
+    printf("%-6s %10lu ciclos  %3lu.%lu%%\n", label, (unsigned long)cycles, (unsigned long)(permille / 10),
+           (unsigned long)(permille % 10));
+}
+
+static void print_report() {
+    printf("\n--- Afinador: %lu blocos de %d amostras a %d Hz (%lu perdidos, %lu com nota) ---\n",
+           (unsigned long)blocks_done, TUNER_HOP, PITCH_SAMPLE_RATE_HZ, (unsigned long)blocks_lost,
+           (unsigned long)voiced_blocks);
+    printf("Orcamento por bloco: %lu ciclos (%d ms)\n", (unsigned long)budget_cycles,
+           TUNER_HOP * 1000 / PITCH_SAMPLE_RATE_HZ);
+    if (blocks_done > 0) {
+        print_cycles("min", cycles_min);
+        print_cycles("media", (uint32_t)(cycles_total / blocks_done));
+        print_cycles("max", cycles_max);
+    }
+}
+
+/**
+ * @brief Tarefa do afinador: processa o bloco mais recente e mede o custo em ciclos.
+ */
+static void tuner_run() {
+    if (!active) {
+        return;
+    }
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    uint32_t seq = block_seq;
+    uint index = ready;
+    restore_interrupts(irq_state);
+    if (seq == handled_seq) {
+        return;
+    }
+    if (seq - handled_seq > 1) {
+        blocks_lost += seq - handled_seq - 1;
+        frame_fill = 0; // Quadro com um buraco: recomeça
+    }
+    handled_seq = seq;
+
+    uint32_t start = systick_hw->cvr;
+
+    consume_block(blocks[index]);
+    if (frame_fill == PITCH_FRAME) {
+        pitch_detect(frame, &result);
+    } else {
+        result = (pitch_result_t){ 0 };
+    }
+
+    uint32_t cycles = (start - systick_hw->cvr) & SYSTICK_MAX; // Contador decrescente
+    blocks_done++;
+    cycles_total += cycles;
+    if (cycles < cycles_min) cycles_min = cycles;
+    if (cycles > cycles_max) cycles_max = cycles;
+    if (result.voiced) {
+        voiced_blocks++;
+    }
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Prepara o pino do microfone, os canais de DMA e a ISR e registra a tarefa do afinador.
+ */
+void tuner_init() {
+    adc_gpio_init(MIC_PIN);
+    dma_chan[0] = dma_claim_unused_channel(true);
+    dma_chan[1] = dma_claim_unused_channel(true);
+    irq_add_shared_handler(DMA_IRQ_0, dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true); // Cada canal só interrompe com a sua IRQ habilitada
+    scheduler_task_init(&tuner_task, "tuner", tuner_run, 2, 0); // Prazo de 16 ms por bloco
+    scheduler_add(&tuner_task);
+}
+
+/**
+ * @brief Liga a captura, se o ADC estiver livre (`joystickPi_adc_claim()`).
+ */
+void tuner_start() {
+    if (active) {
+        return;
+    }
+    if (!joystickPi_adc_claim("afinador")) {
+        printf("\nAfinador: ADC ocupado (%s)\n", joystickPi_adc_owner());
+        return;
+    }
+
+    budget_cycles = (uint32_t)((uint64_t)clock_get_hz(clk_sys) * TUNER_HOP / PITCH_SAMPLE_RATE_HZ);
+    frame_fill = 0;
+    result = (pitch_result_t){ 0 };
+    block_seq = 0;
+    handled_seq = 0;
+    blocks_done = 0;
+    blocks_lost = 0;
+    voiced_blocks = 0;
+    cycles_total = 0;
+    cycles_min = UINT32_MAX;
+    cycles_max = 0;
+
+    // SysTick contando ciclos do processador, como em `irq_latency_measure()`
+    saved_csr = systick_hw->csr;
+    saved_rvr = systick_hw->rvr;
+    systick_hw->csr = 0;
+    systick_hw->rvr = SYSTICK_MAX;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5; // ENABLE | CLKSOURCE (clock do processador)
+
+    joystickPi_stream_begin(); // O joystick passa a ler as conversões de cada bloco
+
+    // ADC em conversão contínua, alternando entre os três canais, com a FIFO alimentando a DMA
+    adc_set_round_robin(ADC_MASK);
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv((float)clock_get_hz(clk_adc) / (TUNER_CHANNELS * PITCH_SAMPLE_RATE_HZ) - 1);
+    adc_select_input(__builtin_ctz(ADC_MASK)); // A alternância começa pelo primeiro canal
+    adc_fifo_drain();
+
+    configure_channel(1, false);
+    configure_channel(0, true);
+    dma_hw->ints0 = (1u << dma_chan[0]) | (1u << dma_chan[1]);
+    dma_channel_set_irq0_enabled(dma_chan[0], true);
+    dma_channel_set_irq0_enabled(dma_chan[1], true);
+
+    active = true;
+    adc_run(true);
+    printf("\nAfinador: toque ou cante perto do microfone ('M' sai)\n");
+}
+
+/**
+ * @brief Desliga a captura, devolve o ADC ao joystick e imprime o relatório de ciclos por bloco.
+ */
+void tuner_stop() {
+    if (!active) {
+        return;
+    }
+
+    active = false;
+    adc_run(false); // Sem DREQ os canais param onde estão
+
+    for (uint i = 0; i < 2; i++) {
+        dma_channel_set_irq0_enabled(dma_chan[i], false);
+        // Desabilita o canal (EN) antes de abortar os dois: um canal abortado ainda pode disparar o
+        // encadeado, que assim não volta a rodar (errata RP2040-E13)
+        hw_clear_bits(&dma_hw->ch[dma_chan[i]].al1_ctrl, DMA_CH0_CTRL_TRIG_EN_BITS);
+    }
+    for (uint i = 0; i < 2; i++) {
+        dma_channel_abort(dma_chan[i]);
+    }
+    dma_hw->ints0 = (1u << dma_chan[0]) | (1u << dma_chan[1]);
+
+    // Devolve o ADC às leituras avulsas de JoystickPi
+    adc_set_round_robin(0);
+    adc_fifo_setup(false, false, 0, false, false);
+    adc_fifo_drain();
+    joystickPi_stream_end();
+    joystickPi_adc_release();
+
+    systick_hw->csr = 0;
+    systick_hw->rvr = saved_rvr;
+    systick_hw->csr = saved_csr;
+
+    result = (pitch_result_t){ 0 };
+    print_report();
+}
+
+/**
+ * @brief Indica se o afinador está ativo (o ADC pertence a ele).
+ */
+bool tuner_active() {
+    return active;
+}
+
+/**
+ * @brief Resultado do último quadro analisado.
+ */
+pitch_result_t tuner_result() {
+    return result;
+}
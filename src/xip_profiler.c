@@ -0,0 +1,134 @@
+#include "inc/xip_profiler.h"
+#include "hardware/structs/xip_ctrl.h"
+#include <stdio.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file xip_profiler.c
+ * @brief Implementação da medição da taxa de acerto do cache XIP
+ *
+ * Este arquivo implementa as funções declaradas em `xip_profiler.h`. As funções de marcação
+ * executam a partir da SRAM para que a própria instrumentação não gere acessos ao XIP e não
+ * distorça as medições.
+ */
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+/**
+ * @brief Nomes dos subsistemas, usados no relatório.
+ */
+static const char *section_names[XIP_PROF_COUNT] = {
+    "irq", "input", "sound", "status"
+};
+
+/**
+ * @brief Estatísticas acumuladas de cada subsistema.
+ */
+static xip_prof_stats_t stats[XIP_PROF_COUNT];
+
+/**
+ * @brief Valores dos contadores no início de cada subsistema.
+ */
+static uint32_t start_hit[XIP_PROF_COUNT];
+static uint32_t start_acc[XIP_PROF_COUNT];
+static uint32_t start_us[XIP_PROF_COUNT];
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Zera os contadores de hardware e as estatísticas acumuladas.
+ *
+ * Qualquer escrita em CTR_HIT ou CTR_ACC zera o contador correspondente.
+ */
+void xip_profiler_init() {
+    xip_ctrl_hw->ctr_hit = 0; // Zera o contador de acertos
+    xip_ctrl_hw->ctr_acc = 0; // Zera o contador de acessos
+
+    for (int i = 0; i < XIP_PROF_COUNT; i++) {
+        stats[i] = (xip_prof_stats_t){0};
+    }
+}
+
+/**
+ * @brief Marca o início da execução de um subsistema.
+ *
+ * @param section Subsistema instrumentado.
+ */
+void __not_in_flash_func(xip_profiler_begin)(xip_prof_section_t section) {
+    start_hit[section] = xip_ctrl_hw->ctr_hit;
+    start_acc[section] = xip_ctrl_hw->ctr_acc;
+    start_us[section] = time_us_32();
+}
+
+/**
+ * @brief Marca o fim da execução de um subsistema e acumula as diferenças dos contadores.
+ *
+ * @param section Subsistema instrumentado.
+ */
+void __not_in_flash_func(xip_profiler_end)(xip_prof_section_t section) {
+    uint32_t elapsed = time_us_32() - start_us[section]; // Diferença em aritmética modular (tolera o estouro)
+    xip_prof_stats_t *s = &stats[section];
+
+    s->hits += xip_ctrl_hw->ctr_hit - start_hit[section];
+    s->accesses += xip_ctrl_hw->ctr_acc - start_acc[section];
+    s->total_us += elapsed;
+    if (elapsed > s->max_us) {
+        s->max_us = elapsed;
+    }
+    s->calls++;
+}
+
+/**
+ * @brief Obtém as estatísticas acumuladas de um subsistema.
+ *
+ * @param section Subsistema desejado.
+ * @return Ponteiro para as estatísticas (somente leitura).
+ */
+const xip_prof_stats_t *xip_profiler_get(xip_prof_section_t section) {
+    return &stats[section];
+}
+
+/**
+ * @brief Invalida todo o cache XIP.
+ *
+ * A leitura do registrador FLUSH segura o barramento até a invalidação terminar.
+ */
+void __not_in_flash_func(xip_profiler_flush_cache)() {
+    xip_ctrl_hw->flush = 1;
+    (void)xip_ctrl_hw->flush; // Aguarda a conclusão da invalidação
+}
+
+/**
+ * @brief Imprime o relatório de todos os subsistemas e reinicia as estatísticas.
+ *
+ * Para cada subsistema são exibidos a taxa de acerto, as faltas por chamada e os tempos médio e
+ * máximo. Compare um firmware com `GENIUS_HOT_IN_RAM=0` e outro com `GENIUS_HOT_IN_RAM=1` para
+ * obter a latência antes/depois do posicionamento em SRAM.
+ */
+void xip_profiler_report() {
+    printf("\n--- Perfil do cache XIP (hot_in_ram=%d) ---\n", GENIUS_HOT_IN_RAM);
+    printf("%-7s %8s %10s %10s %7s %9s %8s %8s\n",
+           "secao", "chamadas", "acessos", "acertos", "taxa%", "faltas/ch", "med_us", "max_us");
+
+    for (int i = 0; i < XIP_PROF_COUNT; i++) {
+        const xip_prof_stats_t *s = &stats[i];
+        uint32_t misses = s->accesses - s->hits;
+        uint32_t rate_x10 = s->accesses ? (uint32_t)((uint64_t)s->hits * 1000 / s->accesses) : 1000;
+        uint32_t misses_per_call = s->calls ? misses / s->calls : 0;
+        uint32_t mean_us = s->calls ? (uint32_t)(s->total_us / s->calls) : 0;
+
+        printf("%-7s %8lu %10lu %10lu %5lu.%lu %9lu %8lu %8lu\n",
+               section_names[i], (unsigned long)s->calls, (unsigned long)s->accesses,
+               (unsigned long)s->hits, (unsigned long)(rate_x10 / 10), (unsigned long)(rate_x10 % 10),
+               (unsigned long)misses_per_call, (unsigned long)mean_us, (unsigned long)s->max_us);
+    }
+
+    xip_profiler_init(); // Inicia uma nova janela de medição
+}
@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+"""Uso de memória por módulo a partir do arquivo .map gerado pelo ld.
+
+Lê o GENIUS.elf.map produzido pelo build e soma o tamanho das seções de entrada
+de cada módulo em cinco categorias:
+
+    text    código executado da flash (.text, .boot2, .ARM.*)
+    rodata  constantes na flash (.rodata, .binary_info)
+    data    dados inicializados e funções em RAM (.data: ocupa RAM e flash)
+    bss     dados zerados (.bss, .uninitialized_data)
+    scratch dados nos bancos SCRATCH_X/SCRATCH_Y
+
+Os módulos do projeto aparecem pelo nome do arquivo-fonte; os objetos do
+Pico SDK são agrupados pelo componente (ex.: sdk:pico_stdio) e as bibliotecas
+estáticas pelo nome do arquivo (ex.: libc_nano.a).
+
+Com --ram-budget/--flash-budget o script termina com erro quando o uso total
+ultrapassa o limite, interrompendo o build antes que a placa fique sem memória.
+"""
+
+import argparse
+import re
+import sys
+from collections import defaultdict
+
+CATEGORIES = ("text", "rodata", "data", "bss", "scratch")
+
+# Seção de saída -> categoria
+OUTPUT_SECTIONS = {
+    ".boot2": "text",
+    ".text": "text",
+    ".ARM.extab": "text",
+    ".ARM.exidx": "text",
+    ".rodata": "rodata",
+    ".binary_info": "rodata",
+    ".ram_vector_table": "bss",
+    ".uninitialized_data": "bss",
+    ".data": "data",
+    ".tdata": "data",
+    ".bss": "bss",
+    ".tbss": "bss",
+    ".scratch_x": "scratch",
+    ".scratch_y": "scratch",
+}
+
+# Regiões reservadas pelo script de ligação (não pertencem a um módulo)
+RESERVED_SECTIONS = (".heap", ".stack_dummy", ".stack1_dummy")
+
+OUTPUT_RE = re.compile(r"^(\.[\w.]+)(?:\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+))?")
+INPUT_RE = re.compile(r"^ (\S+)(?:\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(\S.*))?$")
+CONT_RE = re.compile(r"^\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(\S.*)$")
+MEMORY_RE = re.compile(r"^(\w+)\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)")
+
+
+def module_name(path):
+    """Nome curto do módulo dono de uma seção de entrada."""
+    path = path.replace("\\", "/")
+    archive = re.match(r"(?:.*/)?([^/(]+\.a)\(", path)
+    if archive:
+        return archive.group(1)
+    sdk = re.search(r"/(?:pico-sdk|sdk/[\d.]+)/src/(?:[^/]+/)*?((?:pico|hardware|boot|tinyusb)[\w]*)/", path)
+    if sdk:
+        return "sdk:" + sdk.group(1)
+    if "/lib/tinyusb/" in path:
+        return "sdk:tinyusb"
+    name = path.rsplit("/", 1)[-1]
+    return re.sub(r"\.(c|S|s|cpp)?\.?obj$|\.o$", "", name)
+
+
+def parse_map(lines):
+    """Retorna (uso por módulo, reservas, regiões de memória)."""
+    usage = defaultdict(lambda: dict.fromkeys(CATEGORIES, 0))
+    reserved = {}
+    regions = {}
+
+    it = iter(lines)
+    for line in it:
+        if line.startswith("Memory Configuration"):
+            break
+    for line in it:
+        if line.startswith("Linker script and memory map"):
+            break
+        m = MEMORY_RE.match(line)
+        if m and m.group(1) != "Name":
+            regions[m.group(1)] = (int(m.group(2), 16), int(m.group(3), 16))
+
+    category = None
+    pending = None
+    for line in it:
+        line = line.rstrip("\n")
+        if not line:
+            continue
+        if line[0] == ".":
+            m = OUTPUT_RE.match(line)
+            name = m.group(1)
+            category = OUTPUT_SECTIONS.get(name)
+            if name in RESERVED_SECTIONS:
+                size = m.group(3)
+                if size is None:
+                    size_line = next(it, "")
+                    size = size_line.split()[1] if len(size_line.split()) > 1 else "0x0"
+                reserved[name] = int(size, 16)
+            pending = None
+            continue
+        if category is None:
+            continue
+
+        m = INPUT_RE.match(line)
+        if m and m.group(2) is None:
+            pending = m.group(1)  # Nome longo: endereço e tamanho na linha seguinte
+            continue
+        if m:
+            section, size, owner = m.group(1), m.group(3), m.group(4)
+        else:
+            m = CONT_RE.match(line)
+            if not m or pending is None:
+                continue
+            section, size, owner = pending, m.group(2), m.group(3)
+            pending = None
+
+        if section.startswith("*") or section == "COMMON" and not owner:
+            continue
+        owner = owner.strip()
+        if not (owner.endswith("obj") or owner.endswith(".o") or owner.endswith(")")):
+            continue  # Linha de símbolo, não de seção
+        usage[module_name(owner)][category] += int(size, 16)
+
+    return usage, reserved, regions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("map", help="arquivo .map gerado pelo ld")
+    parser.add_argument("-o", "--out", help="grava o relatório neste arquivo")
+    parser.add_argument("--ram-budget", type=int, default=0,
+                        help="falha se o uso de RAM (bytes) ultrapassar este valor")
+    parser.add_argument("--flash-budget", type=int, default=0,
+                        help="falha se o uso de flash (bytes) ultrapassar este valor")
+    args = parser.parse_args()
+
+    with open(args.map, encoding="utf-8", errors="replace") as f:
+        usage, reserved, regions = parse_map(f)
+
+    totals = dict.fromkeys(CATEGORIES, 0)
+    rows = []
+    for module, sizes in usage.items():
+        if not any(sizes.values()):
+            continue
+        for c in CATEGORIES:
+            totals[c] += sizes[c]
+        rows.append((module, sizes))
+    rows.sort(key=lambda r: -(r[1]["data"] + r[1]["bss"] + r[1]["scratch"] + r[1]["text"]))
+
+    reserved_total = sum(reserved.values())
+    ram_used = totals["data"] + totals["bss"] + totals["scratch"] + reserved_total
+    flash_used = totals["text"] + totals["rodata"] + totals["data"]
+    ram_size = sum(regions.get(r, (0, 0))[1] for r in ("RAM", "SCRATCH_X", "SCRATCH_Y"))
+    flash_size = regions.get("FLASH", (0, 0))[1]
+
+    out = []
+    out.append("%-28s %8s %8s %8s %8s %8s" % (("modulo",) + CATEGORIES))
+    for module, sizes in rows:
+        out.append("%-28s %8d %8d %8d %8d %8d" % ((module,) + tuple(sizes[c] for c in CATEGORIES)))
+    out.append("%-28s %8d %8d %8d %8d %8d" % (("TOTAL",) + tuple(totals[c] for c in CATEGORIES)))
+    out.append("")
+    for name, size in sorted(reserved.items()):
+        out.append("reservado %-18s %8d" % (name, size))
+    if ram_size:
+        out.append("RAM   usada %7d de %7d bytes (%.1f%%)" % (ram_used, ram_size, 100.0 * ram_used / ram_size))
+    if flash_size:
+        out.append("FLASH usada %7d de %7d bytes (%.1f%%)" % (flash_used, flash_size, 100.0 * flash_used / flash_size))
+    report = "\n".join(out) + "\n"
+
+    if args.out:
+        with open(args.out, "w", encoding="utf-8") as f:
+            f.write(report)
+    sys.stdout.write(report)
+
+    failed = False
+    if args.ram_budget and ram_used > args.ram_budget:
+        sys.stderr.write("ERRO: RAM usada (%d) excede o limite (%d)\n" % (ram_used, args.ram_budget))
+        failed = True
+    if args.flash_budget and flash_used > args.flash_budget:
+        sys.stderr.write("ERRO: flash usada (%d) excede o limite (%d)\n" % (flash_used, args.flash_budget))
+        failed = True
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())